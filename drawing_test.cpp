@@ -50,11 +50,11 @@ cv::Mat drawGraphNode(GraphNode<T>& node, int window_resolution){
 
 template <typename T>
 cv::Mat drawNode(Node<T>& node, int window_resolution){
-    if (typeid(node) == typeid(GraphNode<T>)){
-        return drawGraphNode(dynamic_cast<GraphNode<T>&>(node), window_resolution);
-    }
-    if (typeid(node) == typeid(RealNode<T>)){
-        return drawRealNode(static_cast<RealNode<T>&>(node), window_resolution);
+    switch (node.getNodeType()) {
+        case NodeType::GRAPH_NODE:
+            return drawGraphNode(static_cast<GraphNode<T>&>(node), window_resolution);
+        case NodeType::REAL_NODE:
+            return drawRealNode(static_cast<RealNode<T>&>(node), window_resolution);
     }
     // Should never get here
     BOOST_ASSERT(false);
@@ -0,0 +1,177 @@
+#pragma once
+
+// C++ STD Includes
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphNode.h"
+#include "RealNode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Adapts the resolution of a graph to the values it contains (adaptive mesh
+     * refinement), rather than to fixed areas as GraphFactory does
+     *
+     * Each pass, a user given error indicator is evaluated for every RealNode
+     * (in parallel, with OpenMP). RealNodes with an error above the refine
+     * tolerance are split, largest error first, and GraphNodes whose sub-nodes
+     * are all RealNodes with an error below the coarsen tolerance are merged.
+     * The coarsen tolerance must be below the refine tolerance, so that a
+     * node is not merged and split again on alternate passes.
+     *
+     * @tparam T the type of value contained by the RealNodes of the graph
+     */
+    template<typename T>
+    class AdaptiveRefiner {
+    public:
+        // A function that takes a RealNode, and returns an estimate of the
+        // error in its value (larger values need a finer resolution).
+        // This is called concurrently, on a frozen graph (see `GraphNode::freeze`)
+        using ErrorIndicator = std::function<double(RealNode<T> &)>;
+
+        /**
+         * The number of nodes changed by a call to `refine`
+         */
+        struct RefinementResult {
+            // The number of RealNodes that were split
+            size_t num_splits = 0;
+
+            // The number of GraphNodes that were merged into a RealNode
+            size_t num_merges = 0;
+        };
+
+        /**
+         * This is thrown when the coarsen tolerance is not below the refine tolerance
+         */
+        class InvalidToleranceException : public std::runtime_error {
+        public:
+            explicit InvalidToleranceException(const char *m) : std::runtime_error(m) {}
+        };
+
+        // Delete the default constructor
+        AdaptiveRefiner() = delete;
+
+        /**
+         * Creates an AdaptiveRefiner
+         *
+         * Throws an InvalidToleranceException if `coarsen_tolerance` is not
+         * below `refine_tolerance`
+         * @param error_indicator a function that estimates the error in the value of a RealNode
+         * @param refine_tolerance RealNodes with an error above this are split
+         * @param coarsen_tolerance GraphNodes whose sub-nodes all have an error
+         * below this are merged
+         */
+        AdaptiveRefiner(const ErrorIndicator &error_indicator,
+                        double refine_tolerance, double coarsen_tolerance);
+
+        /**
+         * Sets the resolution that RealNodes are split into
+         * (ex. `GraphFactory::getSubNodeResolution` of the factory that
+         * created the graph). The default is 2.
+         * @param resolution the resolution that RealNodes are split into
+         */
+        void setSubNodeResolution(unsigned int resolution);
+
+        /**
+         * Sets the largest number of RealNodes the graph may have after a
+         * split. Once this is reached, the remaining nodes with the smallest
+         * errors are left unsplit. The default is no limit.
+         * @param max_num_nodes the largest number of RealNodes the graph may have
+         */
+        void setMaxNumNodes(size_t max_num_nodes);
+
+        /**
+         * Sets the smallest scale a RealNode may be split into. The default is
+         * no limit.
+         * @param min_scale the smallest scale a RealNode may be split into
+         */
+        void setMinScale(double min_scale);
+
+        /**
+         * Sets how the values of split RealNodes are carried over to the new
+         * RealNodes (see `ValuePolicies`). The default value initializes them.
+         * @param split the split policy
+         */
+        void setValueSplit(const typename GraphNode<T>::ValueSplit &split);
+
+        /**
+         * Sets how the values of merged RealNodes are reduced to a single value
+         * (see `ValuePolicies`). The default value initializes it.
+         * @param reduction the merge policy
+         */
+        void setValueReduction(const typename GraphNode<T>::ValueReduction &reduction);
+
+        /**
+         * Does a single pass of refinement over a graph, splitting and merging
+         * nodes (at most one level each) as the error indicator requires
+         *
+         * The graph is frozen before the error indicator is evaluated (see
+         * `GraphNode::freeze`)
+         * @param graph the graph to refine
+         * @return the number of nodes that were split and merged
+         */
+        RefinementResult refine(GraphNode<T> &graph);
+
+        /**
+         * Refines a graph until no more nodes are split or merged, or a given
+         * number of passes has been done
+         * @param graph the graph to refine
+         * @param max_num_passes the largest number of passes to do
+         * @return the total number of nodes that were split and merged
+         */
+        RefinementResult refineUntilStable(GraphNode<T> &graph, unsigned int max_num_passes);
+
+        /**
+         * Creates an error indicator from how much the value of a RealNode
+         * differs from those of its neighbours, as the largest gradient to any
+         * neighbour scaled by the size of the node (ie. the change in value
+         * expected across the node)
+         * @param projection a function that takes the value contained by a
+         * RealNode, and returns the number the gradient should be found from
+         * @return the error indicator
+         */
+        static ErrorIndicator valueGradient(const typename GraphNode<T>::ValueProjection &projection);
+
+    private:
+        /**
+         * Finds every GraphNode below a given node that can be merged, ie. that
+         * only has RealNodes as sub-nodes, and where all of them have an error
+         * below the coarsen tolerance
+         * @param graph_node the node to search below
+         * @param errors the error of every RealNode in the graph
+         * @param nodes_to_merge the list to add the GraphNodes that can be merged to
+         */
+        void findNodesToMerge(GraphNode<T> &graph_node,
+                              const std::unordered_map<Node<T> *, double> &errors,
+                              std::vector<std::shared_ptr<GraphNode<T>>> &nodes_to_merge);
+
+        // Estimates the error in the value of a RealNode
+        ErrorIndicator error_indicator;
+
+        // RealNodes with an error above this are split
+        double refine_tolerance;
+
+        // GraphNodes whose sub-nodes all have an error below this are merged
+        double coarsen_tolerance;
+
+        // The resolution that RealNodes are split into
+        unsigned int subnode_resolution;
+
+        // The largest number of RealNodes the graph may have
+        size_t max_num_nodes;
+
+        // The smallest scale a RealNode may be split into
+        double min_scale;
+
+        // How the values of split RealNodes are carried over
+        typename GraphNode<T>::ValueSplit split;
+
+        // How the values of merged RealNodes are reduced to a single value
+        typename GraphNode<T>::ValueReduction reduction;
+    };
+}
+
+#include "AdaptiveRefiner.tpp"
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "AdaptiveRefiner.h"
+
+namespace multi_resolution_graph {
+
+template <typename T>
+AdaptiveRefiner<T>::AdaptiveRefiner(const ErrorIndicator &error_indicator,
+                                    double refine_tolerance, double coarsen_tolerance) :
+    error_indicator(error_indicator),
+    refine_tolerance(refine_tolerance),
+    coarsen_tolerance(coarsen_tolerance),
+    subnode_resolution(2),
+    max_num_nodes(std::numeric_limits<size_t>::max()),
+    min_scale(0),
+    split(nullptr),
+    reduction([](const std::vector<std::shared_ptr<RealNode<T>>> &) { return T(); })
+{
+    if (coarsen_tolerance >= refine_tolerance) {
+        throw InvalidToleranceException("The coarsen tolerance must be below the refine tolerance");
+    }
+}
+
+template <typename T>
+void AdaptiveRefiner<T>::setSubNodeResolution(unsigned int resolution) {
+    subnode_resolution = resolution;
+}
+
+template <typename T>
+void AdaptiveRefiner<T>::setMaxNumNodes(size_t max_num_nodes) {
+    this->max_num_nodes = max_num_nodes;
+}
+
+template <typename T>
+void AdaptiveRefiner<T>::setMinScale(double min_scale) {
+    this->min_scale = min_scale;
+}
+
+template <typename T>
+void AdaptiveRefiner<T>::setValueSplit(const typename GraphNode<T>::ValueSplit &split) {
+    this->split = split;
+}
+
+template <typename T>
+void AdaptiveRefiner<T>::setValueReduction(const typename GraphNode<T>::ValueReduction &reduction) {
+    this->reduction = reduction;
+}
+
+template <typename T>
+typename AdaptiveRefiner<T>::RefinementResult AdaptiveRefiner<T>::refine(GraphNode<T> &graph) {
+    // Freezing lets the error indicator query the graph from many threads at once
+    graph.freeze();
+    std::vector<std::shared_ptr<RealNode<T>>> nodes = graph.getAllSubNodes();
+    std::vector<double> node_errors(nodes.size());
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t i = 0; i < nodes.size(); i++) {
+        node_errors[i] = error_indicator(*nodes[i]);
+    }
+
+    // Merge first, to make room for as many splits as possible
+    std::unordered_map<Node<T> *, double> errors;
+    errors.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        errors[nodes[i].get()] = node_errors[i];
+    }
+    std::vector<std::shared_ptr<GraphNode<T>>> nodes_to_merge;
+    findNodesToMerge(graph, errors, nodes_to_merge);
+
+    RefinementResult result;
+    size_t num_nodes = nodes.size();
+    for (auto& node : nodes_to_merge) {
+        num_nodes -= node->getResolution() * node->getResolution() - 1;
+        node->convertToRealNode(reduction);
+        result.num_merges++;
+    }
+
+    // Split the nodes with the largest errors first, in case we run out of room
+    std::vector<size_t> nodes_to_split;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (node_errors[i] > refine_tolerance && nodes[i]->getScale() / subnode_resolution >= min_scale) {
+            nodes_to_split.push_back(i);
+        }
+    }
+    std::stable_sort(nodes_to_split.begin(), nodes_to_split.end(), [&](size_t a, size_t b) {
+        return node_errors[a] > node_errors[b];
+    });
+    size_t num_new_nodes = subnode_resolution * subnode_resolution - 1;
+    for (size_t i : nodes_to_split) {
+        if (num_nodes > max_num_nodes || max_num_nodes - num_nodes < num_new_nodes) {
+            break;
+        }
+        nodes[i]->convertToGraphNode(subnode_resolution, split);
+        num_nodes += num_new_nodes;
+        result.num_splits++;
+    }
+
+    return result;
+}
+
+template <typename T>
+typename AdaptiveRefiner<T>::RefinementResult
+AdaptiveRefiner<T>::refineUntilStable(GraphNode<T> &graph, unsigned int max_num_passes) {
+    RefinementResult total;
+    for (unsigned int pass = 0; pass < max_num_passes; pass++) {
+        RefinementResult result = refine(graph);
+        total.num_splits += result.num_splits;
+        total.num_merges += result.num_merges;
+        if (result.num_splits == 0 && result.num_merges == 0) {
+            break;
+        }
+    }
+    return total;
+}
+
+template <typename T>
+typename AdaptiveRefiner<T>::ErrorIndicator
+AdaptiveRefiner<T>::valueGradient(const typename GraphNode<T>::ValueProjection &projection) {
+    return [projection](RealNode<T> &node) {
+        double value = projection(node.containedValue());
+        Coordinates center = node.getCenterCoordinates();
+        double largest_gradient = 0;
+        for (auto& neighbour : node.getNeighbours()) {
+            Coordinates neighbour_center = neighbour->getCenterCoordinates();
+            double distance = std::hypot(neighbour_center.x - center.x, neighbour_center.y - center.y);
+            double gradient = std::abs(projection(neighbour->containedValue()) - value) / distance;
+            largest_gradient = std::max(largest_gradient, gradient);
+        }
+        return largest_gradient * node.getScale();
+    };
+}
+
+template <typename T>
+void AdaptiveRefiner<T>::findNodesToMerge(GraphNode<T> &graph_node,
+                                          const std::unordered_map<Node<T> *, double> &errors,
+                                          std::vector<std::shared_ptr<GraphNode<T>>> &nodes_to_merge) {
+    for (auto& row : graph_node.getSubNodes()) {
+        for (auto& sub_node : row) {
+            auto sub_graph_node = asGraphNode(sub_node);
+            if (!sub_graph_node) {
+                continue;
+            }
+
+            bool can_merge = true;
+            for (auto& sub_node_row : sub_graph_node->getSubNodes()) {
+                for (auto& node : sub_node_row) {
+                    if (node->getNodeType() != NodeType::REAL_NODE ||
+                        errors.at(node.get()) >= coarsen_tolerance) {
+                        can_merge = false;
+                    }
+                }
+            }
+            if (can_merge) {
+                nodes_to_merge.push_back(sub_graph_node);
+            } else {
+                findNodesToMerge(*sub_graph_node, errors, nodes_to_merge);
+            }
+        }
+    }
+}
+
+}
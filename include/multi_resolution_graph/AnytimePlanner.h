@@ -0,0 +1,197 @@
+#pragma once
+
+// C++ STD Includes
+#include <vector>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "GraphNode.h"
+#include "RealNode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * A deadline-aware path planner over the RealNodes of a graph
+     *
+     * This is an implementation of Anytime Repairing A* (ARA*): it starts by
+     * quickly finding a path with a weighted (inflated) heuristic, then
+     * repeatedly decreases the weight, reusing the previous search effort, to
+     * improve the path until it is optimal or until time runs out.
+     *
+     * The search state is kept between calls to `plan`, so as long as the start,
+     * goal, and graph have not changed, each call continues improving the path
+     * from where the last one left off.
+     */
+    template<typename T>
+    class AnytimePlanner {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * The result of a planning call
+         */
+        struct PlanningResult {
+            // The best path found so far, from the start node to the goal node
+            // (empty if no path has been found yet)
+            std::vector<std::shared_ptr<RealNode<T>>> path;
+
+            // The factor by which the cost of `path` may be greater than
+            // that of the optimal path (infinite if no path has been found yet)
+            double suboptimality_bound;
+        };
+
+        // Delete the default constructor
+        AnytimePlanner() = delete;
+
+        /**
+         * Creates an AnytimePlanner
+         * @param is_blocked a function that takes the value contained by a node,
+         * and returns if paths may not pass through that node
+         * @param initial_epsilon the weight to apply to the heuristic for the
+         * first search (must be >= 1)
+         * @param epsilon_decrement the amount to decrease the heuristic weight by
+         * after each completed search
+         *
+         * Throws a std::invalid_argument if `epsilon_decrement` is not positive,
+         * since the heuristic weight would then never reach 1
+         */
+        explicit AnytimePlanner(std::function<bool(T &)> is_blocked,
+                                double initial_epsilon = 3,
+                                double epsilon_decrement = 0.5);
+
+        /**
+         * Plans a path between two nodes, stopping at a given deadline
+         *
+         * If the start and goal are the same as in the last call, and
+         * `notifyGraphChanged` has not been called since, this resumes
+         * improving the path found by the last call. Every call makes at least
+         * some progress, even if the deadline has already passed.
+         *
+         * @param start the node to start the path at
+         * @param goal the node to end the path at
+         * @param deadline the time by which this should return
+         * @return the best path found so far and its suboptimality bound
+         */
+        PlanningResult plan(const std::shared_ptr<RealNode<T>> &start,
+                            const std::shared_ptr<RealNode<T>> &goal,
+                            Clock::time_point deadline);
+
+        /**
+         * Discards all saved search state, so that the next call to `plan`
+         * starts from scratch. This must be called whenever the graph changes.
+         */
+        void notifyGraphChanged();
+
+    private:
+        /**
+         * The state of the search at a single node
+         */
+        struct SearchState {
+            // The node this is the state for
+            std::shared_ptr<RealNode<T>> node;
+            // The cost of the best path found to this node so far
+            double g;
+            // The heuristic estimate of the cost from this node to the goal
+            double h;
+            // The node before this one along the best path found to it so far
+            RealNode<T> *parent;
+            // The (lazily found) neighbours of this node
+            std::optional<std::vector<RealNode<T> *>> neighbours;
+        };
+
+        /**
+         * An entry in the open list
+         */
+        struct OpenEntry {
+            double key;
+            double g;
+            RealNode<T> *node;
+
+            bool operator>(const OpenEntry &other) const {
+                return key > other.key;
+            }
+        };
+
+        /**
+         * Starts a new search between the given nodes
+         * @param start the node to start the path at
+         * @param goal the node to end the path at
+         */
+        void startSearch(const std::shared_ptr<RealNode<T>> &start,
+                         const std::shared_ptr<RealNode<T>> &goal);
+
+        /**
+         * Expands nodes with the current epsilon until the path to the goal
+         * cannot be improved upon, or until the deadline
+         * @param deadline the time at which to stop expanding nodes
+         * @return if the search was completed before the deadline
+         */
+        bool improvePath(Clock::time_point deadline);
+
+        /**
+         * Gets the search state for the given node, creating it if needed
+         * @param node the node to get the search state for
+         * @return the search state for the given node
+         */
+        SearchState &getState(RealNode<T> *node);
+
+        /**
+         * Gets the neighbours of the given node that paths may pass through
+         * @param state the search state of the node to get the neighbours of
+         * @return the unblocked neighbours of the node
+         */
+        const std::vector<RealNode<T> *> &getNeighbours(SearchState &state);
+
+        /**
+         * Removes all stale entries from the top of the open list
+         */
+        void dropStaleOpenEntries();
+
+        /**
+         * Gets the path to the goal from the parent pointers in the search
+         * @return the current path from the start to the goal
+         */
+        std::vector<std::shared_ptr<RealNode<T>>> extractPath();
+
+        // A function that returns if a node with a given value is blocked
+        std::function<bool(T &)> is_blocked;
+
+        // The heuristic weight for the first search
+        double initial_epsilon;
+
+        // The amount the heuristic weight is decreased after each search
+        double epsilon_decrement;
+
+        // The heuristic weight for the current search
+        double epsilon;
+
+        // The start and goal of the current search
+        RealNode<T> *start_node = nullptr;
+        RealNode<T> *goal_node = nullptr;
+
+        // The coordinates of the center of the goal node
+        Coordinates goal_coordinates;
+
+        // The state of every node the search has reached
+        std::unordered_map<RealNode<T> *, SearchState> states;
+
+        // The nodes that may still need to be expanded in the current search
+        std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open;
+
+        // The nodes that have been expanded in the current search
+        std::unordered_set<RealNode<T> *> closed;
+
+        // The nodes whose cost was lowered after they were expanded in the
+        // current search, which need to be re-expanded in the next one
+        std::unordered_set<RealNode<T> *> inconsistent;
+
+        // The best result found so far
+        PlanningResult best_result;
+    };
+}
+
+#include "AnytimePlanner.tpp"
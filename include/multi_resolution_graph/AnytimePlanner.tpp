@@ -0,0 +1,211 @@
+#pragma once
+
+// C++ STD Includes
+#include <algorithm>
+#include <limits>
+
+#include "AnytimePlanner.h"
+
+namespace multi_resolution_graph {
+
+template<typename T>
+AnytimePlanner<T>::AnytimePlanner(std::function<bool(T &)> is_blocked,
+                                  double initial_epsilon,
+                                  double epsilon_decrement) :
+        is_blocked(std::move(is_blocked)),
+        initial_epsilon(std::max(1.0, initial_epsilon)),
+        epsilon_decrement(epsilon_decrement),
+        epsilon(this->initial_epsilon) {
+    if (epsilon_decrement <= 0) {
+        throw std::invalid_argument("The epsilon decrement must be positive");
+    }
+}
+
+template<typename T>
+typename AnytimePlanner<T>::PlanningResult
+AnytimePlanner<T>::plan(const std::shared_ptr<RealNode<T>> &start,
+                        const std::shared_ptr<RealNode<T>> &goal,
+                        Clock::time_point deadline) {
+    // Only resume the last search if it was for the same path
+    if (start.get() != start_node || goal.get() != goal_node) {
+        startSearch(start, goal);
+    }
+
+    // Keep improving the path until it's optimal or we run out of time
+    while (best_result.suboptimality_bound > 1) {
+        if (!improvePath(deadline)) {
+            break;
+        }
+
+        SearchState &goal_state = getState(goal_node);
+        if (goal_state.g == std::numeric_limits<double>::infinity()) {
+            // There is no path to the goal, so there's nothing left to improve
+            break;
+        }
+
+        // The optimal path can't cost less than the lowest un-weighted
+        // estimate through any node we haven't finished with
+        double min_estimate = goal_state.g;
+        dropStaleOpenEntries();
+        std::vector<OpenEntry> open_entries;
+        while (!open.empty()) {
+            OpenEntry entry = open.top();
+            open.pop();
+            if (entry.g == getState(entry.node).g && !closed.count(entry.node)) {
+                open_entries.emplace_back(entry);
+            }
+        }
+        for (const OpenEntry &entry : open_entries) {
+            min_estimate = std::min(min_estimate, entry.g + getState(entry.node).h);
+        }
+        for (RealNode<T> *node : inconsistent) {
+            SearchState &state = getState(node);
+            min_estimate = std::min(min_estimate, state.g + state.h);
+        }
+
+        best_result.path = extractPath();
+        double cost_ratio = min_estimate > 0 ? goal_state.g / min_estimate : 1;
+        best_result.suboptimality_bound = std::max(1.0, std::min(epsilon, cost_ratio));
+
+        // Set up the next, less inflated, search with all the nodes that still
+        // need expanding
+        epsilon = std::max(1.0, epsilon - epsilon_decrement);
+        for (const OpenEntry &entry : open_entries) {
+            inconsistent.insert(entry.node);
+        }
+        for (RealNode<T> *node : inconsistent) {
+            SearchState &state = getState(node);
+            open.push({state.g + epsilon * state.h, state.g, node});
+        }
+        inconsistent.clear();
+        closed.clear();
+
+        // A search with nothing left to expand returns without looking at the
+        // deadline, so check it here too
+        if (Clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    return best_result;
+}
+
+template<typename T>
+void AnytimePlanner<T>::notifyGraphChanged() {
+    start_node = nullptr;
+    goal_node = nullptr;
+    states.clear();
+    open = {};
+    closed.clear();
+    inconsistent.clear();
+}
+
+template<typename T>
+void AnytimePlanner<T>::startSearch(const std::shared_ptr<RealNode<T>> &start,
+                                    const std::shared_ptr<RealNode<T>> &goal) {
+    notifyGraphChanged();
+    start_node = start.get();
+    goal_node = goal.get();
+    goal_coordinates = goal->getCenterCoordinates();
+    epsilon = initial_epsilon;
+    best_result = {{}, std::numeric_limits<double>::infinity()};
+
+    SearchState &start_state = getState(start_node);
+    start_state.g = 0;
+    open.push({epsilon * start_state.h, 0, start_node});
+}
+
+template<typename T>
+bool AnytimePlanner<T>::improvePath(Clock::time_point deadline) {
+    SearchState &goal_state = getState(goal_node);
+    bool made_progress = false;
+    while (true) {
+        dropStaleOpenEntries();
+        if (open.empty() || goal_state.g <= open.top().key) {
+            return true;
+        }
+
+        // Always expand at least one node, so that repeated calls with a
+        // passed deadline still eventually finish
+        if (made_progress && Clock::now() >= deadline) {
+            return false;
+        }
+        made_progress = true;
+
+        RealNode<T> *node = open.top().node;
+        open.pop();
+        closed.insert(node);
+
+        SearchState &state = getState(node);
+        Coordinates coordinates = state.node->getCenterCoordinates();
+        for (RealNode<T> *neighbour : getNeighbours(state)) {
+            SearchState &neighbour_state = getState(neighbour);
+            double g = state.g + distance(coordinates,
+                                          neighbour_state.node->getCenterCoordinates());
+            if (g < neighbour_state.g) {
+                neighbour_state.g = g;
+                neighbour_state.parent = node;
+                if (closed.count(neighbour)) {
+                    inconsistent.insert(neighbour);
+                } else {
+                    open.push({g + epsilon * neighbour_state.h, g, neighbour});
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+typename AnytimePlanner<T>::SearchState &AnytimePlanner<T>::getState(RealNode<T> *node) {
+    auto it = states.find(node);
+    if (it != states.end()) {
+        return it->second;
+    }
+
+    SearchState state;
+    state.node = node->shared_from_this();
+    state.g = std::numeric_limits<double>::infinity();
+    state.h = distance(state.node->getCenterCoordinates(), goal_coordinates);
+    state.parent = nullptr;
+    return states.emplace(node, std::move(state)).first->second;
+}
+
+template<typename T>
+const std::vector<RealNode<T> *> &AnytimePlanner<T>::getNeighbours(SearchState &state) {
+    // Since the graph doesn't change during a search, we only need to
+    // find the neighbours of each node once
+    if (!state.neighbours) {
+        state.neighbours = std::vector<RealNode<T> *>();
+        for (auto &neighbour : state.node->getNeighbours()) {
+            if (!is_blocked(neighbour->containedValue())) {
+                state.neighbours->emplace_back(neighbour.get());
+            }
+        }
+    }
+    return *state.neighbours;
+}
+
+template<typename T>
+void AnytimePlanner<T>::dropStaleOpenEntries() {
+    // We don't remove entries from the open list when a node's cost changes,
+    // so skip over any entries that are out of date or already expanded
+    while (!open.empty()) {
+        const OpenEntry &entry = open.top();
+        if (entry.g == getState(entry.node).g && !closed.count(entry.node)) {
+            return;
+        }
+        open.pop();
+    }
+}
+
+template<typename T>
+std::vector<std::shared_ptr<RealNode<T>>> AnytimePlanner<T>::extractPath() {
+    std::vector<std::shared_ptr<RealNode<T>>> path;
+    for (RealNode<T> *node = goal_node; node != nullptr; node = getState(node).parent) {
+        path.emplace_back(getState(node).node);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+}
@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "GraphNode.h"
 #include "Node.h"
 
 namespace multi_resolution_graph {
@@ -19,6 +20,24 @@ namespace multi_resolution_graph {
          */
         virtual bool overlapsNode(Node<T>& node) = 0;
 
+        /**
+         * Checks if this area overlaps the given square (used where there is no
+         * Node for the square, ex. in PersistentGraph snapshots)
+         *
+         * By default this checks a GraphNode covering the square with
+         * `overlapsNode`, so subclasses only need to override this if they can
+         * check a square without creating a node for it
+         * @param bottom_left the coordinates of the bottom left corner of the square
+         * @param scale the length/width of the square
+         * @return
+         *      `true` if this area *DOES* overlap the given square
+         *      `false` if this are *DOES NOT* overlap the given square
+         */
+        virtual bool overlapsSquare(Coordinates bottom_left, double scale) {
+            GraphNode<T> square(1, scale, bottom_left);
+            return overlapsNode(square);
+        }
+
         /**
          * Clone this Area Object
          * @return a shared pointer to a clone of this Area object
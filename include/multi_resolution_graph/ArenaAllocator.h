@@ -0,0 +1,78 @@
+#pragma once
+
+// C++ STD Includes
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace multi_resolution_graph {
+    /**
+     * An allocator that hands out memory from one large block, rather than
+     * allocating separately for every object
+     *
+     * This is meant for creating a large number of objects at once with
+     * `std::allocate_shared`. Memory is never given back one object at a time:
+     * the block is freed all at once when every copy of the allocator that
+     * shares it has been destroyed (including the copies held by the shared_ptrs
+     * created with it), ie. when the last object allocated from it is destroyed.
+     *
+     * Allocating is not thread safe, but destroying objects allocated with
+     * this is (as doing so never touches the block).
+     */
+    template<typename U>
+    class ArenaAllocator {
+    public:
+        using value_type = U;
+
+        /**
+         * Creates an ArenaAllocator with a new block of memory
+         * @param initial_size the size (in bytes) of the block of memory. If more
+         * than this is allocated, additional blocks will be allocated as needed
+         */
+        explicit ArenaAllocator(std::size_t initial_size) :
+                arena(std::make_shared<std::pmr::monotonic_buffer_resource>(
+                        std::max<std::size_t>(initial_size, 1))) {}
+
+        /**
+         * Creates an ArenaAllocator sharing the block of another ArenaAllocator
+         * @param other the allocator to share the block of
+         */
+        template<typename V>
+        ArenaAllocator(const ArenaAllocator<V> &other) : arena(other.arena) {}
+
+        U *allocate(std::size_t n) {
+            return static_cast<U *>(arena->allocate(n * sizeof(U), alignof(U)));
+        }
+
+        void deallocate(U *, std::size_t) {
+            // Memory is only freed when the whole block is
+        }
+
+        template<typename V, typename... Args>
+        void construct(V *p, Args &&... args) {
+            // We construct objects here (rather than relying on the default
+            // `allocator_traits::construct`) so that classes may restrict
+            // construction with this allocator to be from their own members,
+            // by making this allocator a friend
+            ::new(static_cast<void *>(p)) V(std::forward<Args>(args)...);
+        }
+
+        template<typename V>
+        bool operator==(const ArenaAllocator<V> &other) const {
+            return arena == other.arena;
+        }
+
+        template<typename V>
+        bool operator!=(const ArenaAllocator<V> &other) const {
+            return arena != other.arena;
+        }
+
+    private:
+        template<typename V>
+        friend class ArenaAllocator;
+
+        // The block of memory objects are allocated from
+        std::shared_ptr<std::pmr::monotonic_buffer_resource> arena;
+    };
+}
@@ -21,6 +21,8 @@ namespace multi_resolution_graph {
         // TODO: Def. need to test this!
         bool overlapsNode(Node<T> &node) override;
 
+        bool overlapsSquare(Coordinates bottom_left, double scale) override;
+
         std::shared_ptr<Area<T>> clone() const {
             return std::make_shared<Circle<T>>(*this);
             //Area<T>* area = new Circle<T>(*this);
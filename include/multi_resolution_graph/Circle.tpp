@@ -12,19 +12,24 @@ Circle<T>::Circle(Radius radius, Coordinates center):
 
 template <typename T>
 bool Circle<T>::overlapsNode(Node<T>& node) {
+    return overlapsSquare(node.getCoordinates(), node.getScale());
+}
+
+template <typename T>
+bool Circle<T>::overlapsSquare(Coordinates bottom_left, double scale) {
     // Get the 4 corner points of this node
-    Coordinates p1 = node.getCoordinates();
+    Coordinates p1 = bottom_left;
     Coordinates p2 = {
-            p1.x + node.getScale(),
+            p1.x + scale,
             p1.y
     };
     Coordinates p3 = {
-            p1.x + node.getScale(),
-            p1.y + node.getScale()
+            p1.x + scale,
+            p1.y + scale
     };
     Coordinates p4 = {
             p1.x,
-            p1.y + node.getScale()
+            p1.y + scale
     };
     std::vector<Coordinates> points = {p1, p2, p3, p4};
 
@@ -34,10 +39,10 @@ bool Circle<T>::overlapsNode(Node<T>& node) {
     // - the edge of the circle intersects the edge of this node
 
     // Check if center of circle is within the node
-    double min_x = node.getCoordinates().x;
-    double min_y = node.getCoordinates().y;
-    double max_x = node.getCoordinates().x + node.getScale();
-    double max_y = node.getCoordinates().y + node.getScale();
+    double min_x = bottom_left.x;
+    double min_y = bottom_left.y;
+    double max_x = bottom_left.x + scale;
+    double max_y = bottom_left.y + scale;
     if (center.x > min_x && center.x < max_x &&
         center.y > min_y && center.y < max_y) {
         return true;
@@ -0,0 +1,181 @@
+#pragma once
+
+// C++ STD Includes
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "FiniteVolumeStencil.h"
+#include "GraphNode.h"
+#include "ValueLayers.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Keeps a layer of a ValueLayers holding, for every RealNode, the distance
+     * from its center to the closest blocked RealNode (ex. for inflating
+     * obstacles by the radius of a robot with a single comparison per node)
+     *
+     * Distances are found with a brushfire: a wavefront spreads out from the
+     * blocked RealNodes across the faces of a FiniteVolumeStencil in order of
+     * distance, and every RealNode remembers the blocked RealNode closest to it,
+     * so the distance stored is the exact distance to that node (not the length
+     * of a path through the graph). The wavefront crosses large RealNodes in a
+     * single step, so its cost depends on the number of RealNodes, not on the
+     * finest resolution in the graph.
+     *
+     * When RealNodes become blocked or free, only the RealNodes whose closest
+     * blocked RealNode changes are visited again: a "raise" wavefront clears
+     * the RealNodes that were closest to a node that is now free, and a "lower"
+     * wavefront spreads out from new blocked nodes (and from the edges of the
+     * cleared area). The distance is an approximation where the closest blocked
+     * RealNode can only be seen diagonally past another blocked RealNode, as
+     * with any brushfire over a grid.
+     *
+     * @tparam T the type of value contained by the RealNodes of the graph
+     * @tparam V the type of value stored in each layer
+     */
+    template<typename T, typename V = double>
+    class DistanceTransform {
+    public:
+        /**
+         * A function that takes the value contained by a RealNode, and returns
+         * if the RealNode is blocked
+         */
+        using BlockedFunction = std::function<bool(const T &)>;
+
+        // The distance of RealNodes that are further than the max distance
+        // from any blocked RealNode (or when there are no blocked RealNodes)
+        static constexpr double NO_DISTANCE = std::numeric_limits<double>::infinity();
+
+        // Delete the default constructor
+        DistanceTransform() = delete;
+
+        /**
+         * Creates a DistanceTransform, adding a layer for the distances to the
+         * ValueLayers of the stencil, and finds the distance of every RealNode
+         * @param stencil the faces of the RealNodes to spread across (must outlive this object)
+         * @param is_blocked a function that takes the value contained by a
+         * RealNode, and returns if the RealNode is blocked
+         * @param layer_name the name of the layer to store the distances in
+         * @param max_distance the distance at which to stop spreading, past
+         * which every RealNode is given NO_DISTANCE
+         */
+        DistanceTransform(FiniteVolumeStencil<T, V> &stencil, const BlockedFunction &is_blocked,
+                          const std::string &layer_name = "distance",
+                          double max_distance = NO_DISTANCE);
+
+        /**
+         * Gets the index of the layer the distances are stored in
+         * @return the index of the layer the distances are stored in
+         */
+        size_t getLayer() const;
+
+        /**
+         * Gets the distance from a RealNode to the closest blocked RealNode
+         * @param node a RealNode in the graph
+         * @return the distance from the center of the node to the closest
+         * point on the closest blocked RealNode, or NO_DISTANCE if there is no
+         * blocked RealNode within the max distance
+         */
+        double getDistance(const RealNode<T> &node) const;
+
+        /**
+         * Gets the blocked RealNode closest to a RealNode
+         * @param node a RealNode in the graph
+         * @return the blocked RealNode closest to the node, or nullptr if there
+         * is no blocked RealNode within the max distance
+         */
+        std::shared_ptr<RealNode<T>> getClosestBlockedNode(const RealNode<T> &node) const;
+
+        /**
+         * Checks every RealNode for whether it is blocked, and updates the
+         * distances around every RealNode that changed
+         * @return the number of RealNodes visited by the wavefronts
+         */
+        size_t update();
+
+        /**
+         * Checks the given RealNodes for whether they are blocked, and updates
+         * the distances around any that changed
+         * @param nodes the RealNodes whose values may have changed
+         * @return the number of RealNodes visited by the wavefronts
+         */
+        size_t update(const std::vector<std::shared_ptr<RealNode<T>>> &nodes);
+
+        /**
+         * Finds the distance of every RealNode from scratch after the layout of
+         * the graph changed. The stencil must be updated first (see
+         * `FiniteVolumeStencil::update`).
+         */
+        void rebuild();
+
+    private:
+        // The id of no RealNode
+        static constexpr size_t NO_LEAF = std::numeric_limits<size_t>::max();
+
+        /**
+         * Marks a RealNode as blocked or free, and queues the wavefront this
+         * starts
+         * @param leaf the leaf id of the RealNode
+         * @param blocked if the RealNode is now blocked
+         */
+        void setBlocked(size_t leaf, bool blocked);
+
+        /**
+         * Gets the distance from the center of one RealNode to the closest point
+         * on another
+         * @param leaf the leaf id of the RealNode to measure from
+         * @param blocked_leaf the leaf id of the RealNode to measure to
+         * @return the distance between the two RealNodes
+         */
+        double distanceBetween(size_t leaf, size_t blocked_leaf) const;
+
+        /**
+         * Runs the queued wavefronts until they have all stopped, and writes the
+         * new distances into the layer
+         * @return the number of RealNodes visited
+         */
+        size_t propagate();
+
+        // The faces of the RealNodes
+        FiniteVolumeStencil<T, V> &stencil;
+
+        // Checks if a RealNode is blocked
+        BlockedFunction is_blocked;
+
+        // The index of the layer the distances are stored in
+        size_t layer;
+
+        // The distance at which to stop spreading
+        double max_distance;
+
+        // The center and scale of every RealNode, by leaf id
+        std::vector<Coordinates> centers;
+        std::vector<double> scales;
+
+        // If every RealNode is blocked, by leaf id
+        std::vector<bool> blocked;
+
+        // The closest blocked RealNode to every RealNode, by leaf id
+        std::vector<size_t> closest_blocked;
+
+        // The distance to the closest blocked RealNode, by leaf id
+        std::vector<double> distances;
+
+        // If every RealNode is waiting to clear its neighbours, by leaf id
+        std::vector<bool> raising;
+
+        // The RealNodes waiting to be visited, closest first, with the
+        // distance they were queued at
+        std::priority_queue<std::pair<double, size_t>, std::vector<std::pair<double, size_t>>,
+                            std::greater<std::pair<double, size_t>>> queue;
+
+        // The RealNodes whose distance changed since the layer was last written
+        std::vector<size_t> changed_leaves;
+    };
+}
+
+#include "DistanceTransform.tpp"
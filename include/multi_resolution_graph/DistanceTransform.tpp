@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "DistanceTransform.h"
+
+namespace multi_resolution_graph {
+
+template <typename T, typename V>
+DistanceTransform<T, V>::DistanceTransform(FiniteVolumeStencil<T, V> &stencil, const BlockedFunction &is_blocked,
+                                           const std::string &layer_name, double max_distance) :
+    stencil(stencil),
+    is_blocked(is_blocked),
+    layer(stencil.getValueLayers().addLayer(layer_name, static_cast<V>(NO_DISTANCE))),
+    max_distance(max_distance)
+{
+    rebuild();
+}
+
+template <typename T, typename V>
+size_t DistanceTransform<T, V>::getLayer() const {
+    return layer;
+}
+
+template <typename T, typename V>
+double DistanceTransform<T, V>::getDistance(const RealNode<T> &node) const {
+    return distances[node.getLeafId()];
+}
+
+template <typename T, typename V>
+std::shared_ptr<RealNode<T>> DistanceTransform<T, V>::getClosestBlockedNode(const RealNode<T> &node) const {
+    size_t closest_leaf = closest_blocked[node.getLeafId()];
+    if (closest_leaf == NO_LEAF) {
+        return nullptr;
+    }
+    return stencil.getValueLayers().getLeaves()[closest_leaf];
+}
+
+template <typename T, typename V>
+size_t DistanceTransform<T, V>::update() {
+    const std::vector<std::shared_ptr<RealNode<T>>> &leaves = stencil.getValueLayers().getLeaves();
+    const size_t num_leaves = leaves.size();
+    std::vector<char> now_blocked(num_leaves);
+    #pragma omp parallel for schedule(static)
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        now_blocked[leaf] = is_blocked(leaves[leaf]->containedValue());
+    }
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        setBlocked(leaf, now_blocked[leaf]);
+    }
+    return propagate();
+}
+
+template <typename T, typename V>
+size_t DistanceTransform<T, V>::update(const std::vector<std::shared_ptr<RealNode<T>>> &nodes) {
+    for (auto& node : nodes) {
+        setBlocked(node->getLeafId(), is_blocked(node->containedValue()));
+    }
+    return propagate();
+}
+
+template <typename T, typename V>
+void DistanceTransform<T, V>::rebuild() {
+    const std::vector<std::shared_ptr<RealNode<T>>> &leaves = stencil.getValueLayers().getLeaves();
+    const size_t num_leaves = leaves.size();
+    centers.resize(num_leaves);
+    scales.resize(num_leaves);
+    #pragma omp parallel for schedule(static)
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        centers[leaf] = leaves[leaf]->getCenterCoordinates();
+        scales[leaf] = leaves[leaf]->getScale();
+    }
+
+    blocked.assign(num_leaves, false);
+    closest_blocked.assign(num_leaves, NO_LEAF);
+    distances.assign(num_leaves, NO_DISTANCE);
+    raising.assign(num_leaves, false);
+    queue = decltype(queue)();
+    changed_leaves.clear();
+    stencil.getValueLayers().fill(layer, static_cast<V>(NO_DISTANCE));
+    update();
+}
+
+template <typename T, typename V>
+void DistanceTransform<T, V>::setBlocked(size_t leaf, bool blocked) {
+    if (this->blocked[leaf] == blocked) {
+        return;
+    }
+    this->blocked[leaf] = blocked;
+    if (blocked) {
+        closest_blocked[leaf] = leaf;
+        distances[leaf] = 0;
+        raising[leaf] = false;
+    } else {
+        // Clear this node, and every node that was closest to it
+        closest_blocked[leaf] = NO_LEAF;
+        distances[leaf] = NO_DISTANCE;
+        raising[leaf] = true;
+    }
+    queue.push({0, leaf});
+    changed_leaves.push_back(leaf);
+}
+
+template <typename T, typename V>
+double DistanceTransform<T, V>::distanceBetween(size_t leaf, size_t blocked_leaf) const {
+    double half_scale = scales[blocked_leaf] / 2;
+    double dx = std::max(0.0, std::abs(centers[leaf].x - centers[blocked_leaf].x) - half_scale);
+    double dy = std::max(0.0, std::abs(centers[leaf].y - centers[blocked_leaf].y) - half_scale);
+    return std::hypot(dx, dy);
+}
+
+template <typename T, typename V>
+size_t DistanceTransform<T, V>::propagate() {
+    const std::vector<size_t> &face_offsets = stencil.getFaceOffsets();
+    const std::vector<size_t> &face_neighbours = stencil.getFaceNeighbours();
+    size_t num_visited = 0;
+    while (!queue.empty()) {
+        double queued_distance = queue.top().first;
+        size_t leaf = queue.top().second;
+        queue.pop();
+
+        if (raising[leaf]) {
+            // Clear the neighbours that were closest to a node that is now
+            // free, and have the others spread into the cleared area again
+            for (size_t face = face_offsets[leaf]; face < face_offsets[leaf + 1]; face++) {
+                size_t neighbour = face_neighbours[face];
+                if (closest_blocked[neighbour] == NO_LEAF || raising[neighbour]) {
+                    continue;
+                }
+                queue.push({distances[neighbour], neighbour});
+                if (!blocked[closest_blocked[neighbour]]) {
+                    closest_blocked[neighbour] = NO_LEAF;
+                    distances[neighbour] = NO_DISTANCE;
+                    raising[neighbour] = true;
+                    changed_leaves.push_back(neighbour);
+                }
+            }
+            raising[leaf] = false;
+            num_visited++;
+        } else if (closest_blocked[leaf] != NO_LEAF && queued_distance == distances[leaf]) {
+            // Offer the closest blocked node of this node to its neighbours
+            size_t closest_leaf = closest_blocked[leaf];
+            for (size_t face = face_offsets[leaf]; face < face_offsets[leaf + 1]; face++) {
+                size_t neighbour = face_neighbours[face];
+                if (raising[neighbour]) {
+                    continue;
+                }
+                double distance = distanceBetween(neighbour, closest_leaf);
+                if (distance < distances[neighbour] && distance <= max_distance) {
+                    distances[neighbour] = distance;
+                    closest_blocked[neighbour] = closest_leaf;
+                    queue.push({distance, neighbour});
+                    changed_leaves.push_back(neighbour);
+                }
+            }
+            num_visited++;
+        }
+    }
+
+    std::vector<V> &layer_values = stencil.getValueLayers().getLayer(layer);
+    for (size_t leaf : changed_leaves) {
+        layer_values[leaf] = static_cast<V>(distances[leaf]);
+    }
+    changed_leaves.clear();
+    return num_visited;
+}
+
+}
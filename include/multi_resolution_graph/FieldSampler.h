@@ -0,0 +1,143 @@
+#pragma once
+
+// C++ STD Includes
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "GraphNode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Samples the values contained by the RealNodes of a graph as a
+     * continuous field, at any coordinates in the graph
+     *
+     * The RealNode containing the coordinates is found with
+     * `GraphNode::getNodeContainingCoordinates` (which only needs a handful of
+     * hash lookups if the graph has a locational index), and the value there
+     * is interpolated bilinearly between the values at its four corners. The
+     * value at a corner is the mean of the RealNodes around it, weighted by
+     * the inverse of the distance to their centers, unless the corner lies
+     * along the edge of a larger RealNode, in which case it is interpolated
+     * along that edge. The field is therefore continuous across changes in
+     * resolution, and exact for linear fields wherever the RealNodes around
+     * each corner are the same size.
+     *
+     * The graph must not be modified while sampling. Sampling many coordinates
+     * at once freezes the graph (see `GraphNode::freeze`), so that it can be
+     * queried from many threads, and so calls the value function from many
+     * threads at once.
+     *
+     * @tparam T the type of value contained by the RealNodes of the graph
+     * @tparam V the type of the sampled value, which must support `V + V`
+     * and `V * double`
+     */
+    template<typename T, typename V = double>
+    class FieldSampler {
+    public:
+        /**
+         * A function that takes the value contained by a RealNode, and returns
+         * the value to interpolate (ex. one component of a velocity)
+         */
+        using ValueFunction = std::function<V(const T &)>;
+
+        // Delete the default constructor
+        FieldSampler() = delete;
+
+        /**
+         * Creates a FieldSampler that interpolates the values contained by the
+         * RealNodes of a graph, converted to V
+         * @param graph the graph to sample (must outlive this object)
+         */
+        explicit FieldSampler(GraphNode<T> &graph);
+
+        /**
+         * Creates a FieldSampler that interpolates a function of the values
+         * contained by the RealNodes of a graph
+         * @param graph the graph to sample (must outlive this object)
+         * @param value_function a function that takes the value contained by a
+         * RealNode, and returns the value to interpolate
+         */
+        FieldSampler(GraphNode<T> &graph, const ValueFunction &value_function);
+
+        /**
+         * Samples the field at the given coordinates
+         * @param coordinates the coordinates to sample at (coordinates outside
+         * the graph are moved to the closest point on its boundary)
+         * @return the interpolated value at the coordinates
+         */
+        V sample(Coordinates coordinates);
+
+        /**
+         * Samples the field at many coordinates at once (ex. every point along a
+         * set of trajectories), in parallel
+         *
+         * The coordinates are visited in Morton (Z) order, so consecutive
+         * samples tend to fall in the same RealNode, and reuse its corner
+         * values rather than finding them again.
+         * @param coordinates the coordinates to sample at (coordinates outside
+         * the graph are moved to the closest point on its boundary)
+         * @return the interpolated value at each of the coordinates, in the
+         * order they were given
+         */
+        std::vector<V> sample(const std::vector<Coordinates> &coordinates);
+
+    private:
+        // A RealNode, and the values at its corners
+        struct Stencil {
+            // The bottom left corner and scale of the RealNode
+            Coordinates origin;
+            double scale = -1;
+
+            // The values at the bottom left, bottom right, top left, and top
+            // right corners of the RealNode
+            V corner_values[4];
+        };
+
+        /**
+         * Moves coordinates to the closest point in the graph
+         * @param coordinates the coordinates to move
+         * @return the closest point in the graph to the coordinates
+         */
+        Coordinates clampToGraph(Coordinates coordinates);
+
+        /**
+         * Checks if a stencil can be used to sample at the given coordinates
+         * @param stencil the stencil to check
+         * @param coordinates the coordinates to sample at (in the graph)
+         * @return if the coordinates are in the RealNode of the stencil
+         */
+        static bool stencilCovers(const Stencil &stencil, Coordinates coordinates);
+
+        /**
+         * Finds the RealNode containing the given coordinates, and the values
+         * at its corners
+         * @param coordinates the coordinates to sample at (in the graph)
+         * @param stencil the stencil to fill in
+         */
+        void findStencil(Coordinates coordinates, Stencil &stencil);
+
+        /**
+         * Gets the value at a corner of one or more RealNodes
+         * @param vertex the coordinates of the corner
+         * @return the value at the corner
+         */
+        V getVertexValue(Coordinates vertex);
+
+        /**
+         * Interpolates between the corners of a stencil
+         * @param stencil the stencil covering the coordinates
+         * @param coordinates the coordinates to sample at
+         * @return the interpolated value at the coordinates
+         */
+        static V interpolate(const Stencil &stencil, Coordinates coordinates);
+
+        // The graph to sample
+        GraphNode<T> &graph;
+
+        // Gets the value to interpolate from the value contained by a RealNode
+        ValueFunction value_function;
+    };
+}
+
+#include "FieldSampler.tpp"
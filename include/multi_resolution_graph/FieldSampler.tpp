@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "FieldSampler.h"
+#include "LocationalCode.h"
+
+namespace multi_resolution_graph {
+
+template <typename T, typename V>
+FieldSampler<T, V>::FieldSampler(GraphNode<T> &graph) :
+    FieldSampler(graph, [](const T &value) { return static_cast<V>(value); })
+{}
+
+template <typename T, typename V>
+FieldSampler<T, V>::FieldSampler(GraphNode<T> &graph, const ValueFunction &value_function) :
+    graph(graph),
+    value_function(value_function)
+{}
+
+template <typename T, typename V>
+V FieldSampler<T, V>::sample(Coordinates coordinates) {
+    coordinates = clampToGraph(coordinates);
+    Stencil stencil;
+    findStencil(coordinates, stencil);
+    return interpolate(stencil, coordinates);
+}
+
+template <typename T, typename V>
+std::vector<V> FieldSampler<T, V>::sample(const std::vector<Coordinates> &coordinates) {
+    graph.freeze();
+    const size_t num_samples = coordinates.size();
+
+    // Sort the coordinates by the Morton code of the cell they are in, on a
+    // grid much finer than any RealNode is likely to be
+    const double num_cells = std::ldexp(1.0, 20);
+    Coordinates origin = graph.getCoordinates();
+    double scale = graph.getScale();
+    std::vector<Coordinates> clamped_coordinates(num_samples);
+    std::vector<std::pair<uint64_t, size_t>> order(num_samples);
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < num_samples; i++) {
+        clamped_coordinates[i] = clampToGraph(coordinates[i]);
+        auto index = [&](double position, double min) {
+            double cell = std::floor((position - min) / scale * num_cells);
+            return static_cast<uint32_t>(std::max(0.0, std::min(num_cells - 1, cell)));
+        };
+        order[i] = {encodeMorton(index(clamped_coordinates[i].x, origin.x),
+                                 index(clamped_coordinates[i].y, origin.y)), i};
+    }
+    std::sort(order.begin(), order.end());
+
+    // Each thread walks through a contiguous run of the sorted coordinates,
+    // only finding new corner values when it leaves the last node
+    std::vector<V> values(num_samples);
+    #pragma omp parallel
+    {
+        Stencil stencil;
+        #pragma omp for schedule(static)
+        for (size_t i = 0; i < num_samples; i++) {
+            size_t sample_index = order[i].second;
+            Coordinates sample_coordinates = clamped_coordinates[sample_index];
+            if (!stencilCovers(stencil, sample_coordinates)) {
+                findStencil(sample_coordinates, stencil);
+            }
+            values[sample_index] = interpolate(stencil, sample_coordinates);
+        }
+    }
+    return values;
+}
+
+template <typename T, typename V>
+Coordinates FieldSampler<T, V>::clampToGraph(Coordinates coordinates) {
+    Coordinates origin = graph.getCoordinates();
+    double scale = graph.getScale();
+    return {std::max(origin.x, std::min(origin.x + scale, coordinates.x)),
+            std::max(origin.y, std::min(origin.y + scale, coordinates.y))};
+}
+
+template <typename T, typename V>
+bool FieldSampler<T, V>::stencilCovers(const Stencil &stencil, Coordinates coordinates) {
+    return stencil.scale >= 0 &&
+           coordinates.x >= stencil.origin.x && coordinates.x <= stencil.origin.x + stencil.scale &&
+           coordinates.y >= stencil.origin.y && coordinates.y <= stencil.origin.y + stencil.scale;
+}
+
+template <typename T, typename V>
+void FieldSampler<T, V>::findStencil(Coordinates coordinates, Stencil &stencil) {
+    std::shared_ptr<RealNode<T>> node = graph.getNodeContainingCoordinates(coordinates);
+    stencil.origin = node->getCoordinates();
+    stencil.scale = node->getScale();
+    for (unsigned int corner = 0; corner < 4; corner++) {
+        stencil.corner_values[corner] = getVertexValue({stencil.origin.x + (corner % 2) * stencil.scale,
+                                                        stencil.origin.y + (corner / 2) * stencil.scale});
+    }
+}
+
+template <typename T, typename V>
+V FieldSampler<T, V>::getVertexValue(Coordinates vertex) {
+    // Find the nodes just below left, below right, above left, and above right
+    // of the vertex (if they are in the graph)
+    Coordinates graph_origin = graph.getCoordinates();
+    double graph_scale = graph.getScale();
+    double offset = graph_scale * 1e-9;
+    std::shared_ptr<RealNode<T>> nodes[4];
+    for (unsigned int i = 0; i < 4; i++) {
+        Coordinates point = {vertex.x + (i % 2 == 0 ? -offset : offset),
+                             vertex.y + (i / 2 == 0 ? -offset : offset)};
+        if (point.x >= graph_origin.x && point.x <= graph_origin.x + graph_scale &&
+            point.y >= graph_origin.y && point.y <= graph_origin.y + graph_scale) {
+            nodes[i] = graph.getNodeContainingCoordinates(point);
+        }
+    }
+
+    // If one node is on both sides of the vertex, the vertex lies along its
+    // edge, so interpolate between the corners at either end of that edge
+    const unsigned int pairs[4][2] = {{0, 1}, {2, 3}, {0, 2}, {1, 3}};
+    for (unsigned int pair = 0; pair < 4; pair++) {
+        const std::shared_ptr<RealNode<T>> &node = nodes[pairs[pair][0]];
+        if (!node || node != nodes[pairs[pair][1]]) {
+            continue;
+        }
+        Coordinates origin = node->getCoordinates();
+        double scale = node->getScale();
+        if (pair < 2) {
+            double fraction = (vertex.x - origin.x) / scale;
+            return getVertexValue({origin.x, vertex.y}) * (1 - fraction) +
+                   getVertexValue({origin.x + scale, vertex.y}) * fraction;
+        } else {
+            double fraction = (vertex.y - origin.y) / scale;
+            return getVertexValue({vertex.x, origin.y}) * (1 - fraction) +
+                   getVertexValue({vertex.x, origin.y + scale}) * fraction;
+        }
+    }
+
+    // Otherwise, the vertex is a corner of every node around it
+    double weights[4] = {0, 0, 0, 0};
+    double total_weight = 0;
+    for (unsigned int i = 0; i < 4; i++) {
+        if (nodes[i]) {
+            Coordinates center = nodes[i]->getCenterCoordinates();
+            weights[i] = 1 / std::hypot(center.x - vertex.x, center.y - vertex.y);
+            total_weight += weights[i];
+        }
+    }
+    V value = V();
+    bool have_value = false;
+    for (unsigned int i = 0; i < 4; i++) {
+        if (nodes[i]) {
+            V weighted_value = value_function(nodes[i]->containedValue()) * (weights[i] / total_weight);
+            value = have_value ? value + weighted_value : weighted_value;
+            have_value = true;
+        }
+    }
+    return value;
+}
+
+template <typename T, typename V>
+V FieldSampler<T, V>::interpolate(const Stencil &stencil, Coordinates coordinates) {
+    double x = std::max(0.0, std::min(1.0, (coordinates.x - stencil.origin.x) / stencil.scale));
+    double y = std::max(0.0, std::min(1.0, (coordinates.y - stencil.origin.y) / stencil.scale));
+    const V *corner_values = stencil.corner_values;
+    V bottom = corner_values[0] * (1 - x) + corner_values[1] * x;
+    V top = corner_values[2] * (1 - x) + corner_values[3] * x;
+    return bottom * (1 - y) + top * y;
+}
+
+}
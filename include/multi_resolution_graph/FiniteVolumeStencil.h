@@ -0,0 +1,158 @@
+#pragma once
+
+// C++ STD Includes
+#include <memory>
+#include <vector>
+
+#include "GraphNode.h"
+#include "ValueLayers.h"
+
+namespace multi_resolution_graph {
+    /**
+     * The faces between every pair of neighbouring RealNodes in a graph, stored
+     * in flat arrays, for running finite volume kernels (ex. diffusion, or a
+     * pressure Poisson solve) over the layers of a ValueLayers
+     *
+     * The faces of each RealNode are found once (with `RealNode::getNeighbours`),
+     * and stored in compressed sparse row form: the faces of the RealNode with
+     * leaf id `i` are `[getFaceOffsets()[i], getFaceOffsets()[i + 1])`, and for
+     * each face `f` we store the leaf id of the RealNode on the other side, the
+     * length of the edge the two nodes share (which is the length of the
+     * smaller node's side at a mixed resolution interface), and the distance
+     * between their centers along the normal to the face.
+     *
+     * Kernels are applied to every RealNode in parallel (with OpenMP), reading
+     * one layer and writing another, so no RealNode ever sees a half updated
+     * value. After the layout of the graph changes, `update` must be called.
+     *
+     * @tparam T the type of value contained by the RealNodes of the graph
+     * @tparam V the type of value stored in each layer
+     */
+    template<typename T, typename V = double>
+    class FiniteVolumeStencil {
+    public:
+        // Delete the default constructor
+        FiniteVolumeStencil() = delete;
+
+        /**
+         * Creates a FiniteVolumeStencil for the graph of the given ValueLayers,
+         * and finds every face in it
+         * @param value_layers the layers to run kernels over (must outlive this object)
+         */
+        explicit FiniteVolumeStencil(ValueLayers<T, V> &value_layers);
+
+        /**
+         * Finds every face again after the layout of the graph changed, updating
+         * the ValueLayers first (see `ValueLayers::update`)
+         */
+        void update();
+
+        /**
+         * Gets the layers kernels are run over
+         * @return the layers kernels are run over
+         */
+        ValueLayers<T, V> &getValueLayers();
+
+        /**
+         * Gets the number of RealNodes in the graph
+         * @return the number of RealNodes in the graph
+         */
+        size_t getNumLeaves() const;
+
+        /**
+         * Gets the index of the first face of every RealNode
+         * @return the index of the first face of every RealNode, by leaf id, with
+         * one extra entry at the end holding the total number of faces
+         */
+        const std::vector<size_t> &getFaceOffsets() const;
+
+        /**
+         * Gets the RealNode on the other side of every face
+         * @return the leaf id of the RealNode on the other side of every face
+         */
+        const std::vector<size_t> &getFaceNeighbours() const;
+
+        /**
+         * Gets the length of every face
+         * @return the length of the edge shared by the RealNodes on either side
+         * of every face
+         */
+        const std::vector<double> &getFaceLengths() const;
+
+        /**
+         * Gets the distance across every face
+         * @return the distance between the centers of the RealNodes on either
+         * side of every face, along the normal to the face
+         */
+        const std::vector<double> &getFaceDistances() const;
+
+        /**
+         * Gets the area of every RealNode
+         * @return the area of every RealNode, by leaf id
+         */
+        const std::vector<double> &getAreas() const;
+
+        /**
+         * Computes the value of every RealNode in one layer from the values in
+         * another, in parallel
+         * @tparam Kernel a function with the signature `V(size_t leaf, const V *values)`
+         * @param source the index of the layer to read
+         * @param destination the index of the layer to write (must not be `source`)
+         * @param kernel a function that takes the leaf id of a RealNode and every
+         * value in `source`, and returns the new value of the RealNode
+         */
+        template<typename Kernel>
+        void apply(size_t source, size_t destination, Kernel kernel);
+
+        /**
+         * Applies a kernel to a layer a given number of times, double buffering
+         * with a scratch layer. The result is always left in `layer`.
+         * @tparam Kernel a function with the signature `V(size_t leaf, const V *values)`
+         * @param layer the index of the layer to update
+         * @param scratch the index of a layer to use as the second buffer (its
+         * values are overwritten)
+         * @param num_iterations the number of times to apply the kernel
+         * @param kernel a function that takes the leaf id of a RealNode and every
+         * value in the layer, and returns the new value of the RealNode
+         */
+        template<typename Kernel>
+        void iterate(size_t layer, size_t scratch, unsigned int num_iterations, Kernel kernel);
+
+        /**
+         * Takes explicit (forward Euler) diffusion steps on a layer, where the
+         * change in each RealNode is the sum of the fluxes through its faces
+         * divided by its area. There is no flux through the edges of the graph,
+         * so the total (area weighted) value is conserved.
+         *
+         * For stability, `diffusivity * time_step` should be below a quarter of
+         * the smallest area in the graph
+         * @param layer the index of the layer to diffuse
+         * @param scratch the index of a layer to use as the second buffer
+         * @param diffusivity the diffusion coefficient
+         * @param time_step the length of each step
+         * @param num_steps the number of steps to take
+         */
+        void diffuse(size_t layer, size_t scratch, V diffusivity, V time_step, unsigned int num_steps);
+
+    private:
+        // The layers kernels are run over
+        ValueLayers<T, V> &value_layers;
+
+        // The index of the first face of every RealNode, plus the total number of faces
+        std::vector<size_t> face_offsets;
+
+        // The leaf id of the RealNode on the other side of every face
+        std::vector<size_t> face_neighbours;
+
+        // The length of every face
+        std::vector<double> face_lengths;
+
+        // The distance between the centers of the RealNodes across every face
+        std::vector<double> face_distances;
+
+        // The area of every RealNode
+        std::vector<double> areas;
+    };
+}
+
+#include "FiniteVolumeStencil.tpp"
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "FiniteVolumeStencil.h"
+
+namespace multi_resolution_graph {
+
+template <typename T, typename V>
+FiniteVolumeStencil<T, V>::FiniteVolumeStencil(ValueLayers<T, V> &value_layers) :
+    value_layers(value_layers)
+{
+    update();
+}
+
+template <typename T, typename V>
+void FiniteVolumeStencil<T, V>::update() {
+    value_layers.update();
+    const std::vector<std::shared_ptr<RealNode<T>>> &leaves = value_layers.getLeaves();
+    const size_t num_leaves = leaves.size();
+
+    // Find the faces of every node in parallel, which is safe since the
+    // graph is frozen
+    value_layers.getGraph().freeze();
+    std::vector<std::vector<std::pair<size_t, std::pair<double, double>>>> leaf_faces(num_leaves);
+    areas.assign(num_leaves, 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        RealNode<T> &node = *leaves[leaf];
+        Coordinates origin = node.getCoordinates();
+        double scale = node.getScale();
+        areas[leaf] = scale * scale;
+        for (auto& neighbour : node.getNeighbours()) {
+            Coordinates neighbour_origin = neighbour->getCoordinates();
+            double neighbour_scale = neighbour->getScale();
+            double x_overlap = std::min(origin.x + scale, neighbour_origin.x + neighbour_scale) -
+                               std::max(origin.x, neighbour_origin.x);
+            double y_overlap = std::min(origin.y + scale, neighbour_origin.y + neighbour_scale) -
+                               std::max(origin.y, neighbour_origin.y);
+            // The nodes touch along the axis they don't overlap in
+            double length = std::max(x_overlap, y_overlap);
+            if (length <= 0) {
+                // The nodes only touch at a corner
+                continue;
+            }
+            double distance = (scale + neighbour_scale) / 2;
+            leaf_faces[leaf].push_back({neighbour->getLeafId(), {length, distance}});
+        }
+    }
+
+    face_offsets.assign(num_leaves + 1, 0);
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        face_offsets[leaf + 1] = face_offsets[leaf] + leaf_faces[leaf].size();
+    }
+    const size_t num_faces = face_offsets[num_leaves];
+    face_neighbours.resize(num_faces);
+    face_lengths.resize(num_faces);
+    face_distances.resize(num_faces);
+    #pragma omp parallel for schedule(static)
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        size_t face = face_offsets[leaf];
+        for (auto& leaf_face : leaf_faces[leaf]) {
+            face_neighbours[face] = leaf_face.first;
+            face_lengths[face] = leaf_face.second.first;
+            face_distances[face] = leaf_face.second.second;
+            face++;
+        }
+    }
+}
+
+template <typename T, typename V>
+ValueLayers<T, V> &FiniteVolumeStencil<T, V>::getValueLayers() {
+    return value_layers;
+}
+
+template <typename T, typename V>
+size_t FiniteVolumeStencil<T, V>::getNumLeaves() const {
+    return areas.size();
+}
+
+template <typename T, typename V>
+const std::vector<size_t> &FiniteVolumeStencil<T, V>::getFaceOffsets() const {
+    return face_offsets;
+}
+
+template <typename T, typename V>
+const std::vector<size_t> &FiniteVolumeStencil<T, V>::getFaceNeighbours() const {
+    return face_neighbours;
+}
+
+template <typename T, typename V>
+const std::vector<double> &FiniteVolumeStencil<T, V>::getFaceLengths() const {
+    return face_lengths;
+}
+
+template <typename T, typename V>
+const std::vector<double> &FiniteVolumeStencil<T, V>::getFaceDistances() const {
+    return face_distances;
+}
+
+template <typename T, typename V>
+const std::vector<double> &FiniteVolumeStencil<T, V>::getAreas() const {
+    return areas;
+}
+
+template <typename T, typename V>
+template <typename Kernel>
+void FiniteVolumeStencil<T, V>::apply(size_t source, size_t destination, Kernel kernel) {
+    const V *source_values = value_layers.getLayer(source).data();
+    V *destination_values = value_layers.getLayer(destination).data();
+    const size_t num_leaves = getNumLeaves();
+    #pragma omp parallel for schedule(static)
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        destination_values[leaf] = kernel(leaf, source_values);
+    }
+}
+
+template <typename T, typename V>
+template <typename Kernel>
+void FiniteVolumeStencil<T, V>::iterate(size_t layer, size_t scratch, unsigned int num_iterations, Kernel kernel) {
+    for (unsigned int iteration = 0; iteration < num_iterations; iteration++) {
+        apply(layer, scratch, kernel);
+        // Swapping the buffers is constant time, and leaves the result in `layer`
+        std::swap(value_layers.getLayer(layer), value_layers.getLayer(scratch));
+    }
+}
+
+template <typename T, typename V>
+void FiniteVolumeStencil<T, V>::diffuse(size_t layer, size_t scratch, V diffusivity, V time_step,
+                                        unsigned int num_steps) {
+    const size_t *offsets = face_offsets.data();
+    const size_t *neighbours = face_neighbours.data();
+    const double *lengths = face_lengths.data();
+    const double *distances = face_distances.data();
+    const double *leaf_areas = areas.data();
+    iterate(layer, scratch, num_steps, [=](size_t leaf, const V *values) {
+        V flux = V();
+        for (size_t face = offsets[leaf]; face < offsets[leaf + 1]; face++) {
+            flux += (values[neighbours[face]] - values[leaf]) * (lengths[face] / distances[face]);
+        }
+        return values[leaf] + time_step * diffusivity * flux / leaf_areas[leaf];
+    });
+}
+
+}
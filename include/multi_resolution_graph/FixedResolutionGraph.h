@@ -0,0 +1,252 @@
+#pragma once
+
+// C++ STD Includes
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "GraphNode.h"
+#include "Area.h"
+
+namespace multi_resolution_graph {
+    /**
+     * A graph where every node below the top level splits into the same,
+     * compile time, number of sub-nodes
+     *
+     * The top level node may have any resolution (chosen at runtime), but every
+     * node below it is either a leaf (the equivalent of a RealNode), or is split
+     * into `SUBNODE_RESOLUTION x SUBNODE_RESOLUTION` sub-nodes (the equivalent of
+     * a GraphNode with that resolution). Since the number of sub-nodes is known
+     * at compile time, they are stored inline in a `std::array` instead of in
+     * nested vectors of pointers, all the index math is done with constants, and
+     * the loops over sub-nodes can be fully unrolled.
+     *
+     * @tparam T the type of value contained by every leaf
+     * @tparam SUBNODE_RESOLUTION the length/width of every node below the top
+     * level, in units of number of nodes
+     */
+    template<typename T, unsigned int SUBNODE_RESOLUTION = 2>
+    class FixedResolutionGraph {
+    public:
+        static_assert(SUBNODE_RESOLUTION >= 2, "Nodes must split into at least 2x2 sub-nodes");
+
+        // The number of sub-nodes every node below the top level splits into
+        static constexpr unsigned int NUM_SUB_NODES = SUBNODE_RESOLUTION * SUBNODE_RESOLUTION;
+
+        /**
+         * A leaf found by a query on a FixedResolutionGraph, together with where it is
+         */
+        struct Leaf {
+            // The coordinates of the bottom left corner of the leaf
+            Coordinates coordinates;
+
+            // The length/width of the leaf
+            double scale;
+
+            // The depth of the leaf (the sub-nodes of the top level node are at depth 1)
+            unsigned int depth;
+
+            // The value contained by the leaf (this points into the FixedResolutionGraph)
+            T *value;
+
+            /**
+             * Gets the value contained by this leaf
+             * @return a reference to the object contained by this leaf
+             */
+            T &containedValue() const {
+                return *value;
+            }
+        };
+
+        /**
+         * This is thrown when trying to create a FixedResolutionGraph from a
+         * graph with a GraphNode below the top level with the wrong resolution
+         */
+        class WrongResolutionException : public std::runtime_error {
+        public:
+            explicit WrongResolutionException(const char *m) : std::runtime_error(m) {}
+        };
+
+        // Delete the default constructor
+        FixedResolutionGraph() = delete;
+
+        /**
+         * Creates a FixedResolutionGraph where every sub-node of the top level
+         * node is a leaf
+         * @param top_level_resolution the length/width of the top level node in
+         * units of number of nodes
+         * @param scale the length/width of the graph
+         * @param coordinates the coordinates of the bottom left corner of the graph
+         */
+        FixedResolutionGraph(unsigned int top_level_resolution, double scale,
+                             Coordinates coordinates = {0, 0});
+
+        /**
+         * Creates a FixedResolutionGraph with the same layout and values as the
+         * given graph
+         *
+         * Throws a WrongResolutionException if any GraphNode below the top level
+         * node of the given graph does not have a resolution of `SUBNODE_RESOLUTION`
+         * @param graph the graph to copy
+         */
+        explicit FixedResolutionGraph(GraphNode<T> &graph);
+
+        /**
+         * Creates a graph made of GraphNodes with the same layout and values as
+         * this one
+         * @return the top level node of the created graph
+         */
+        std::shared_ptr<GraphNode<T>> toGraphNode() const;
+
+        /**
+         * Gets the leaf containing the given coordinates
+         * @param coordinates the coordinates to look for a leaf at (coordinates
+         * outside the graph are moved to the closest point on its boundary)
+         * @return the leaf containing the given coordinates
+         */
+        Leaf getClosestNodeToCoordinates(Coordinates coordinates);
+
+        /**
+         * Splits the leaf containing the given coordinates into
+         * `SUBNODE_RESOLUTION x SUBNODE_RESOLUTION` leaves, each containing a
+         * value initialized `T`
+         * @param coordinates the coordinates of the leaf to split (coordinates
+         * outside the graph are moved to the closest point on its boundary)
+         */
+        void changeResolutionOfClosestNode(Coordinates coordinates);
+
+        /**
+         * Gets all leaves in a given area
+         * @param area the area to look for leaves in
+         * @return all leaves that overlap the given area
+         */
+        std::vector<Leaf> getAllNodesInArea(Area<T> &area);
+
+        /**
+         * Gets every leaf in this graph
+         * @return every leaf in this graph, in the same order as
+         * `GraphNode::getAllSubNodes` returns the equivalent RealNodes
+         */
+        std::vector<Leaf> getAllSubNodes();
+
+        /**
+         * Gets the number of leaves in this graph
+         * @return the number of leaves in this graph
+         */
+        size_t getNumNodes() const;
+
+        /**
+         * Gets the resolution of the top level node of this graph
+         * @return the length/width of the top level node in units of number of nodes
+         */
+        unsigned int getResolution() const;
+
+        /**
+         * Gets the coordinates of this graph
+         * @return the coordinates of the bottom left corner of this graph
+         */
+        Coordinates getCoordinates() const;
+
+        /**
+         * Gets the scale of this graph
+         * @return the length/width of this graph
+         */
+        double getScale() const;
+
+    private:
+        /**
+         * A node below the top level node, which is either a leaf or split into
+         * exactly `NUM_SUB_NODES` sub-nodes
+         */
+        struct TreeNode {
+            // The sub-nodes of this node, in row major order, or nullptr if
+            // this is a leaf
+            std::unique_ptr<std::array<TreeNode, NUM_SUB_NODES>> sub_nodes;
+
+            // The value contained by this node (only used if this is a leaf)
+            T value{};
+        };
+
+        /**
+         * Gets the index of the cell containing a position along one axis
+         * @param position the position to find the cell of
+         * @param min the position of the start of the first cell
+         * @param cell_scale the length of each cell
+         * @param num_cells the number of cells
+         * @return the index of the cell containing the position (clamped to the
+         * range of valid cells)
+         */
+        static unsigned int getCellIndex(double position, double min,
+                                         double cell_scale, unsigned int num_cells);
+
+        /**
+         * Gets the leaf containing the given coordinates
+         * @param coordinates the coordinates to look for a leaf at
+         * @param leaf_origin set to the coordinates of the bottom left corner of the leaf
+         * @param leaf_scale set to the length/width of the leaf
+         * @param depth set to the depth of the leaf
+         * @return the leaf containing the given coordinates
+         */
+        TreeNode &getTreeNodeContaining(Coordinates coordinates, Coordinates &leaf_origin,
+                                        double &leaf_scale, unsigned int &depth);
+
+        /**
+         * Copies a node (and everything below it) from a graph made of GraphNodes
+         * @param node the node to copy
+         * @param tree_node the node to copy into
+         */
+        void copyFromNode(Node<T> &node, TreeNode &tree_node);
+
+        /**
+         * Copies a node (and everything below it) into a graph made of GraphNodes
+         * @param parent the GraphNode to copy into
+         * @param node the sub-node of `parent` to copy into (must be a RealNode)
+         * @param tree_node the node to copy
+         */
+        static void copyToNode(GraphNode<T> &parent, const std::shared_ptr<Node<T>> &node,
+                               const TreeNode &tree_node);
+
+        /**
+         * Recursively finds all leaves at or below a node that overlap an area
+         * @param area the area to look for leaves in
+         * @param tree_node the node to look in
+         * @param node_origin the coordinates of the bottom left corner of the node
+         * @param node_scale the length/width of the node
+         * @param depth the depth of the node
+         * @param leaves the list to add all found leaves to
+         */
+        static void getAllNodesInArea(Area<T> &area, TreeNode &tree_node,
+                                      Coordinates node_origin, double node_scale,
+                                      unsigned int depth, std::vector<Leaf> &leaves);
+
+        /**
+         * Recursively finds every leaf at or below a node
+         * @param tree_node the node to look in
+         * @param node_origin the coordinates of the bottom left corner of the node
+         * @param node_scale the length/width of the node
+         * @param depth the depth of the node
+         * @param leaves the list to add all found leaves to
+         */
+        static void getAllSubNodes(TreeNode &tree_node, Coordinates node_origin,
+                                   double node_scale, unsigned int depth,
+                                   std::vector<Leaf> &leaves);
+
+        // The length/width of the top level node in units of number of nodes
+        unsigned int top_level_resolution;
+
+        // The length/width of this graph
+        double scale;
+
+        // The coordinates of the bottom left corner of this graph
+        Coordinates origin;
+
+        // The sub-nodes of the top level node, in row major order
+        std::vector<TreeNode> top_level_nodes;
+
+        // The number of leaves in this graph
+        size_t num_nodes;
+    };
+}
+
+#include "FixedResolutionGraph.tpp"
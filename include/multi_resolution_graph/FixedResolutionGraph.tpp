@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "FixedResolutionGraph.h"
+
+namespace multi_resolution_graph {
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+FixedResolutionGraph<T, SUBNODE_RESOLUTION>::FixedResolutionGraph(
+        unsigned int top_level_resolution, double scale, Coordinates coordinates) :
+    top_level_resolution(top_level_resolution),
+    scale(scale),
+    origin(coordinates),
+    top_level_nodes(top_level_resolution * top_level_resolution),
+    num_nodes(top_level_resolution * top_level_resolution)
+{
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+FixedResolutionGraph<T, SUBNODE_RESOLUTION>::FixedResolutionGraph(GraphNode<T> &graph) :
+    top_level_resolution(graph.getResolution()),
+    scale(graph.getScale()),
+    origin(graph.getCoordinates()),
+    top_level_nodes(top_level_resolution * top_level_resolution),
+    num_nodes(0)
+{
+    std::vector<std::vector<std::shared_ptr<Node<T>>>> sub_nodes = graph.getSubNodes();
+    for (unsigned int row = 0; row < top_level_resolution; row++) {
+        for (unsigned int col = 0; col < top_level_resolution; col++) {
+            copyFromNode(*sub_nodes[row][col], top_level_nodes[row * top_level_resolution + col]);
+        }
+    }
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+std::shared_ptr<GraphNode<T>> FixedResolutionGraph<T, SUBNODE_RESOLUTION>::toGraphNode() const {
+    auto graph = std::make_shared<GraphNode<T>>(top_level_resolution, scale, origin);
+    std::vector<std::vector<std::shared_ptr<Node<T>>>> sub_nodes = graph->getSubNodes();
+    for (unsigned int row = 0; row < top_level_resolution; row++) {
+        for (unsigned int col = 0; col < top_level_resolution; col++) {
+            copyToNode(*graph, sub_nodes[row][col],
+                       top_level_nodes[row * top_level_resolution + col]);
+        }
+    }
+    return graph;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+typename FixedResolutionGraph<T, SUBNODE_RESOLUTION>::Leaf
+FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getClosestNodeToCoordinates(Coordinates coordinates) {
+    Coordinates leaf_origin;
+    double leaf_scale;
+    unsigned int depth;
+    TreeNode &leaf = getTreeNodeContaining(coordinates, leaf_origin, leaf_scale, depth);
+    return {leaf_origin, leaf_scale, depth, &leaf.value};
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+void FixedResolutionGraph<T, SUBNODE_RESOLUTION>::changeResolutionOfClosestNode(Coordinates coordinates) {
+    Coordinates leaf_origin;
+    double leaf_scale;
+    unsigned int depth;
+    TreeNode &leaf = getTreeNodeContaining(coordinates, leaf_origin, leaf_scale, depth);
+    leaf.sub_nodes = std::make_unique<std::array<TreeNode, NUM_SUB_NODES>>();
+    num_nodes += NUM_SUB_NODES - 1;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+std::vector<typename FixedResolutionGraph<T, SUBNODE_RESOLUTION>::Leaf>
+FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getAllNodesInArea(Area<T> &area) {
+    std::vector<Leaf> leaves;
+    double node_scale = scale / top_level_resolution;
+    for (unsigned int row = 0; row < top_level_resolution; row++) {
+        for (unsigned int col = 0; col < top_level_resolution; col++) {
+            getAllNodesInArea(area, top_level_nodes[row * top_level_resolution + col],
+                              {origin.x + col * node_scale, origin.y + row * node_scale},
+                              node_scale, 1, leaves);
+        }
+    }
+    return leaves;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+std::vector<typename FixedResolutionGraph<T, SUBNODE_RESOLUTION>::Leaf>
+FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getAllSubNodes() {
+    std::vector<Leaf> leaves;
+    leaves.reserve(num_nodes);
+    double node_scale = scale / top_level_resolution;
+    for (unsigned int row = 0; row < top_level_resolution; row++) {
+        for (unsigned int col = 0; col < top_level_resolution; col++) {
+            getAllSubNodes(top_level_nodes[row * top_level_resolution + col],
+                           {origin.x + col * node_scale, origin.y + row * node_scale},
+                           node_scale, 1, leaves);
+        }
+    }
+    return leaves;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+size_t FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getNumNodes() const {
+    return num_nodes;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+unsigned int FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getResolution() const {
+    return top_level_resolution;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+Coordinates FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getCoordinates() const {
+    return origin;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+double FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getScale() const {
+    return scale;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+unsigned int FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getCellIndex(
+        double position, double min, double cell_scale, unsigned int num_cells) {
+    double cell = std::floor((position - min) / cell_scale);
+    return static_cast<unsigned int>(std::max(0.0, std::min<double>(num_cells - 1, cell)));
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+typename FixedResolutionGraph<T, SUBNODE_RESOLUTION>::TreeNode &
+FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getTreeNodeContaining(
+        Coordinates coordinates, Coordinates &leaf_origin, double &leaf_scale, unsigned int &depth) {
+    // Find the top level sub-node containing the coordinates
+    leaf_scale = scale / top_level_resolution;
+    unsigned int row = getCellIndex(coordinates.y, origin.y, leaf_scale, top_level_resolution);
+    unsigned int col = getCellIndex(coordinates.x, origin.x, leaf_scale, top_level_resolution);
+    leaf_origin = {origin.x + col * leaf_scale, origin.y + row * leaf_scale};
+    TreeNode *node = &top_level_nodes[row * top_level_resolution + col];
+    depth = 1;
+
+    // Walk down to the leaf, where every step only uses compile time constants
+    while (node->sub_nodes) {
+        leaf_scale /= SUBNODE_RESOLUTION;
+        row = getCellIndex(coordinates.y, leaf_origin.y, leaf_scale, SUBNODE_RESOLUTION);
+        col = getCellIndex(coordinates.x, leaf_origin.x, leaf_scale, SUBNODE_RESOLUTION);
+        leaf_origin = {leaf_origin.x + col * leaf_scale, leaf_origin.y + row * leaf_scale};
+        node = &(*node->sub_nodes)[row * SUBNODE_RESOLUTION + col];
+        depth++;
+    }
+    return *node;
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+void FixedResolutionGraph<T, SUBNODE_RESOLUTION>::copyFromNode(Node<T> &node, TreeNode &tree_node) {
+    auto graph_node = asGraphNode(&node);
+    if (!graph_node) {
+        tree_node.value = static_cast<RealNode<T> &>(node).containedValue();
+        num_nodes++;
+        return;
+    }
+
+    if (graph_node->getResolution() != SUBNODE_RESOLUTION) {
+        throw WrongResolutionException(
+                "Graph contains a GraphNode below the top level with the wrong resolution");
+    }
+    tree_node.sub_nodes = std::make_unique<std::array<TreeNode, NUM_SUB_NODES>>();
+    std::vector<std::vector<std::shared_ptr<Node<T>>>> sub_nodes = graph_node->getSubNodes();
+    for (unsigned int row = 0; row < SUBNODE_RESOLUTION; row++) {
+        for (unsigned int col = 0; col < SUBNODE_RESOLUTION; col++) {
+            copyFromNode(*sub_nodes[row][col], (*tree_node.sub_nodes)[row * SUBNODE_RESOLUTION + col]);
+        }
+    }
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+void FixedResolutionGraph<T, SUBNODE_RESOLUTION>::copyToNode(
+        GraphNode<T> &parent, const std::shared_ptr<Node<T>> &node, const TreeNode &tree_node) {
+    if (!tree_node.sub_nodes) {
+        std::static_pointer_cast<RealNode<T>>(node)->containedValue() = tree_node.value;
+        return;
+    }
+
+    auto graph_node = std::static_pointer_cast<GraphNode<T>>(
+            parent.changeResolutionOfNode(node, SUBNODE_RESOLUTION));
+    std::vector<std::vector<std::shared_ptr<Node<T>>>> sub_nodes = graph_node->getSubNodes();
+    for (unsigned int row = 0; row < SUBNODE_RESOLUTION; row++) {
+        for (unsigned int col = 0; col < SUBNODE_RESOLUTION; col++) {
+            copyToNode(*graph_node, sub_nodes[row][col],
+                       (*tree_node.sub_nodes)[row * SUBNODE_RESOLUTION + col]);
+        }
+    }
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+void FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getAllNodesInArea(
+        Area<T> &area, TreeNode &tree_node, Coordinates node_origin, double node_scale,
+        unsigned int depth, std::vector<Leaf> &leaves) {
+    if (!area.overlapsSquare(node_origin, node_scale)) {
+        return;
+    }
+    if (!tree_node.sub_nodes) {
+        leaves.push_back({node_origin, node_scale, depth, &tree_node.value});
+        return;
+    }
+
+    double sub_node_scale = node_scale / SUBNODE_RESOLUTION;
+    for (unsigned int row = 0; row < SUBNODE_RESOLUTION; row++) {
+        for (unsigned int col = 0; col < SUBNODE_RESOLUTION; col++) {
+            getAllNodesInArea(area, (*tree_node.sub_nodes)[row * SUBNODE_RESOLUTION + col],
+                              {node_origin.x + col * sub_node_scale, node_origin.y + row * sub_node_scale},
+                              sub_node_scale, depth + 1, leaves);
+        }
+    }
+}
+
+template <typename T, unsigned int SUBNODE_RESOLUTION>
+void FixedResolutionGraph<T, SUBNODE_RESOLUTION>::getAllSubNodes(
+        TreeNode &tree_node, Coordinates node_origin, double node_scale,
+        unsigned int depth, std::vector<Leaf> &leaves) {
+    if (!tree_node.sub_nodes) {
+        leaves.push_back({node_origin, node_scale, depth, &tree_node.value});
+        return;
+    }
+
+    double sub_node_scale = node_scale / SUBNODE_RESOLUTION;
+    for (unsigned int row = 0; row < SUBNODE_RESOLUTION; row++) {
+        for (unsigned int col = 0; col < SUBNODE_RESOLUTION; col++) {
+            getAllSubNodes((*tree_node.sub_nodes)[row * SUBNODE_RESOLUTION + col],
+                           {node_origin.x + col * sub_node_scale, node_origin.y + row * sub_node_scale},
+                           sub_node_scale, depth + 1, leaves);
+        }
+    }
+}
+
+}
@@ -15,6 +15,8 @@ namespace multi_resolution_graph {
     public:
         using Resolution = double;
         using Scale = double;
+        // A list of areas, each with a given max scale
+        using AreaScaleList = std::vector<std::pair<std::shared_ptr<Area<T>>, Scale>>;
 
         /**
          * Creates a GraphFactory with default values
@@ -35,6 +37,17 @@ namespace multi_resolution_graph {
          */
         void setMaxScaleInArea(Area<T> &area, double max_scale);
 
+        /**
+         * Gets all the areas with a max scale set, and their max scales
+         * @return all the areas with a max scale set, and their max scales
+         */
+        const AreaScaleList &getMaxScaleAreas();
+
+        /**
+         * Clears all max scales set for points and areas
+         */
+        void clearMaxScales();
+
         /**
          * Sets the overall length/width of the graph
          * (ie. this will set the graph to be of `size x size`)
@@ -49,14 +62,142 @@ namespace multi_resolution_graph {
          */
         void setGraphTopLevelResolution(unsigned int resolution);
 
+        /**
+         * Sets the resolution that nodes are split into when the graph is
+         * created or updated (ie. each split node is replaced by
+         * `resolution x resolution` smaller nodes)
+         * @param resolution the resolution to split nodes into
+         */
+        void setSubNodeResolution(unsigned int resolution);
+
+        /**
+         * Gets the resolution that nodes are split into when the graph is
+         * created or updated
+         * @return the resolution to split nodes into
+         */
+        unsigned int getSubNodeResolution() const;
+
+        /**
+         * Sets whether graphs are balanced (see `balanceGraph`) after they are
+         * created, coarsened or updated. Graphs are not balanced by default.
+         *
+         * Note that `updateGraph` only merges nodes within removed areas, so
+         * nodes split only to balance a removed area may be left split until
+         * the graph is next coarsened.
+         * @param balanced whether graphs should be balanced
+         */
+        void setBalanced(bool balanced);
+
+        /**
+         * Splits RealNodes in a graph until no RealNode shares an edge with a
+         * RealNode more than one split smaller than it (ie. with a scale less
+         * than its scale divided by the sub-node resolution). With a sub-node
+         * resolution of 2, this is the usual 2:1 balance of a quadtree, and no
+         * RealNode has more than 8 neighbours.
+         *
+         * The first pass freezes the graph and checks every RealNode, in
+         * parallel. After that, only the nodes created by each split are frozen,
+         * and only they and the larger neighbours of the nodes that were just
+         * split are checked again, so the work done after the first pass is
+         * proportional to the number of nodes split.
+         *
+         * @param graph the graph to balance
+         * @param split a function that sets the values of the new RealNodes from
+         * each split RealNode (see `GraphNode::changeResolutionOfNode`)
+         */
+        void balanceGraph(GraphNode<T> &graph,
+                          const typename GraphNode<T>::ValueSplit &split = nullptr);
+
         /**
          * Creates a graph with the currently set parameters
          * @return a new graph with the currently set parameters
          */
         std::shared_ptr<GraphNode<T>> createGraph();
 
+        /**
+         * Merges every part of the given graph that is finer than the currently
+         * set max scales require back into single RealNodes
+         * @param graph the graph to coarsen
+         * @param reduction a function that takes all the RealNodes being merged
+         * into a single node, and returns the value the merged node should contain
+         */
+        void coarsenGraph(GraphNode<T> &graph,
+                          const typename GraphNode<T>::ValueReduction &reduction =
+                                  [](const std::vector<std::shared_ptr<RealNode<T>>> &) {
+                                      return T();
+                                  });
+
+        /**
+         * Updates a graph for a change in the areas that have max scales set
+         *
+         * Only nodes within areas that were added or removed are split or
+         * merged, every other node (and the value it contains) is left as is,
+         * so this is much cheaper then creating the graph again from scratch
+         * when only a few areas have changed.
+         *
+         * Areas are compared by identity (ie. by pointer), so an area that has
+         * moved should be given as a new area.
+         *
+         * @param graph the graph to update, which must have been created with
+         * the areas in `old_areas`
+         * @param old_areas the areas (and their max scales) the graph was created with
+         * @param new_areas the areas (and their max scales) the graph should now
+         * have. This replaces the areas set on this factory with clones of
+         * them (as with `setMaxScaleInArea`), so pass these as `old_areas` to the
+         * next update rather than the areas of this factory.
+         * @param reduction a function that takes all the RealNodes being merged
+         * into a single node, and returns the value the merged node should contain
+         */
+        void updateGraph(GraphNode<T> &graph,
+                         const AreaScaleList &old_areas,
+                         const AreaScaleList &new_areas,
+                         const typename GraphNode<T>::ValueReduction &reduction =
+                                 [](const std::vector<std::shared_ptr<RealNode<T>>> &) {
+                                     return T();
+                                 });
+
     private:
 
+        /**
+         * Merges every part of the given graph that is finer than the currently
+         * set max scales require (see `coarsenGraph`), without balancing it
+         * @param graph the graph to coarsen
+         * @param reduction a function that takes all the RealNodes being merged
+         * into a single node, and returns the value the merged node should contain
+         */
+        void coarsenSubNodes(GraphNode<T> &graph,
+                             const typename GraphNode<T>::ValueReduction &reduction);
+
+        /**
+         * Merges every part of the given graph within the given area that is
+         * finer than the currently set max scales require
+         * @param graph the graph to coarsen
+         * @param area the area to coarsen the graph in
+         * @param reduction a function that takes all the RealNodes being merged
+         * into a single node, and returns the value the merged node should contain
+         */
+        void coarsenGraphInArea(GraphNode<T> &graph, Area<T> &area,
+                                const typename GraphNode<T>::ValueReduction &reduction);
+
+        /**
+         * Checks if the currently set max scales require that the given node be split
+         * @param node the node to check
+         * @return if any max scale set for a point or area requires the given
+         * node to be split
+         */
+        bool nodeMustBeSplit(Node<T> &node);
+
+        /**
+         * Checks if a RealNode must be split to balance the graph, because it
+         * shares an edge with a RealNode more than one split smaller than it
+         * @param node the node to check
+         * @param larger_neighbours set to every neighbour of the node that is
+         * larger than it, which must be checked again if the node is split
+         * @return if the node must be split to balance the graph
+         */
+        bool nodeMustBeSplitToBalance(RealNode<T> &node,
+                                      std::vector<std::shared_ptr<RealNode<T>>> &larger_neighbours);
+
         /**
          * Sets all nodes within the given area on the given graph to the given resolution
          * @param graph_node the graph in which we're setting the min. resolution of an area
@@ -79,7 +220,7 @@ namespace multi_resolution_graph {
 
         // TODO: Better name for this variable?
         // A list of areas with a given max scale
-        std::vector<std::pair<std::shared_ptr<Area<T>>, Scale>> min_scale_areas;
+        AreaScaleList min_scale_areas;
 
         // TODO: Better name for this variable?
         // A list of points with a given max scale
@@ -94,9 +235,11 @@ namespace multi_resolution_graph {
         unsigned int top_level_graph_resolution;
 
         // TODO: Better comment?
-        // TODO: Setter function for this
         // The factor by which we subdivide nodes to build up the tree structure
         unsigned int subnode_resolution;
+
+        // Whether graphs are balanced after they are created, coarsened or updated
+        bool balanced;
     };
 }
 
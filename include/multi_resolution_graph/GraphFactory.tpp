@@ -5,6 +5,7 @@
 // STD Includes
 #include <list>
 #include <queue>
+#include <unordered_set>
 
 // Thunderbots Includes
 #include "GraphFactory.h"
@@ -15,7 +16,8 @@ template<typename T>
 GraphFactory<T>::GraphFactory() :
         top_level_graph_resolution(1),
         top_level_graph_scale(1),
-        subnode_resolution(2) {};
+        subnode_resolution(2),
+        balanced(false) {};
 
 template<typename T>
 void GraphFactory<T>::setMaxScaleAtPoint(Coordinates coordinates,
@@ -74,10 +76,150 @@ std::shared_ptr<GraphNode<T>> GraphFactory<T>::createGraph() {
         setMinGraphResolutionForPoint(graph_node_ptr, coordinates, resolution);
     }
 
+    if (balanced) {
+        balanceGraph(*graph_node_ptr);
+    }
+
     // Return the graph, setup as requested
     return graph_node_ptr;
 }
 
+template<typename T>
+const typename GraphFactory<T>::AreaScaleList &GraphFactory<T>::getMaxScaleAreas() {
+    return min_scale_areas;
+}
+
+template<typename T>
+void GraphFactory<T>::clearMaxScales() {
+    min_scale_areas.clear();
+    min_resolution_points.clear();
+}
+
+template<typename T>
+void GraphFactory<T>::coarsenGraph(GraphNode<T> &graph,
+                                   const typename GraphNode<T>::ValueReduction &reduction) {
+    coarsenSubNodes(graph, reduction);
+    if (balanced) {
+        balanceGraph(graph);
+    }
+}
+
+template<typename T>
+void GraphFactory<T>::coarsenSubNodes(GraphNode<T> &graph,
+                                      const typename GraphNode<T>::ValueReduction &reduction) {
+    // Work from the top down, so that we merge every unneeded subtree as a whole
+    for (auto &row : graph.getSubNodes()) {
+        for (auto &sub_node : row) {
+            auto sub_graph_node = asGraphNode(sub_node);
+            if (!sub_graph_node) {
+                continue;
+            }
+            // If nothing requires that this node be split, then nothing will
+            // require that any node below it is either (since they're smaller,
+            // and within this one)
+            if (nodeMustBeSplit(*sub_graph_node)) {
+                coarsenSubNodes(*sub_graph_node, reduction);
+            } else {
+                graph.mergeSubNode(sub_node, reduction);
+            }
+        }
+    }
+}
+
+template<typename T>
+void GraphFactory<T>::updateGraph(GraphNode<T> &graph,
+                                  const AreaScaleList &old_areas,
+                                  const AreaScaleList &new_areas,
+                                  const typename GraphNode<T>::ValueReduction &reduction) {
+    // Figure out which areas were removed and which were added
+    auto contains = [](const AreaScaleList &areas,
+                       const std::pair<std::shared_ptr<Area<T>>, Scale> &area_and_scale) {
+        return std::find(areas.begin(), areas.end(), area_and_scale) != areas.end();
+    };
+    AreaScaleList removed_areas;
+    for (auto const &area_and_scale : old_areas) {
+        if (!contains(new_areas, area_and_scale)) {
+            removed_areas.emplace_back(area_and_scale);
+        }
+    }
+    AreaScaleList added_areas;
+    for (auto const &area_and_scale : new_areas) {
+        if (!contains(old_areas, area_and_scale)) {
+            added_areas.emplace_back(area_and_scale);
+        }
+    }
+
+    // Store clones, as `setMaxScaleInArea` does, so the caller's areas are
+    // not shared with this factory (the caller's lists are what identify the
+    // areas in the next update)
+    min_scale_areas.clear();
+    for (auto const &area_and_scale : new_areas) {
+        min_scale_areas.emplace_back(area_and_scale.first->clone(), area_and_scale.second);
+    }
+
+    // Any node that no longer needs to be split must have been split because
+    // of an area that was removed, so we only need to look within those
+    for (auto const &area_and_scale : removed_areas) {
+        coarsenGraphInArea(graph, *area_and_scale.first, reduction);
+    }
+
+    // Split nodes in the new areas in order of decreasing scale, just
+    // like when creating the graph
+    std::sort(added_areas.begin(), added_areas.end(),
+              [&](std::pair<std::shared_ptr<Area<T>>, double> p1,
+                  std::pair<std::shared_ptr<Area<T>>, double> p2) {
+                  return p1.second > p2.second;
+              });
+    for (auto const &area_and_scale : added_areas) {
+        setMaxGraphScaleForArea(graph, *area_and_scale.first, area_and_scale.second);
+    }
+
+    if (balanced) {
+        balanceGraph(graph);
+    }
+}
+
+template<typename T>
+void GraphFactory<T>::coarsenGraphInArea(GraphNode<T> &graph, Area<T> &area,
+                                         const typename GraphNode<T>::ValueReduction &reduction) {
+    for (auto &row : graph.getSubNodes()) {
+        for (auto &sub_node : row) {
+            auto sub_graph_node = asGraphNode(sub_node);
+            if (!sub_graph_node || !area.overlapsNode(*sub_graph_node)) {
+                continue;
+            }
+            if (nodeMustBeSplit(*sub_graph_node)) {
+                coarsenGraphInArea(*sub_graph_node, area, reduction);
+            } else {
+                graph.mergeSubNode(sub_node, reduction);
+            }
+        }
+    }
+}
+
+template<typename T>
+bool GraphFactory<T>::nodeMustBeSplit(Node<T> &node) {
+    // These conditions mirror those used to split nodes when creating the graph
+    for (auto const &area_and_scale : min_scale_areas) {
+        if (node.getScale() >= area_and_scale.second &&
+            area_and_scale.first->overlapsNode(node)) {
+            return true;
+        }
+    }
+
+    Coordinates node_coordinates = node.getCoordinates();
+    for (auto const &point_and_scale : min_resolution_points) {
+        Coordinates point = point_and_scale.first;
+        if (node.getScale() > point_and_scale.second &&
+            point.x >= node_coordinates.x && point.x <= node_coordinates.x + node.getScale() &&
+            point.y >= node_coordinates.y && point.y <= node_coordinates.y + node.getScale()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // TODO: What if this function gets a negative value?
 template<typename T>
 void GraphFactory<T>::setGraphScale(double size) {
@@ -89,6 +231,89 @@ void GraphFactory<T>::setGraphTopLevelResolution(unsigned int resolution) {
     this->top_level_graph_resolution = resolution;
 }
 
+template<typename T>
+void GraphFactory<T>::setSubNodeResolution(unsigned int resolution) {
+    this->subnode_resolution = resolution;
+}
+
+template<typename T>
+unsigned int GraphFactory<T>::getSubNodeResolution() const {
+    return subnode_resolution;
+}
+
+template<typename T>
+void GraphFactory<T>::setBalanced(bool balanced) {
+    this->balanced = balanced;
+}
+
+template<typename T>
+void GraphFactory<T>::balanceGraph(GraphNode<T> &graph,
+                                   const typename GraphNode<T>::ValueSplit &split) {
+    // Freeze the graph once, and then freeze only the nodes created by each
+    // split, so every round is safe to check in parallel without walking the
+    // whole graph again
+    graph.freeze();
+    std::vector<std::shared_ptr<RealNode<T>>> nodes_to_check = graph.getAllSubNodes();
+    while (!nodes_to_check.empty()) {
+        // Check every node at once, which is safe since the graph is frozen
+        std::vector<char> must_split(nodes_to_check.size());
+        std::vector<std::vector<std::shared_ptr<RealNode<T>>>> larger_neighbours(nodes_to_check.size());
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (size_t i = 0; i < nodes_to_check.size(); i++) {
+            must_split[i] = nodeMustBeSplitToBalance(*nodes_to_check[i], larger_neighbours[i]);
+        }
+
+        // Splitting a node can only unbalance the new nodes (if the node was
+        // much larger than a neighbour), and the neighbours larger than it, so
+        // those are the only nodes we need to check next time around
+        std::unordered_set<RealNode<T> *> split_nodes;
+        std::vector<std::shared_ptr<RealNode<T>>> next_nodes_to_check;
+        for (size_t i = 0; i < nodes_to_check.size(); i++) {
+            if (must_split[i] && split_nodes.insert(nodes_to_check[i].get()).second) {
+                auto new_graph_node = std::static_pointer_cast<GraphNode<T>>(
+                        nodes_to_check[i]->convertToGraphNode(subnode_resolution, split));
+                new_graph_node->freeze();
+                std::vector<std::shared_ptr<RealNode<T>>> new_nodes = new_graph_node->getAllSubNodes();
+                next_nodes_to_check.insert(next_nodes_to_check.end(), new_nodes.begin(), new_nodes.end());
+            }
+        }
+        std::unordered_set<RealNode<T> *> next_nodes_to_check_set;
+        for (size_t i = 0; i < nodes_to_check.size(); i++) {
+            if (!must_split[i]) {
+                continue;
+            }
+            for (auto &neighbour : larger_neighbours[i]) {
+                if (split_nodes.count(neighbour.get()) == 0 &&
+                    next_nodes_to_check_set.insert(neighbour.get()).second) {
+                    next_nodes_to_check.emplace_back(neighbour);
+                }
+            }
+        }
+        nodes_to_check = std::move(next_nodes_to_check);
+    }
+}
+
+template<typename T>
+bool GraphFactory<T>::nodeMustBeSplitToBalance(RealNode<T> &node,
+                                               std::vector<std::shared_ptr<RealNode<T>>> &larger_neighbours) {
+    // Allow for a little floating point error in the scales
+    const double tolerance = 1e-9;
+    double scale = node.getScale();
+    bool must_split = false;
+    for (auto &neighbour : node.getNeighbours()) {
+        double neighbour_scale = neighbour->getScale();
+        if (neighbour_scale * subnode_resolution < scale * (1 - tolerance)) {
+            must_split = true;
+        } else if (neighbour_scale > scale * (1 + tolerance)) {
+            larger_neighbours.emplace_back(neighbour);
+        }
+    }
+    if (!must_split) {
+        larger_neighbours.clear();
+    }
+    return must_split;
+}
+
 // TODO: Make sure we're unit testing this
 template<typename T>
 void GraphFactory<T>::setMaxGraphScaleForArea(
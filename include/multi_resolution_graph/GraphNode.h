@@ -6,16 +6,63 @@
 #include <vector>
 #include <stdexcept>
 #include <array>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
 
 #include "Node.h"
 #include "RealNode.h"
+#include "ArenaAllocator.h"
+#include "LocationalCode.h"
 
 namespace multi_resolution_graph {
+    template<typename T>
+    class GraphSerializer;
+
 // TODO: Really detailed comment explaining what exactly this class is
     template<typename T>
-    class GraphNode
+    class GraphNode final
             : public Node<T>, public std::enable_shared_from_this<GraphNode<T>> {
     public:
+        // A function that takes a group of RealNodes, and returns the single
+        // value that should represent all of them
+        using ValueReduction =
+                std::function<T(const std::vector<std::shared_ptr<RealNode<T>>> &)>;
+
+        // A function that takes a RealNode that is being split, and the new
+        // RealNodes that will replace it (in row major order, starting from the
+        // bottom left), and sets the values contained by the new RealNodes.
+        // The RealNode being split is still in the graph when this is called,
+        // and is discarded afterwards, so its value may be moved from
+        using ValueSplit =
+                std::function<void(RealNode<T> &, const std::vector<std::shared_ptr<RealNode<T>>> &)>;
+
+        // A function that takes the value contained by a RealNode, and returns
+        // the number it is summarised by in value aggregates
+        // (see `enableValueAggregates`)
+        using ValueProjection = std::function<double(const T &)>;
+
+        /**
+         * A summary of the (projected) values contained by every RealNode at or
+         * below a node (see `enableValueAggregates`)
+         */
+        struct ValueAggregate {
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+            double sum = 0;
+            size_t count = 0;
+
+            /**
+             * Adds the values summarised by another aggregate to this one
+             * @param other the aggregate to add
+             */
+            void add(const ValueAggregate &other) {
+                min = std::min(min, other.min);
+                max = std::max(max, other.max);
+                sum += other.sum;
+                count += other.count;
+            }
+        };
 
         // TODO: Can we make this just return a pointer directly? This is guaranteed to find a node....
         std::optional<std::shared_ptr<RealNode<T>>>
@@ -58,6 +105,17 @@ namespace multi_resolution_graph {
          */
         GraphNode(unsigned int resolution, double scale);
 
+        /**
+         * Create a GraphNode with a given resolution and scale, placed at the given
+         * coordinates (rather than at the origin)
+         * @param resolution the length/width of this graph node in units of number of nodes
+         * (ie. this graph node will contain `resolution^2` nodes)
+         * @param scale the length/width of the sides of this graph node.
+         * Note: The absolute value of this will be used (as sadly there are no unsigned doubles in C++)
+         * @param coordinates the coordinates of the bottom left corner of this graph node
+         */
+        GraphNode(unsigned int resolution, double scale, Coordinates coordinates);
+
         /**
          * Create a GraphNode with a given resolution and parent
          * @param resolution the length/width of this graph node in units of number of nodes
@@ -83,18 +141,53 @@ namespace multi_resolution_graph {
          * Change the resolution of a given sub-node
          * @param node the sub-node to increase the resolution of
          * @param resolution the new resolution of the sub-node
+         * @param split if the sub-node is a RealNode, a function that sets the
+         * values of the new RealNodes from it (see `ValuePolicies`). If empty,
+         * the new RealNodes contain value initialized Ts
          * @return a pointer to the newly created GraphNode
          */
         std::shared_ptr<Node<T>>
         changeResolutionOfNode(const std::shared_ptr<Node<T>> &node,
-                               unsigned int resolution);
+                               unsigned int resolution,
+                               const ValueSplit &split = nullptr);
 
         /**
          * Changes the resolution of the closest node to the given coordinates
          * @param coordinates TODO
+         * @param split a function that sets the values of the new RealNodes from
+         * the closest node (see `changeResolutionOfNode`)
          */
         void changeResolutionOfClosestNode(Coordinates coordinates,
-                                           unsigned int resolution);
+                                           unsigned int resolution,
+                                           const ValueSplit &split = nullptr);
+
+        /**
+         * Merges all the nodes at and below a given sub-node into a single RealNode
+         * (ie. the reverse of `changeResolutionOfNode`)
+         * @param node the sub-node to merge
+         * @param reduction a function that takes all the RealNodes at or below the
+         * given sub-node, and returns the value that the merged node should contain
+         * @return a pointer to the newly created RealNode
+         */
+        std::shared_ptr<RealNode<T>>
+        mergeSubNode(const std::shared_ptr<Node<T>> &node,
+                     const ValueReduction &reduction =
+                             [](const std::vector<std::shared_ptr<RealNode<T>>> &) {
+                                 return T();
+                             });
+
+        /**
+         * Converts this GraphNode into a RealNode
+         * Note: Will invalidate any pointers to this Node
+         * @param reduction a function that takes all the RealNodes below this node,
+         * and returns the value that the new RealNode should contain
+         * @return a pointer to the newly created RealNode
+         */
+        std::shared_ptr<RealNode<T>> convertToRealNode(
+                const ValueReduction &reduction =
+                        [](const std::vector<std::shared_ptr<RealNode<T>>> &) {
+                            return T();
+                        });
 
         /**
          * This is thrown when a given node cannot be found beneath this node
@@ -104,6 +197,34 @@ namespace multi_resolution_graph {
             explicit NodeNotFoundException(const char *m) : std::runtime_error(m) {}
         };
 
+        /**
+         * This is thrown when an operation requires the parent of a node
+         * that does not have one
+         */
+        class NoParentException : public std::runtime_error {
+        public:
+            explicit NoParentException(const char *m) : std::runtime_error(m) {}
+        };
+
+        /**
+         * This is thrown when an operation requires every GraphNode in a graph
+         * to have a resolution of 2 (ie. for the graph to be a quadtree), and
+         * one does not
+         */
+        class NotAQuadtreeException : public std::runtime_error {
+        public:
+            explicit NotAQuadtreeException(const char *m) : std::runtime_error(m) {}
+        };
+
+        /**
+         * This is thrown when value aggregates are needed from a graph that does
+         * not keep them (see `enableValueAggregates`)
+         */
+        class NoValueAggregatesException : public std::runtime_error {
+        public:
+            explicit NoValueAggregatesException(const char *m) : std::runtime_error(m) {}
+        };
+
         /**
          * Get the resolution for this graph node
          * @return the sqrt of the number of sub-nodes in this graph node
@@ -119,6 +240,180 @@ namespace multi_resolution_graph {
          */
         std::vector<std::vector<std::shared_ptr<Node<T>>>> getSubNodes();
 
+        /**
+         * Creates a deep copy of this node and every node below it
+         *
+         * Every copied node is allocated from a single block of memory, and the
+         * copy is made without needing to look up the coordinates of any node.
+         * The copy has no parent (ie. it is the top level node of a new graph),
+         * but has the same scale and coordinates as this node.
+         *
+         * @return a copy of this node and every node below it
+         */
+        std::shared_ptr<GraphNode<T>> clone();
+
+        /**
+         * Computes and caches everything that is otherwise lazily computed
+         * (ie. coordinates) for this node and every node below it
+         *
+         * Once frozen, querying this graph will never modify it, so any number of
+         * threads may query it concurrently without locking. This only holds until
+         * the graph is next modified (ex. by `changeResolutionOfNode`), after which
+         * it must be frozen again before being queried concurrently.
+         */
+        void freeze();
+
+        /**
+         * Builds an index from the cell of every node in this graph to the node,
+         * and keeps it up to date as the graph changes (until it is disabled).
+         * With the index, `getNodeContainingCoordinates` and `getNodeAtCell` only
+         * need a handful of hash lookups, no matter how deep the graph is.
+         *
+         * Only quadtrees can be indexed, so while the index is enabled, trying to
+         * change the resolution of a node to anything other than 2 will throw a
+         * NotAQuadtreeException.
+         *
+         * This may be called on any node, but always indexes the whole graph.
+         * Throws a NotAQuadtreeException if the graph is not a quadtree
+         */
+        void enableLocationalIndex();
+
+        /**
+         * Stops maintaining the index built by `enableLocationalIndex` for the
+         * graph this node is in, and frees it
+         */
+        void disableLocationalIndex();
+
+        /**
+         * Checks if the graph this node is in has an index built by
+         * `enableLocationalIndex`
+         * @return if the graph this node is in has a locational index
+         */
+        bool hasLocationalIndex();
+
+        /**
+         * Makes every GraphNode in this graph keep a summary (see ValueAggregate)
+         * of the values contained by the RealNodes below it, and keeps these up
+         * to date as the graph changes (until they are disabled)
+         *
+         * Aggregates are updated when the resolution of a node is changed, and
+         * when a value is set with `RealNode::setContainedValue`. Values changed
+         * through `RealNode::containedValue` are not seen until
+         * `updateValueAggregates` is called.
+         *
+         * This may be called on any node, but always applies to the whole graph.
+         * @param projection a function that takes the value contained by a
+         * RealNode, and returns the number it should be summarised by
+         */
+        void enableValueAggregates(const ValueProjection &projection);
+
+        /**
+         * Stops maintaining the aggregates enabled by `enableValueAggregates`
+         * for the graph this node is in
+         */
+        void disableValueAggregates();
+
+        /**
+         * Checks if the graph this node is in keeps value aggregates
+         * (see `enableValueAggregates`)
+         * @return if the graph this node is in keeps value aggregates
+         */
+        bool hasValueAggregates();
+
+        /**
+         * Recomputes every value aggregate in the graph this node is in, after
+         * values were changed through `RealNode::containedValue`
+         *
+         * Throws a NoValueAggregatesException if the graph does not keep value
+         * aggregates
+         */
+        void updateValueAggregates();
+
+        /**
+         * Gets the summary of the values contained by every RealNode below this node
+         *
+         * Throws a NoValueAggregatesException if the graph does not keep value
+         * aggregates
+         * @return the aggregate of every value below this node
+         */
+        ValueAggregate getValueAggregate();
+
+        /**
+         * Gets all the RealNodes below this node with a (projected) value in a
+         * given range, skipping every GraphNode whose aggregate lies outside it
+         *
+         * Throws a NoValueAggregatesException if the graph does not keep value
+         * aggregates
+         * @param min the smallest value to include
+         * @param max the largest value to include
+         * @return all RealNodes below this node with a value in `[min, max]`
+         */
+        std::vector<std::shared_ptr<RealNode<T>>> getAllNodesWithValueBetween(double min, double max);
+
+        /**
+         * Gets all the RealNodes below this node in a given area, with a
+         * (projected) value in a given range, skipping every GraphNode that is
+         * outside the area or whose aggregate lies outside the range
+         *
+         * Throws a NoValueAggregatesException if the graph does not keep value
+         * aggregates
+         * @param area the area to look in
+         * @param min the smallest value to include
+         * @param max the largest value to include
+         * @return all RealNodes below this node in the area with a value in `[min, max]`
+         */
+        std::vector<std::shared_ptr<RealNode<T>>>
+        getAllNodesInAreaWithValueBetween(Area<T> &area, double min, double max);
+
+        /**
+         * Gets the RealNode containing the given coordinates
+         *
+         * If this is the top level node of a graph with a locational index, this
+         * is done by a binary search over depth, with one hash lookup per step.
+         * Otherwise, this walks down from this node to the RealNode.
+         * @param coordinates the coordinates to look for a node at (coordinates
+         * outside this node are moved to the closest point on its boundary)
+         * @return the RealNode containing the given coordinates
+         */
+        std::shared_ptr<RealNode<T>> getNodeContainingCoordinates(Coordinates coordinates);
+
+        /**
+         * Gets the node covering exactly the given cell of the quadtree this node
+         * is in, where the cells at a given depth are the `2^depth x 2^depth` equal
+         * squares that the whole graph can be split into
+         *
+         * If the graph has a locational index, this is a single hash lookup.
+         * Otherwise, this walks down from the top level node to the cell.
+         * @param depth the depth of the cell (0 is the top level node)
+         * @param x the column of the cell
+         * @param y the row of the cell
+         * @return the node covering exactly the given cell, or nullptr if there
+         * is no such node (ie. the cell is part of a larger RealNode, or is outside
+         * the graph)
+         */
+        std::shared_ptr<Node<T>> getNodeAtCell(unsigned int depth, uint32_t x, uint32_t y);
+
+        /**
+         * Gets all the RealNodes crossed by the line segment between two points,
+         * in the order in which they are crossed
+         *
+         * Cells are stepped through one at a time (DDA style), descending into
+         * GraphNodes as the segment enters them, so the cost of this is
+         * proportional to the number of cells crossed, not the size of the graph
+         *
+         * @param start the start of the line segment
+         * @param end the end of the line segment
+         * @param stop_condition a function that takes the value contained by a
+         * crossed node, and returns if we should stop traversing at that node
+         * @return all RealNodes crossed by the segment, in order from `start` to
+         * `end`. If `stop_condition` passed for some node, that node will be the
+         * last one returned
+         */
+        std::vector<std::shared_ptr<RealNode<T>>> getAllNodesAlongLine(
+                Coordinates start, Coordinates end,
+                const std::function<bool(T &)> &stop_condition =
+                        [](T &) { return false; });
+
 
     private:
 
@@ -128,12 +423,265 @@ namespace multi_resolution_graph {
          */
         GraphNode(GraphNode const &) = default;
 
+        // Allows GraphNodes to be created from within this class with an
+        // ArenaAllocator (see `clone`)
+        template<typename U>
+        friend class ArenaAllocator;
+
+        // Rebuilds graphs directly from their serialized layout
+        friend class GraphSerializer<T>;
+
+        // Finds its neighbours through its parent (see `getNeighboursOfSubNode`)
+        friend class RealNode<T>;
+
+        /**
+         * A side of a node
+         */
+        enum class Side {
+            BOTTOM,
+            TOP,
+            LEFT,
+            RIGHT
+        };
+
+        /**
+         * An index from the cell of every node in a quadtree to the node
+         * (see `enableLocationalIndex`)
+         */
+        struct LocationalIndex {
+            // Every node in the graph, by the key of the cell it covers
+            std::unordered_map<uint64_t, Node<T> *> nodes;
+
+            // The number of nodes at each depth, used to find the deepest node
+            std::vector<size_t> num_nodes_at_depth;
+        };
+
+        /**
+         * Gets the key of a cell in a LocationalIndex
+         * @param depth the depth of the cell
+         * @param x the column of the cell
+         * @param y the row of the cell
+         * @return the key of the cell (its Morton code, with a bit set above it to
+         * mark the depth)
+         */
+        static uint64_t getLocationalKey(unsigned int depth, uint32_t x, uint32_t y);
+
+        /**
+         * Gets the top level node of the graph this node is in
+         * @return the top level node of the graph this node is in
+         */
+        GraphNode<T> *getTopLevelNode();
+
+        /**
+         * Gets the cell covered by this node in a quadtree
+         * @param depth set to the depth of this node
+         * @param x set to the column of this node at that depth
+         * @param y set to the row of this node at that depth
+         */
+        void getCell(unsigned int &depth, uint32_t &x, uint32_t &y);
+
+        /**
+         * Adds a node and every node below it to a LocationalIndex
+         *
+         * Throws a NotAQuadtreeException if any of the added GraphNodes does not
+         * have a resolution of 2
+         * @param index the index to add to
+         * @param node the node to add
+         * @param depth the depth of the node
+         * @param x the column of the node
+         * @param y the row of the node
+         */
+        static void addToLocationalIndex(LocationalIndex &index, Node<T> *node,
+                                         unsigned int depth, uint32_t x, uint32_t y);
+
+        /**
+         * Removes a node and every node below it from a LocationalIndex
+         * @param index the index to remove from
+         * @param node the node to remove
+         * @param depth the depth of the node
+         * @param x the column of the node
+         * @param y the row of the node
+         */
+        static void removeFromLocationalIndex(LocationalIndex &index, Node<T> *node,
+                                              unsigned int depth, uint32_t x, uint32_t y);
+
+        /**
+         * Replaces a sub-node of this node with a newly created node, keeping the
+         * locational index and value aggregates (if there are any) up to date
+         *
+         * Throws a NotAQuadtreeException if the graph has a locational index and
+         * the replacement is a GraphNode without a resolution of 2
+         * @param row the row of the sub-node to replace
+         * @param col the column of the sub-node to replace
+         * @param replacement the node to replace it with
+         */
+        void replaceSubNode(unsigned int row, unsigned int col,
+                            std::shared_ptr<Node<T>> replacement);
+
+        /**
+         * Gets the projection used for the value aggregates of this graph
+         *
+         * Throws a NoValueAggregatesException if the graph does not keep value
+         * aggregates
+         * @return the projection used for the value aggregates of this graph
+         */
+        const ValueProjection &getValueProjection();
+
+        /**
+         * Recomputes the value aggregates of this node and every GraphNode below it
+         * @param projection the projection used for the value aggregates
+         */
+        void computeValueAggregates(const ValueProjection &projection);
+
+        /**
+         * Recomputes the value aggregate of this node from those of its sub-nodes,
+         * and then that of every node above it
+         * @param projection the projection used for the value aggregates
+         */
+        void updateValueAggregatesAbove(const ValueProjection &projection);
+
+        /**
+         * Checks if a node could contain a RealNode with a value in a given range
+         * @param node the node to check
+         * @param projection the projection used for the value aggregates
+         * @param min the smallest value to include
+         * @param max the largest value to include
+         * @return if the value of the given RealNode, or the aggregate of the
+         * given GraphNode, overlaps `[min, max]`
+         */
+        static bool hasValueBetween(Node<T> &node, const ValueProjection &projection,
+                                    double min, double max);
+
+        /**
+         * Gets every RealNode that shares (part of) an edge with a sub-node of
+         * this node
+         *
+         * If every GraphNode above the sub-node (other than the top level node,
+         * which may have any resolution) splits into 2x2, the cell of every
+         * neighbour on each side is found from the cell of the sub-node, and only
+         * the nodes in that cell along the shared edge are checked. Otherwise,
+         * this falls back to `getNeighboursOfSubNodeBySearch`.
+         * @param sub_node the sub-node to get the neighbours of
+         * @return all RealNodes sharing an edge with the sub-node, ordered by side
+         * (below, above, left, then right), and then along each side
+         */
+        std::vector<std::shared_ptr<RealNode<T>>> getNeighboursOfSubNode(Node<T> *sub_node);
+
+        /**
+         * Gets every RealNode that shares (part of) an edge with a sub-node of
+         * this node, by searching the whole graph for nodes touching its edges
+         * @param sub_node the sub-node to get the neighbours of
+         * @return all RealNodes sharing an edge with the sub-node, ordered by side
+         * (below, above, left, then right), and then along each side
+         */
+        std::vector<std::shared_ptr<RealNode<T>>> getNeighboursOfSubNodeBySearch(Node<T> *sub_node);
+
+        /**
+         * Gets the deepest node covering a cell of the graph this node is the
+         * top level node of, looking no deeper than the cell itself
+         *
+         * The cells at depth 1 are the sub-nodes of this node, and each deeper
+         * level splits every cell into 2x2 (so this node may have any
+         * resolution, as long as the GraphNodes below it are quadtrees)
+         * @param depth the depth of the cell
+         * @param x the column of the cell
+         * @param y the row of the cell
+         * @return the deepest node covering the cell, or nullptr if a GraphNode
+         * without a resolution of 2 was found in the way
+         */
+        Node<T> *getNodeCoveringCell(unsigned int depth, uint32_t x, uint32_t y);
+
+        /**
+         * Gets every RealNode at or below a node that lies along one of its sides
+         * @param node the node to look in
+         * @param side the side of the node to get the RealNodes along
+         * @param nodes the list to add the found RealNodes to, in order of
+         * increasing coordinates along the side
+         */
+        static void getSubNodesAlongSide(Node<T> *node, Side side,
+                                         std::vector<std::shared_ptr<RealNode<T>>> &nodes);
+
+        /**
+         * Adds every RealNode below this node that passes a filter to a list
+         * (see `getAllNodesThatPassFilter`)
+         * @param filter a function that takes a node, and returns if it passes
+         * @param parent_must_pass_filter whether the GraphNodes above a RealNode
+         * must also pass the filter for the RealNode to pass
+         * @param nodes the list to add the matching RealNodes to
+         */
+        void appendNodesThatPassFilter(const std::function<bool(Node<T> &)> &filter,
+                                       bool parent_must_pass_filter,
+                                       std::vector<std::shared_ptr<RealNode<T>>> &nodes);
+
+        /**
+         * Adds every RealNode below this node to a list
+         * @param nodes the list to add the RealNodes to
+         */
+        void appendAllSubNodes(std::vector<std::shared_ptr<RealNode<T>>> &nodes);
+
+        /**
+         * Used to select the constructor that leaves subNodes empty
+         */
+        struct UninitializedSubNodes {};
+
+        /**
+         * Create a GraphNode with a given resolution and parent, without any
+         * sub-nodes (these must be filled in by the caller)
+         * @param resolution the length/width of this graph node in units of number of nodes
+         * @param parent the parent node of this node
+         */
+        GraphNode(unsigned int resolution, GraphNode *parent, UninitializedSubNodes);
+
+        /**
+         * Counts this node and every node below it
+         * @param num_graph_nodes incremented for every GraphNode found
+         * @param num_real_nodes incremented for every RealNode found
+         */
+        void countNodes(size_t &num_graph_nodes, size_t &num_real_nodes);
+
+        /**
+         * Fills in the (empty) sub-nodes of the given node with copies of our own
+         * @param copy a copy of this node, with no sub-nodes
+         * @param allocator the allocator to allocate the copied sub-nodes with
+         */
+        void cloneSubNodesInto(GraphNode<T> &copy, ArenaAllocator<GraphNode<T>> &allocator);
+
         /**
          * Initializes subNodes to a 2D vector of size `resolution x resolution`
          * to RealNodes with this node as their parent
          */
         void initSubNodes();
 
+        /**
+         * Caches the coordinates of this node and every node below it
+         * @param origin the coordinates of this node
+         * @param node_scale the scale of this node
+         */
+        void freeze(Coordinates origin, double node_scale);
+
+        /**
+         * Steps a line segment through the sub-nodes of this node
+         *
+         * The segment is given as `start + t * (end - start)`, and the section of
+         * it that lies within this node is given by `[t_enter, t_exit]`
+         *
+         * @param origin the coordinates of this node
+         * @param node_scale the scale of this node
+         * @param start the start of the line segment
+         * @param end the end of the line segment
+         * @param t_enter the parameter at which the segment enters this node
+         * @param t_exit the parameter at which the segment leaves this node
+         * @param stop_condition a function that takes the value contained by a
+         * crossed node, and returns if we should stop traversing at that node
+         * @param crossed_nodes the list that every crossed RealNode is appended to
+         * @return if the traversal was stopped by `stop_condition`
+         */
+        bool traverseLine(Coordinates origin, double node_scale,
+                          Coordinates start, Coordinates end,
+                          double t_enter, double t_exit,
+                          const std::function<bool(T &)> &stop_condition,
+                          std::vector<std::shared_ptr<RealNode<T>>> &crossed_nodes);
+
         // the length/width of this graph node in units of number of nodes
         // (ie. this graph node will contain `resolution^2` nodes)
         unsigned int resolution;
@@ -159,12 +707,47 @@ namespace multi_resolution_graph {
         // Whether or not the currently cached coordinates are valid
         bool have_cached_coordinates = false;
 
-        // TODO: Mathew - Please make a deep copy function
         // TODO: Mathew - Implement destructor
 
         // The cached coordinates of this node
         Coordinates cached_coordinates;
+
+        // The locational index of this graph, if this is the top level node
+        // and the index is enabled
+        std::unique_ptr<LocationalIndex> locational_index;
+
+        // The projection used for the value aggregates of this graph, if this
+        // is the top level node and value aggregates are enabled
+        std::unique_ptr<ValueProjection> value_projection;
+
+        // The summary of the values below this node, if value aggregates are enabled
+        ValueAggregate value_aggregate;
     };
+
+    /**
+     * Casts a node to a GraphNode if it is one, using its tag instead of a
+     * `dynamic_cast`
+     * @param node the node to cast
+     * @return `node` as a GraphNode, or nullptr if it is not a GraphNode
+     */
+    template<typename T>
+    GraphNode<T> *asGraphNode(Node<T> *node) {
+        return node->getNodeType() == NodeType::GRAPH_NODE ? static_cast<GraphNode<T> *>(node) : nullptr;
+    }
+
+    /**
+     * Casts a node to a GraphNode if it is one, using its tag instead of a
+     * `dynamic_pointer_cast`
+     * @param node the node to cast
+     * @return `node` as a GraphNode, or nullptr if it is not a GraphNode
+     */
+    template<typename T>
+    std::shared_ptr<GraphNode<T>> asGraphNode(const std::shared_ptr<Node<T>> &node) {
+        if (node->getNodeType() == NodeType::GRAPH_NODE) {
+            return std::static_pointer_cast<GraphNode<T>>(node);
+        }
+        return nullptr;
+    }
 }
 
 #include "GraphNode.tpp"
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "GraphNode.h"
 
 namespace multi_resolution_graph {
 
 template <typename T>
 GraphNode<T>::GraphNode(unsigned int resolution, double scale) :
+    Node<T>(NodeType::GRAPH_NODE),
     resolution(resolution),
     scale(std::abs(scale)),
     parent(nullptr),
@@ -14,10 +19,21 @@ GraphNode<T>::GraphNode(unsigned int resolution, double scale) :
     initSubNodes();
 }
 
+template <typename T>
+GraphNode<T>::GraphNode(unsigned int resolution, double scale, Coordinates coordinates) :
+    GraphNode(resolution, scale)
+{
+    // A node without a parent never recomputes its coordinates, so we can
+    // just set them here
+    cached_coordinates = coordinates;
+    have_cached_coordinates = true;
+}
+
 template <typename T>
 // Note: If we give this node a parent, then we cannot give it a scale, because it's scale
 // will be decided by the scale of it's parent (ie. only the topmost parent will have a scale)
 GraphNode<T>::GraphNode(unsigned int resolution, GraphNode *parent) :
+    Node<T>(NodeType::GRAPH_NODE),
     resolution(resolution),
     parent(parent),
     have_cached_coordinates(false)
@@ -25,6 +41,15 @@ GraphNode<T>::GraphNode(unsigned int resolution, GraphNode *parent) :
     initSubNodes();
 }
 
+template <typename T>
+GraphNode<T>::GraphNode(unsigned int resolution, GraphNode *parent, UninitializedSubNodes) :
+    Node<T>(NodeType::GRAPH_NODE),
+    resolution(resolution),
+    parent(parent),
+    have_cached_coordinates(false)
+{
+}
+
 template <typename T>
 void GraphNode<T>::initSubNodes() {
     // Initialise the subnodes to all RealNodes
@@ -116,9 +141,19 @@ GraphNode<T>::getClosestNodeToCoordinatesThatPassesFilter(
     auto closest_node_found = (std::optional<std::shared_ptr<RealNode<T>>>());
     double distance_to_closest_node_found = -1;
     for (auto& row : subNodes) {
-        for (std::shared_ptr<Node<T>> node : row){
-            std::optional<std::shared_ptr<RealNode<T>>> closest_sub_node =
-                    node->getClosestNodeToCoordinatesThatPassesFilter(coordinates, filter, false);
+        for (auto& node : row){
+            std::optional<std::shared_ptr<RealNode<T>>> closest_sub_node;
+            switch (node->getNodeType()) {
+                case NodeType::GRAPH_NODE:
+                    closest_sub_node = static_cast<GraphNode<T>*>(node.get())
+                            ->getClosestNodeToCoordinatesThatPassesFilter(coordinates, filter, false);
+                    break;
+                case NodeType::REAL_NODE:
+                    if (filter(*node)) {
+                        closest_sub_node = std::static_pointer_cast<RealNode<T>>(node);
+                    }
+                    break;
+            }
             // Check that we found a node that passed the filter
             if (closest_sub_node){
                 double distance_to_closest_sub_node = distance((*closest_sub_node)->getCoordinates(), coordinates);
@@ -180,30 +215,55 @@ std::vector<std::shared_ptr<RealNode<T>>> GraphNode<T>::getAllNodesThatPassFilte
     // TODO: Easy performance improvement with by using OpenMP to add parallelism?
     // Search the the sub-nodes of this node
     std::vector<std::shared_ptr<RealNode<T>>> all_matching_nodes;
+    appendNodesThatPassFilter(filter, parent_must_pass_filter, all_matching_nodes);
+    return all_matching_nodes;
+}
+
+template<typename T>
+void GraphNode<T>::appendNodesThatPassFilter(const std::function<bool(Node<T> &)> &filter,
+                                             bool parent_must_pass_filter,
+                                             std::vector<std::shared_ptr<RealNode<T>>> &nodes) {
     for (auto& row : subNodes) {
-        for (std::shared_ptr<Node<T>> node : row){
-            // Concatenate all nodes found below this one to those already found
-            std::vector<std::shared_ptr<RealNode<T>>> matching_nodes = node->getAllNodesThatPassFilter(
-                    filter, parent_must_pass_filter, false);
-            all_matching_nodes.insert(all_matching_nodes.end(), matching_nodes.begin(), matching_nodes.end());
+        for (auto& node : row) {
+            switch (node->getNodeType()) {
+                case NodeType::GRAPH_NODE: {
+                    auto graph_node = static_cast<GraphNode<T>*>(node.get());
+                    if (!parent_must_pass_filter || filter(*graph_node)) {
+                        graph_node->appendNodesThatPassFilter(filter, parent_must_pass_filter, nodes);
+                    }
+                    break;
+                }
+                case NodeType::REAL_NODE:
+                    if (filter(*node)) {
+                        nodes.emplace_back(std::static_pointer_cast<RealNode<T>>(node));
+                    }
+                    break;
+            }
         }
     }
-    return all_matching_nodes;
 }
 
 template<typename T>
 std::vector<std::shared_ptr<RealNode<T>>> GraphNode<T>::getAllSubNodes() {
     std::vector<std::shared_ptr<RealNode<T>>> all_subnodes;
-    // TODO: Easy performance improvement with by using OpenMP to add parallelism?
+    appendAllSubNodes(all_subnodes);
+    return all_subnodes;
+}
+
+template<typename T>
+void GraphNode<T>::appendAllSubNodes(std::vector<std::shared_ptr<RealNode<T>>> &nodes) {
     for (auto& row : subNodes) {
-        for (std::shared_ptr<Node<T>> node : row) {
-            // TODO: Better comment?
-            // Add the subnodes below this subnode to the list of all subnodes
-            std::vector<std::shared_ptr<RealNode<T>>> curr_subnodes = node->getAllSubNodes();
-            all_subnodes.insert(all_subnodes.end(), curr_subnodes.begin(), curr_subnodes.end());
+        for (auto& node : row) {
+            switch (node->getNodeType()) {
+                case NodeType::GRAPH_NODE:
+                    static_cast<GraphNode<T>*>(node.get())->appendAllSubNodes(nodes);
+                    break;
+                case NodeType::REAL_NODE:
+                    nodes.emplace_back(std::static_pointer_cast<RealNode<T>>(node));
+                    break;
+            }
         }
     }
-    return all_subnodes;
 }
 
 
@@ -213,15 +273,270 @@ std::vector<std::vector<std::shared_ptr<Node<T>>>> GraphNode<T>::getSubNodes() {
     return subNodes;
 }
 
+template <typename T>
+std::shared_ptr<GraphNode<T>> GraphNode<T>::clone() {
+    // Figure out how much memory we need for all the copied nodes up front, so
+    // we can allocate it all at once. Every node also needs a shared_ptr control
+    // block, which we allow some extra room for
+    size_t num_graph_nodes = 0;
+    size_t num_real_nodes = 0;
+    countNodes(num_graph_nodes, num_real_nodes);
+    const size_t control_block_size = 4 * sizeof(void*);
+    ArenaAllocator<GraphNode<T>> allocator(
+            num_graph_nodes * (sizeof(GraphNode<T>) + control_block_size) +
+            num_real_nodes * (sizeof(RealNode<T>) + control_block_size));
+
+    std::shared_ptr<GraphNode<T>> copy = std::allocate_shared<GraphNode<T>>(
+            allocator, resolution, nullptr, UninitializedSubNodes());
+    copy->scale = this->getScale();
+    copy->cached_coordinates = this->getCoordinates();
+    copy->have_cached_coordinates = true;
+    cloneSubNodesInto(*copy, allocator);
+    return copy;
+}
+
+template <typename T>
+void GraphNode<T>::countNodes(size_t &num_graph_nodes, size_t &num_real_nodes) {
+    num_graph_nodes++;
+    for (auto& row : subNodes) {
+        for (auto& sub_node : row) {
+            if (auto graph_node = asGraphNode(sub_node.get())) {
+                graph_node->countNodes(num_graph_nodes, num_real_nodes);
+            } else {
+                num_real_nodes++;
+            }
+        }
+    }
+}
+
+template <typename T>
+void GraphNode<T>::cloneSubNodesInto(GraphNode<T> &copy,
+                                     ArenaAllocator<GraphNode<T>> &allocator) {
+    ArenaAllocator<RealNode<T>> real_node_allocator(allocator);
+    copy.subNodes = std::vector<std::vector<std::shared_ptr<Node<T>>>>(resolution);
+    for (unsigned int row = 0; row < resolution; row++) {
+        copy.subNodes[row].reserve(resolution);
+        for (auto& sub_node : subNodes[row]) {
+            // We copy over any cached coordinates, since the copy is in the
+            // same place as the original
+            if (auto graph_node = asGraphNode(sub_node.get())) {
+                auto graph_node_copy = std::allocate_shared<GraphNode<T>>(
+                        allocator, graph_node->resolution, &copy, UninitializedSubNodes());
+                graph_node_copy->cached_coordinates = graph_node->cached_coordinates;
+                graph_node_copy->have_cached_coordinates = graph_node->have_cached_coordinates;
+                graph_node->cloneSubNodesInto(*graph_node_copy, allocator);
+                copy.subNodes[row].emplace_back(std::move(graph_node_copy));
+            } else {
+                auto real_node = static_cast<RealNode<T>*>(sub_node.get());
+                auto real_node_copy = std::allocate_shared<RealNode<T>>(real_node_allocator, &copy);
+                real_node_copy->contained_value = real_node->contained_value;
+                real_node_copy->cached_coordinates = real_node->cached_coordinates;
+                real_node_copy->have_cached_coordinates = real_node->have_cached_coordinates;
+                copy.subNodes[row].emplace_back(std::move(real_node_copy));
+            }
+        }
+    }
+}
+
+template <typename T>
+void GraphNode<T>::freeze() {
+    freeze(this->getCoordinates(), this->getScale());
+}
+
+template <typename T>
+void GraphNode<T>::freeze(Coordinates origin, double node_scale) {
+    cached_coordinates = origin;
+    have_cached_coordinates = true;
+
+    // We know exactly where every sub-node is from our own coordinates, so
+    // we don't need to search for each of them in `getCoordinatesOfNode`
+    double sub_node_scale = node_scale / resolution;
+    for (unsigned int row = 0; row < resolution; row++) {
+        for (unsigned int col = 0; col < resolution; col++) {
+            Coordinates sub_node_origin = {origin.x + col * sub_node_scale,
+                                           origin.y + row * sub_node_scale};
+            Node<T>* sub_node = subNodes[row][col].get();
+            if (auto graph_node = asGraphNode(sub_node)) {
+                graph_node->freeze(sub_node_origin, sub_node_scale);
+            } else {
+                auto real_node = static_cast<RealNode<T>*>(sub_node);
+                real_node->cached_coordinates = sub_node_origin;
+                real_node->have_cached_coordinates = true;
+            }
+        }
+    }
+}
+
+template <typename T>
+std::vector<std::shared_ptr<RealNode<T>>> GraphNode<T>::getAllNodesAlongLine(
+        Coordinates start, Coordinates end,
+        const std::function<bool(T &)> &stop_condition) {
+    Coordinates origin = this->getCoordinates();
+    double node_scale = this->getScale();
+
+    // Clip the segment to the bounds of this node, one axis at a time
+    // (the "slab" method), to find where it enters and leaves this node
+    double t_enter = 0;
+    double t_exit = 1;
+    std::array<double, 2> starts = {start.x, start.y};
+    std::array<double, 2> deltas = {end.x - start.x, end.y - start.y};
+    std::array<double, 2> mins = {origin.x, origin.y};
+    for (int axis = 0; axis < 2; axis++) {
+        double min = mins[axis];
+        double max = mins[axis] + node_scale;
+        if (deltas[axis] == 0) {
+            // The segment is parallel to this axis, so it's either always
+            // or never within the bounds along this axis
+            if (starts[axis] < min || starts[axis] > max) {
+                return {};
+            }
+        } else {
+            double t1 = (min - starts[axis]) / deltas[axis];
+            double t2 = (max - starts[axis]) / deltas[axis];
+            t_enter = std::max(t_enter, std::min(t1, t2));
+            t_exit = std::min(t_exit, std::max(t1, t2));
+        }
+    }
+    if (t_enter > t_exit) {
+        // The segment never passes through this node
+        return {};
+    }
+
+    std::vector<std::shared_ptr<RealNode<T>>> crossed_nodes;
+    traverseLine(origin, node_scale, start, end, t_enter, t_exit,
+                 stop_condition, crossed_nodes);
+    return crossed_nodes;
+}
+
+template <typename T>
+bool GraphNode<T>::traverseLine(Coordinates origin, double node_scale,
+                                Coordinates start, Coordinates end,
+                                double t_enter, double t_exit,
+                                const std::function<bool(T &)> &stop_condition,
+                                std::vector<std::shared_ptr<RealNode<T>>> &crossed_nodes) {
+    const int res = static_cast<int>(resolution);
+    const double cell_scale = node_scale / resolution;
+    const double dx = end.x - start.x;
+    const double dy = end.y - start.y;
+    const int step_x = (dx > 0) - (dx < 0);
+    const int step_y = (dy > 0) - (dy < 0);
+
+    // Find the cell the segment enters this node in. If the entry point lies
+    // exactly on a cell boundary and we're moving in the negative direction,
+    // then we're actually entering the cell on the lower side of the boundary
+    auto cellIndex = [&](double position, double min, int step) {
+        double cell = (position - min) / cell_scale;
+        int index = step < 0 ? static_cast<int>(std::ceil(cell)) - 1
+                             : static_cast<int>(std::floor(cell));
+        return std::max(0, std::min(res - 1, index));
+    };
+    int col = cellIndex(start.x + t_enter * dx, origin.x, step_x);
+    int row = cellIndex(start.y + t_enter * dy, origin.y, step_y);
+
+    // The parameter at which we next cross a column/row boundary, and how much
+    // the parameter changes between successive column/row boundaries
+    const double infinity = std::numeric_limits<double>::infinity();
+    double t_next_col = infinity;
+    double t_delta_col = infinity;
+    if (step_x != 0) {
+        double boundary = origin.x + (col + (step_x > 0 ? 1 : 0)) * cell_scale;
+        t_next_col = (boundary - start.x) / dx;
+        t_delta_col = cell_scale / std::abs(dx);
+    }
+    double t_next_row = infinity;
+    double t_delta_row = infinity;
+    if (step_y != 0) {
+        double boundary = origin.y + (row + (step_y > 0 ? 1 : 0)) * cell_scale;
+        t_next_row = (boundary - start.y) / dy;
+        t_delta_row = cell_scale / std::abs(dy);
+    }
+
+    double t_current = t_enter;
+    while (col >= 0 && col < res && row >= 0 && row < res) {
+        double t_leave_cell = std::min({t_next_col, t_next_row, t_exit});
+
+        // Either record the node, or descend into it if it's a GraphNode
+        std::shared_ptr<Node<T>>& sub_node = subNodes[row][col];
+        if (auto graph_node = asGraphNode(sub_node.get())) {
+            Coordinates sub_node_origin = {origin.x + col * cell_scale,
+                                           origin.y + row * cell_scale};
+            if (graph_node->traverseLine(sub_node_origin, cell_scale, start, end,
+                                         t_current, t_leave_cell,
+                                         stop_condition, crossed_nodes)) {
+                return true;
+            }
+        } else {
+            auto real_node = std::static_pointer_cast<RealNode<T>>(sub_node);
+            crossed_nodes.emplace_back(real_node);
+            if (stop_condition(real_node->containedValue())) {
+                return true;
+            }
+        }
+
+        if (t_leave_cell >= t_exit) {
+            break;
+        }
+
+        // Step into whichever cell the segment crosses into next
+        if (t_next_col < t_next_row) {
+            col += step_x;
+            t_current = t_next_col;
+            t_next_col += t_delta_col;
+        } else {
+            row += step_y;
+            t_current = t_next_row;
+            t_next_row += t_delta_row;
+        }
+    }
+
+    return false;
+}
+
 template <typename T>
 std::shared_ptr<Node<T>> GraphNode<T>::changeResolutionOfNode(const std::shared_ptr<Node<T>>& node,
-                                               unsigned int resolution) {
-    for (auto& row : subNodes){
-        for (auto& subNode : row){
-            if (subNode == node){
-                // TODO: We should probably be copying over data from the nodes (if it's a RealNode?)
-                subNode = std::make_shared<GraphNode<T>>(resolution, this);
-                return subNode;
+                                               unsigned int resolution,
+                                               const ValueSplit& split) {
+    for (unsigned int row = 0; row < this->resolution; row++){
+        for (unsigned int col = 0; col < this->resolution; col++){
+            if (subNodes[row][col] == node){
+                auto graph_node = std::make_shared<GraphNode<T>>(resolution, this);
+                if (split && node->getNodeType() == NodeType::REAL_NODE) {
+                    // Check this before the split, which may move the value out of the node
+                    if (resolution != 2 && getTopLevelNode()->locational_index) {
+                        throw NotAQuadtreeException(
+                                "Only GraphNodes with a resolution of 2 can be added to an indexed graph");
+                    }
+                    std::vector<std::shared_ptr<RealNode<T>>> new_nodes;
+                    new_nodes.reserve(resolution * resolution);
+                    for (auto& sub_node_row : graph_node->subNodes) {
+                        for (auto& sub_node : sub_node_row) {
+                            new_nodes.emplace_back(std::static_pointer_cast<RealNode<T>>(sub_node));
+                        }
+                    }
+                    split(static_cast<RealNode<T>&>(*node), new_nodes);
+                }
+                replaceSubNode(row, col, std::move(graph_node));
+                return subNodes[row][col];
+            }
+        }
+    }
+
+    // We couldn't find the given node
+    throw NodeNotFoundException("Given node is not a direct sub-node of this node");
+}
+
+template <typename T>
+std::shared_ptr<RealNode<T>> GraphNode<T>::mergeSubNode(const std::shared_ptr<Node<T>>& node,
+                                                        const ValueReduction& reduction) {
+    for (unsigned int row = 0; row < resolution; row++){
+        for (unsigned int col = 0; col < resolution; col++){
+            if (subNodes[row][col] == node){
+                // Reduce the values of everything we're merging into one
+                std::vector<std::shared_ptr<RealNode<T>>> merged_nodes = node->getAllSubNodes();
+                auto real_node = std::make_shared<RealNode<T>>(this);
+                real_node->containedValue() = reduction(merged_nodes);
+                replaceSubNode(row, col, real_node);
+                return real_node;
             }
         }
     }
@@ -230,16 +545,544 @@ std::shared_ptr<Node<T>> GraphNode<T>::changeResolutionOfNode(const std::shared_
     throw NodeNotFoundException("Given node is not a direct sub-node of this node");
 }
 
+template <typename T>
+std::shared_ptr<RealNode<T>> GraphNode<T>::convertToRealNode(const ValueReduction& reduction) {
+    if (parent == nullptr) {
+        throw NoParentException("The top level node cannot be converted to a RealNode");
+    }
+    return parent->mergeSubNode(this->shared_from_this(), reduction);
+}
+
 template <typename T>
 void GraphNode<T>::changeResolutionOfClosestNode(Coordinates coordinates,
-                                              unsigned int resolution) {
+                                              unsigned int resolution,
+                                              const ValueSplit& split) {
     std::optional<std::shared_ptr<RealNode<T>>> possibleClosestNode =
             this->getClosestNodeToCoordinates(coordinates);
 
     // TODO: What if we can't find any node (should never happen, but.....)
     if (possibleClosestNode){
         std::shared_ptr<RealNode<T>> closestNode = *possibleClosestNode;
-        closestNode->convertToGraphNode(resolution);
+        closestNode->convertToGraphNode(resolution, split);
+    }
+}
+
+template <typename T>
+void GraphNode<T>::enableLocationalIndex() {
+    GraphNode<T> *top_level_node = getTopLevelNode();
+    if (top_level_node->locational_index) {
+        return;
+    }
+    // Build the index separately, so we're left without one if this isn't a quadtree
+    auto index = std::make_unique<LocationalIndex>();
+    addToLocationalIndex(*index, top_level_node, 0, 0, 0);
+    top_level_node->locational_index = std::move(index);
+}
+
+template <typename T>
+void GraphNode<T>::disableLocationalIndex() {
+    getTopLevelNode()->locational_index.reset();
+}
+
+template <typename T>
+bool GraphNode<T>::hasLocationalIndex() {
+    return getTopLevelNode()->locational_index != nullptr;
+}
+
+template <typename T>
+void GraphNode<T>::enableValueAggregates(const ValueProjection &projection) {
+    GraphNode<T> *top_level_node = getTopLevelNode();
+    top_level_node->value_projection = std::make_unique<ValueProjection>(projection);
+    top_level_node->computeValueAggregates(projection);
+}
+
+template <typename T>
+void GraphNode<T>::disableValueAggregates() {
+    getTopLevelNode()->value_projection.reset();
+}
+
+template <typename T>
+bool GraphNode<T>::hasValueAggregates() {
+    return getTopLevelNode()->value_projection != nullptr;
+}
+
+template <typename T>
+void GraphNode<T>::updateValueAggregates() {
+    getTopLevelNode()->computeValueAggregates(getValueProjection());
+}
+
+template <typename T>
+typename GraphNode<T>::ValueAggregate GraphNode<T>::getValueAggregate() {
+    // Make sure the aggregates are actually being kept up to date
+    getValueProjection();
+    return value_aggregate;
+}
+
+template <typename T>
+std::vector<std::shared_ptr<RealNode<T>>> GraphNode<T>::getAllNodesWithValueBetween(double min, double max) {
+    const ValueProjection &projection = getValueProjection();
+    auto filter = [&](Node<T> &node) {
+        return hasValueBetween(node, projection, min, max);
+    };
+    return this->getAllNodesThatPassFilter(filter, true, false);
+}
+
+template <typename T>
+std::vector<std::shared_ptr<RealNode<T>>>
+GraphNode<T>::getAllNodesInAreaWithValueBetween(Area<T> &area, double min, double max) {
+    const ValueProjection &projection = getValueProjection();
+    auto filter = [&](Node<T> &node) {
+        // Check the value first, since it doesn't need the coordinates of the node
+        return hasValueBetween(node, projection, min, max) && area.overlapsNode(node);
+    };
+    return this->getAllNodesThatPassFilter(filter, true, false);
+}
+
+template <typename T>
+const typename GraphNode<T>::ValueProjection &GraphNode<T>::getValueProjection() {
+    GraphNode<T> *top_level_node = getTopLevelNode();
+    if (!top_level_node->value_projection) {
+        throw NoValueAggregatesException("Value aggregates are not enabled for this graph");
+    }
+    return *top_level_node->value_projection;
+}
+
+template <typename T>
+void GraphNode<T>::computeValueAggregates(const ValueProjection &projection) {
+    value_aggregate = ValueAggregate();
+    for (auto& row : subNodes) {
+        for (auto& node : row) {
+            switch (node->getNodeType()) {
+                case NodeType::GRAPH_NODE: {
+                    auto graph_node = static_cast<GraphNode<T>*>(node.get());
+                    graph_node->computeValueAggregates(projection);
+                    value_aggregate.add(graph_node->value_aggregate);
+                    break;
+                }
+                case NodeType::REAL_NODE: {
+                    double value = projection(static_cast<RealNode<T>*>(node.get())->containedValue());
+                    value_aggregate.add({value, value, value, 1});
+                    break;
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void GraphNode<T>::updateValueAggregatesAbove(const ValueProjection &projection) {
+    for (GraphNode<T> *node = this; node != nullptr; node = node->parent) {
+        node->value_aggregate = ValueAggregate();
+        for (auto& row : node->subNodes) {
+            for (auto& sub_node : row) {
+                switch (sub_node->getNodeType()) {
+                    case NodeType::GRAPH_NODE:
+                        node->value_aggregate.add(static_cast<GraphNode<T>*>(sub_node.get())->value_aggregate);
+                        break;
+                    case NodeType::REAL_NODE: {
+                        double value = projection(static_cast<RealNode<T>*>(sub_node.get())->containedValue());
+                        node->value_aggregate.add({value, value, value, 1});
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+bool GraphNode<T>::hasValueBetween(Node<T> &node, const ValueProjection &projection,
+                                   double min, double max) {
+    switch (node.getNodeType()) {
+        case NodeType::GRAPH_NODE: {
+            const ValueAggregate &aggregate = static_cast<GraphNode<T>&>(node).value_aggregate;
+            return aggregate.max >= min && aggregate.min <= max;
+        }
+        case NodeType::REAL_NODE: {
+            double value = projection(static_cast<RealNode<T>&>(node).containedValue());
+            return value >= min && value <= max;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+std::shared_ptr<RealNode<T>> GraphNode<T>::getNodeContainingCoordinates(Coordinates coordinates) {
+    Coordinates origin = this->getCoordinates();
+
+    if (!locational_index) {
+        // Walk down to the node, one level at a time
+        Node<T> *node = this;
+        double node_scale = this->getScale();
+        while (auto graph_node = asGraphNode(node)) {
+            double sub_node_scale = node_scale / graph_node->resolution;
+            auto index = [&](double position, double min) {
+                double cell = std::floor((position - min) / sub_node_scale);
+                return static_cast<unsigned int>(
+                        std::max(0.0, std::min<double>(graph_node->resolution - 1, cell)));
+            };
+            unsigned int row = index(coordinates.y, origin.y);
+            unsigned int col = index(coordinates.x, origin.x);
+            origin = {origin.x + col * sub_node_scale, origin.y + row * sub_node_scale};
+            node_scale = sub_node_scale;
+            node = graph_node->subNodes[row][col].get();
+        }
+        return static_cast<RealNode<T> *>(node)->shared_from_this();
+    }
+
+    // Binary search for the depth of the RealNode containing the coordinates. If
+    // there is no node at a depth, the RealNode must be above it, and if there is
+    // a GraphNode at a depth, the RealNode must be below it.
+    int min_depth = 0;
+    int max_depth = static_cast<int>(locational_index->num_nodes_at_depth.size()) - 1;
+    while (min_depth <= max_depth) {
+        int depth = (min_depth + max_depth) / 2;
+        double num_cells = std::ldexp(1.0, depth);
+        auto index = [&](double position, double min) {
+            double cell = std::floor((position - min) / this->getScale() * num_cells);
+            return static_cast<uint32_t>(std::max(0.0, std::min(num_cells - 1, cell)));
+        };
+        auto node = locational_index->nodes.find(getLocationalKey(
+                depth, index(coordinates.x, origin.x), index(coordinates.y, origin.y)));
+        if (node == locational_index->nodes.end()) {
+            max_depth = depth - 1;
+        } else if (asGraphNode(node->second)) {
+            min_depth = depth + 1;
+        } else {
+            return static_cast<RealNode<T> *>(node->second)->shared_from_this();
+        }
+    }
+
+    // Every point in the graph is in some RealNode, so we should never get here
+    throw NodeNotFoundException("Locational index does not match the graph");
+}
+
+template <typename T>
+std::shared_ptr<Node<T>> GraphNode<T>::getNodeAtCell(unsigned int depth, uint32_t x, uint32_t y) {
+    GraphNode<T> *top_level_node = getTopLevelNode();
+    if (depth >= 32 || (uint64_t(x) >> depth) != 0 || (uint64_t(y) >> depth) != 0) {
+        return nullptr;
+    }
+
+    Node<T> *node = nullptr;
+    if (top_level_node->locational_index) {
+        auto indexed_node = top_level_node->locational_index->nodes.find(
+                getLocationalKey(depth, x, y));
+        if (indexed_node != top_level_node->locational_index->nodes.end()) {
+            node = indexed_node->second;
+        }
+    } else {
+        // Walk down to the cell, one level at a time
+        node = top_level_node;
+        for (unsigned int level = 1; level <= depth; level++) {
+            auto graph_node = asGraphNode(node);
+            if (!graph_node || graph_node->resolution != 2) {
+                return nullptr;
+            }
+            unsigned int shift = depth - level;
+            node = graph_node->subNodes[(y >> shift) & 1][(x >> shift) & 1].get();
+        }
+    }
+
+    if (node == nullptr) {
+        return nullptr;
+    }
+    if (auto graph_node = asGraphNode(node)) {
+        return graph_node->shared_from_this();
+    }
+    return static_cast<RealNode<T> *>(node)->shared_from_this();
+}
+
+template <typename T>
+uint64_t GraphNode<T>::getLocationalKey(unsigned int depth, uint32_t x, uint32_t y) {
+    return (uint64_t(1) << (2 * depth)) | encodeMorton(x, y);
+}
+
+template <typename T>
+GraphNode<T> *GraphNode<T>::getTopLevelNode() {
+    GraphNode<T> *node = this;
+    while (node->parent != nullptr) {
+        node = node->parent;
+    }
+    return node;
+}
+
+template <typename T>
+void GraphNode<T>::getCell(unsigned int &depth, uint32_t &x, uint32_t &y) {
+    if (parent == nullptr) {
+        depth = 0;
+        x = 0;
+        y = 0;
+        return;
+    }
+    parent->getCell(depth, x, y);
+    for (unsigned int row = 0; row < parent->resolution; row++) {
+        for (unsigned int col = 0; col < parent->resolution; col++) {
+            if (parent->subNodes[row][col].get() == this) {
+                depth++;
+                x = x * parent->resolution + col;
+                y = y * parent->resolution + row;
+                return;
+            }
+        }
+    }
+    throw NodeNotFoundException("Node is not a sub-node of its parent");
+}
+
+template <typename T>
+void GraphNode<T>::addToLocationalIndex(LocationalIndex &index, Node<T> *node,
+                                        unsigned int depth, uint32_t x, uint32_t y) {
+    // The depth is limited by the number of bits in the key
+    if (depth >= 32) {
+        throw NotAQuadtreeException("Graph is too deep to be indexed");
+    }
+    auto graph_node = asGraphNode(node);
+    if (graph_node && graph_node->resolution != 2) {
+        throw NotAQuadtreeException("Only GraphNodes with a resolution of 2 can be indexed");
+    }
+
+    index.nodes[getLocationalKey(depth, x, y)] = node;
+    if (index.num_nodes_at_depth.size() <= depth) {
+        index.num_nodes_at_depth.resize(depth + 1, 0);
+    }
+    index.num_nodes_at_depth[depth]++;
+
+    if (graph_node) {
+        for (uint32_t row = 0; row < 2; row++) {
+            for (uint32_t col = 0; col < 2; col++) {
+                addToLocationalIndex(index, graph_node->subNodes[row][col].get(),
+                                     depth + 1, 2 * x + col, 2 * y + row);
+            }
+        }
+    }
+}
+
+template <typename T>
+void GraphNode<T>::removeFromLocationalIndex(LocationalIndex &index, Node<T> *node,
+                                             unsigned int depth, uint32_t x, uint32_t y) {
+    index.nodes.erase(getLocationalKey(depth, x, y));
+    index.num_nodes_at_depth[depth]--;
+    while (!index.num_nodes_at_depth.empty() && index.num_nodes_at_depth.back() == 0) {
+        index.num_nodes_at_depth.pop_back();
+    }
+
+    if (auto graph_node = asGraphNode(node)) {
+        for (uint32_t row = 0; row < 2; row++) {
+            for (uint32_t col = 0; col < 2; col++) {
+                removeFromLocationalIndex(index, graph_node->subNodes[row][col].get(),
+                                          depth + 1, 2 * x + col, 2 * y + row);
+            }
+        }
+    }
+}
+
+template <typename T>
+void GraphNode<T>::replaceSubNode(unsigned int row, unsigned int col,
+                                  std::shared_ptr<Node<T>> replacement) {
+    GraphNode<T> *top_level_node = getTopLevelNode();
+    if (top_level_node->locational_index) {
+        auto graph_node = asGraphNode(replacement.get());
+        if (graph_node && graph_node->resolution != 2) {
+            throw NotAQuadtreeException(
+                    "Only GraphNodes with a resolution of 2 can be added to an indexed graph");
+        }
+
+        unsigned int depth;
+        uint32_t x, y;
+        getCell(depth, x, y);
+        LocationalIndex &index = *top_level_node->locational_index;
+        removeFromLocationalIndex(index, subNodes[row][col].get(), depth + 1, 2 * x + col, 2 * y + row);
+        addToLocationalIndex(index, replacement.get(), depth + 1, 2 * x + col, 2 * y + row);
+    }
+    subNodes[row][col] = std::move(replacement);
+
+    if (top_level_node->value_projection) {
+        const ValueProjection &projection = *top_level_node->value_projection;
+        if (auto graph_node = asGraphNode(subNodes[row][col].get())) {
+            graph_node->computeValueAggregates(projection);
+        }
+        updateValueAggregatesAbove(projection);
+    }
+}
+
+template <typename T>
+std::vector<std::shared_ptr<RealNode<T>>> GraphNode<T>::getNeighboursOfSubNode(Node<T> *sub_node) {
+    // Cells can only be used if every node above the sub-node, below the top
+    // level node, splits into 2x2 (the top level node may have any resolution)
+    GraphNode<T> *top_level_node = this;
+    unsigned int depth = 1;
+    while (top_level_node->parent != nullptr) {
+        if (top_level_node->resolution != 2) {
+            return getNeighboursOfSubNodeBySearch(sub_node);
+        }
+        top_level_node = top_level_node->parent;
+        depth++;
+    }
+    if (depth > 32 || (uint64_t(top_level_node->resolution) << (depth - 1)) > std::numeric_limits<uint32_t>::max()) {
+        return getNeighboursOfSubNodeBySearch(sub_node);
+    }
+
+    // Find the cell covered by the sub-node
+    unsigned int parent_depth;
+    uint32_t x, y;
+    getCell(parent_depth, x, y);
+    for (uint32_t row = 0; row < resolution; row++) {
+        for (uint32_t col = 0; col < resolution; col++) {
+            if (subNodes[row][col].get() == sub_node) {
+                x = resolution * x + col;
+                y = resolution * y + row;
+            }
+        }
+    }
+
+    // The cell on each side of the sub-node, and the side of that cell facing it
+    const uint32_t num_cells = top_level_node->resolution << (depth - 1);
+    struct NeighbouringCell {
+        bool in_graph;
+        uint32_t x;
+        uint32_t y;
+        Side facing_side;
+    };
+    std::array<NeighbouringCell, 4> neighbouring_cells = {{
+            {y > 0, x, y - 1, Side::TOP},
+            {y + 1 < num_cells, x, y + 1, Side::BOTTOM},
+            {x > 0, x - 1, y, Side::RIGHT},
+            {x + 1 < num_cells, x + 1, y, Side::LEFT}
+    }};
+
+    std::vector<std::shared_ptr<RealNode<T>>> neighbours;
+    for (auto &cell : neighbouring_cells) {
+        if (!cell.in_graph) {
+            continue;
+        }
+        // The neighbour is either a single node at least as large as the
+        // sub-node, or a GraphNode the same size split into smaller neighbours
+        Node<T> *node = top_level_node->getNodeCoveringCell(depth, cell.x, cell.y);
+        if (node == nullptr) {
+            return getNeighboursOfSubNodeBySearch(sub_node);
+        }
+        getSubNodesAlongSide(node, cell.facing_side, neighbours);
+    }
+    return neighbours;
+}
+
+template <typename T>
+std::vector<std::shared_ptr<RealNode<T>>> GraphNode<T>::getNeighboursOfSubNodeBySearch(Node<T> *sub_node) {
+    Coordinates coordinates = sub_node->getCoordinates();
+    double scale = sub_node->getScale();
+    double tolerance = 1e-9 * scale;
+
+    // A node touches an edge of the sub-node if the two overlap (or just touch)
+    // along both axes, and actually overlap along at least one of them
+    std::vector<std::shared_ptr<RealNode<T>>> neighbours =
+            getTopLevelNode()->getAllNodesThatPassFilter(
+                    [&](Node<T> &node) {
+                        Coordinates node_coordinates = node.getCoordinates();
+                        double node_scale = node.getScale();
+                        double x_overlap = std::min(coordinates.x + scale, node_coordinates.x + node_scale) -
+                                           std::max(coordinates.x, node_coordinates.x);
+                        double y_overlap = std::min(coordinates.y + scale, node_coordinates.y + node_scale) -
+                                           std::max(coordinates.y, node_coordinates.y);
+                        return x_overlap > -tolerance && y_overlap > -tolerance &&
+                               (x_overlap > tolerance || y_overlap > tolerance);
+                    },
+                    true, false);
+    neighbours.erase(std::remove_if(neighbours.begin(), neighbours.end(),
+                                    [&](auto &node) { return node.get() == sub_node; }),
+                     neighbours.end());
+
+    // Order the neighbours by side, and then along each side
+    auto getSide = [&](RealNode<T> &node) {
+        Coordinates node_coordinates = node.getCoordinates();
+        if (std::abs(node_coordinates.y + node.getScale() - coordinates.y) <= tolerance) {
+            return Side::BOTTOM;
+        } else if (std::abs(node_coordinates.y - (coordinates.y + scale)) <= tolerance) {
+            return Side::TOP;
+        } else if (std::abs(node_coordinates.x + node.getScale() - coordinates.x) <= tolerance) {
+            return Side::LEFT;
+        }
+        return Side::RIGHT;
+    };
+    std::sort(neighbours.begin(), neighbours.end(), [&](auto &a, auto &b) {
+        Side a_side = getSide(*a);
+        Side b_side = getSide(*b);
+        if (a_side != b_side) {
+            return a_side < b_side;
+        }
+        if (a_side == Side::BOTTOM || a_side == Side::TOP) {
+            return a->getCoordinates().x < b->getCoordinates().x;
+        }
+        return a->getCoordinates().y < b->getCoordinates().y;
+    });
+    return neighbours;
+}
+
+template <typename T>
+Node<T> *GraphNode<T>::getNodeCoveringCell(unsigned int depth, uint32_t x, uint32_t y) {
+    if (locational_index) {
+        // Look for the cell, and then each larger cell containing it in turn
+        for (unsigned int level = 0; level <= depth; level++) {
+            auto node = locational_index->nodes.find(
+                    getLocationalKey(depth - level, x >> level, y >> level));
+            if (node != locational_index->nodes.end()) {
+                return node->second;
+            }
+        }
+        return nullptr;
+    }
+
+    // Walk down to the cell, stopping early if we reach a RealNode. The cells
+    // at the first level are the sub-nodes of this node, so only the levels
+    // below it need to split into 2x2
+    Node<T> *node = this;
+    for (unsigned int level = 1; level <= depth; level++) {
+        auto graph_node = asGraphNode(node);
+        if (!graph_node) {
+            return node;
+        }
+        unsigned int shift = depth - level;
+        if (level == 1) {
+            uint32_t row = y >> shift;
+            uint32_t col = x >> shift;
+            if (row >= graph_node->resolution || col >= graph_node->resolution) {
+                return nullptr;
+            }
+            node = graph_node->subNodes[row][col].get();
+        } else {
+            if (graph_node->resolution != 2) {
+                return nullptr;
+            }
+            node = graph_node->subNodes[(y >> shift) & 1][(x >> shift) & 1].get();
+        }
+    }
+    return node;
+}
+
+template <typename T>
+void GraphNode<T>::getSubNodesAlongSide(Node<T> *node, Side side,
+                                        std::vector<std::shared_ptr<RealNode<T>>> &nodes) {
+    auto graph_node = asGraphNode(node);
+    if (!graph_node) {
+        nodes.emplace_back(static_cast<RealNode<T> *>(node)->shared_from_this());
+        return;
+    }
+
+    unsigned int last = graph_node->resolution - 1;
+    for (unsigned int i = 0; i <= last; i++) {
+        switch (side) {
+            case Side::BOTTOM:
+                getSubNodesAlongSide(graph_node->subNodes[0][i].get(), side, nodes);
+                break;
+            case Side::TOP:
+                getSubNodesAlongSide(graph_node->subNodes[last][i].get(), side, nodes);
+                break;
+            case Side::LEFT:
+                getSubNodesAlongSide(graph_node->subNodes[i][0].get(), side, nodes);
+                break;
+            case Side::RIGHT:
+                getSubNodesAlongSide(graph_node->subNodes[i][last].get(), side, nodes);
+                break;
+        }
     }
 }
 
@@ -0,0 +1,152 @@
+#pragma once
+
+// C++ STD Includes
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "GraphNode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Writes graphs to, and reads graphs from, a compact binary format
+     *
+     * The format is:
+     *  - a `Header`
+     *  - one `uint32_t` resolution code per node, in pre-order (each GraphNode is
+     *    followed by its sub-nodes, row by row). A GraphNode's code is its
+     *    resolution, and a RealNode's code is 0
+     *  - padding up to a multiple of 8 bytes
+     *  - the `contained_value` of every RealNode, in the same order as their codes
+     *
+     * Everything is stored in the byte order of the machine that wrote it.
+     * Only graphs containing trivially copyable values may be serialized.
+     */
+    template<typename T>
+    class GraphSerializer {
+    public:
+        // The version of the format written by `writeGraph`
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        // The magic string at the start of every serialized graph
+        static constexpr char MAGIC[8] = "MRGRAPH";
+
+        // Written in the byte order of the writing machine, so that graphs
+        // written with a different byte order can be detected
+        static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        // The deepest a GraphNode may be nested below the top level node. No
+        // useful graph is nearly this deep (splitting in 2 this many times
+        // shrinks even the largest double scale to 0), so this only stops
+        // corrupt data from overflowing the stack while it is read.
+        static constexpr unsigned int MAX_DEPTH = 2100;
+
+        /**
+         * The fixed size header at the start of every serialized graph
+         */
+        struct Header {
+            // Always `MAGIC`
+            char magic[8];
+
+            // The version of the format
+            uint32_t version;
+
+            // Always `BYTE_ORDER_MARK`
+            uint32_t byte_order_mark;
+
+            // The size of each contained value, in bytes
+            uint32_t value_size;
+
+            // Unused, keeps the following members 8 byte aligned
+            uint32_t reserved;
+
+            // The scale of the top level node
+            double scale;
+
+            // The coordinates of the top level node
+            double x;
+            double y;
+
+            // The number of resolution codes (ie. the total number of nodes)
+            uint64_t num_nodes;
+
+            // The number of contained values (ie. the number of RealNodes)
+            uint64_t num_values;
+        };
+
+        /**
+         * This is thrown when the data being read is not a valid serialized graph
+         */
+        class InvalidGraphFormatException : public std::runtime_error {
+        public:
+            explicit InvalidGraphFormatException(const char *m) : std::runtime_error(m) {}
+        };
+
+        /**
+         * Writes the given graph to a stream
+         * @param graph the graph to write
+         * @param out the stream to write the graph to
+         */
+        static void writeGraph(GraphNode<T> &graph, std::ostream &out);
+
+        /**
+         * Reads a graph that was written with `writeGraph` from a stream
+         *
+         * The whole graph is read in one go, and the hierarchy is rebuilt from the
+         * resolution codes alone (no coordinates are computed while loading)
+         *
+         * Throws an InvalidGraphFormatException if the data is not a valid graph.
+         * The sizes in the data are checked before anything is allocated for
+         * them, so corrupt data can't make this allocate more than the data holds,
+         * and GraphNodes nested more than `MAX_DEPTH` deep are rejected.
+         * @param in the stream to read the graph from
+         * @return the top level node of the graph that was read
+         */
+        static std::shared_ptr<GraphNode<T>> readGraph(std::istream &in);
+
+        /**
+         * Checks that a header is valid for graphs containing `T`
+         *
+         * Throws an InvalidGraphFormatException if it is not
+         * @param header the header to check
+         */
+        static void checkHeader(const Header &header);
+
+        /**
+         * Gets the offset of the contained values from the start of a serialized graph
+         * @param header the header of the serialized graph
+         * @return the offset of the contained values, in bytes
+         */
+        static uint64_t getValuesOffset(const Header &header);
+
+    private:
+        /**
+         * Appends the resolution codes and contained values for a node and every
+         * node below it
+         * @param node the node to append
+         * @param codes the list to append the resolution codes to
+         * @param values the list to append the contained values to
+         */
+        static void appendNode(Node<T> &node, std::vector<uint32_t> &codes,
+                               std::vector<T> &values);
+
+        /**
+         * Fills in the (empty) sub-nodes of a GraphNode from serialized codes and values
+         * @param node the node to fill in
+         * @param codes the next resolution code to read (advanced as codes are read)
+         * @param codes_end one past the last resolution code
+         * @param values the next contained value to read (advanced as values are read)
+         * @param values_end one past the last contained value
+         * @param depth how far the node is nested below the top level node
+         */
+        static void readSubNodes(GraphNode<T> &node,
+                                 const uint32_t *&codes, const uint32_t *codes_end,
+                                 const char *&values, const char *values_end,
+                                 unsigned int depth);
+    };
+}
+
+#include "GraphSerializer.tpp"
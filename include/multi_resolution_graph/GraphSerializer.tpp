@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "GraphSerializer.h"
+
+namespace multi_resolution_graph {
+
+template <typename T>
+void GraphSerializer<T>::writeGraph(GraphNode<T> &graph, std::ostream &out) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only graphs of trivially copyable values can be serialized");
+
+    std::vector<uint32_t> codes;
+    std::vector<T> values;
+    appendNode(graph, codes, values);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.byte_order_mark = BYTE_ORDER_MARK;
+    header.value_size = sizeof(T);
+    header.scale = graph.getScale();
+    header.x = graph.getCoordinates().x;
+    header.y = graph.getCoordinates().y;
+    header.num_nodes = codes.size();
+    header.num_values = values.size();
+
+    const char padding[8] = {};
+    uint64_t codes_end = sizeof(Header) + codes.size() * sizeof(uint32_t);
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    out.write(reinterpret_cast<const char *>(codes.data()),
+              codes.size() * sizeof(uint32_t));
+    out.write(padding, getValuesOffset(header) - codes_end);
+    out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+std::shared_ptr<GraphNode<T>> GraphSerializer<T>::readGraph(std::istream &in) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only graphs of trivially copyable values can be serialized");
+
+    Header header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(Header))) {
+        throw InvalidGraphFormatException("Could not read graph header");
+    }
+    checkHeader(header);
+
+    // Check the header against the amount of data actually left before
+    // allocating anything, so a corrupt header can't ask for a huge buffer
+    uint64_t values_offset = getValuesOffset(header) - sizeof(Header);
+    uint64_t body_size = values_offset + header.num_values * sizeof(T);
+    std::istream::pos_type body_start = in.tellg();
+    if (body_start != std::istream::pos_type(-1)) {
+        in.seekg(0, std::ios::end);
+        std::istream::pos_type stream_end = in.tellg();
+        in.seekg(body_start);
+        if (stream_end == std::istream::pos_type(-1) || !in ||
+            static_cast<uint64_t>(stream_end - body_start) < body_size) {
+            throw InvalidGraphFormatException("Graph data is shorter than its header says");
+        }
+    }
+
+    // Read everything after the header, in chunks so that (even if the size
+    // of the stream is unknown) the buffer never grows far past the data
+    const uint64_t chunk_size = uint64_t(1) << 20;
+    std::vector<uint32_t> body;
+    uint64_t num_bytes_read = 0;
+    while (num_bytes_read < body_size) {
+        uint64_t num_bytes = std::min(chunk_size, body_size - num_bytes_read);
+        body.resize((num_bytes_read + num_bytes + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+        if (!in.read(reinterpret_cast<char *>(body.data()) + num_bytes_read, num_bytes)) {
+            throw InvalidGraphFormatException("Graph data is shorter than its header says");
+        }
+        num_bytes_read += num_bytes;
+    }
+
+    const uint32_t *codes = body.data();
+    const uint32_t *codes_end = codes + header.num_nodes;
+    const char *values = reinterpret_cast<const char *>(body.data()) + values_offset;
+    const char *values_end = values + header.num_values * sizeof(T);
+
+    std::shared_ptr<GraphNode<T>> graph(new GraphNode<T>(
+            *codes++, nullptr, typename GraphNode<T>::UninitializedSubNodes()));
+    graph->scale = header.scale;
+    graph->cached_coordinates = Coordinates{header.x, header.y};
+    graph->have_cached_coordinates = true;
+    readSubNodes(*graph, codes, codes_end, values, values_end, 0);
+
+    if (codes != codes_end || values != values_end) {
+        throw InvalidGraphFormatException("Graph data is longer than its layout");
+    }
+    return graph;
+}
+
+template <typename T>
+void GraphSerializer<T>::checkHeader(const Header &header) {
+    if (std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0) {
+        throw InvalidGraphFormatException("Data is not a serialized graph");
+    }
+    if (header.version != FORMAT_VERSION) {
+        throw InvalidGraphFormatException("Unsupported graph format version");
+    }
+    if (header.byte_order_mark != BYTE_ORDER_MARK) {
+        throw InvalidGraphFormatException("Graph was written with a different byte order");
+    }
+    if (header.value_size != sizeof(T)) {
+        throw InvalidGraphFormatException("Graph contains values of a different size");
+    }
+    // Every graph has at least a top level GraphNode, and every RealNode
+    // has exactly one code and one value
+    if (header.num_nodes == 0 || header.num_values >= header.num_nodes) {
+        throw InvalidGraphFormatException("Graph header has an invalid number of nodes");
+    }
+    // The size of the data must fit in 64 bits
+    const uint64_t max_size = std::numeric_limits<uint64_t>::max() / 2;
+    if (header.num_nodes > max_size / sizeof(uint32_t) || header.num_values > max_size / sizeof(T)) {
+        throw InvalidGraphFormatException("Graph header has an invalid number of nodes");
+    }
+}
+
+template <typename T>
+uint64_t GraphSerializer<T>::getValuesOffset(const Header &header) {
+    uint64_t codes_end = sizeof(Header) + header.num_nodes * sizeof(uint32_t);
+    return (codes_end + 7) / 8 * 8;
+}
+
+template <typename T>
+void GraphSerializer<T>::appendNode(Node<T> &node, std::vector<uint32_t> &codes,
+                                    std::vector<T> &values) {
+    if (auto graph_node = asGraphNode(&node)) {
+        codes.emplace_back(graph_node->resolution);
+        for (auto &row : graph_node->subNodes) {
+            for (auto &sub_node : row) {
+                appendNode(*sub_node, codes, values);
+            }
+        }
+    } else {
+        codes.emplace_back(0);
+        values.emplace_back(static_cast<RealNode<T> &>(node).containedValue());
+    }
+}
+
+template <typename T>
+void GraphSerializer<T>::readSubNodes(GraphNode<T> &node,
+                                      const uint32_t *&codes, const uint32_t *codes_end,
+                                      const char *&values, const char *values_end,
+                                      unsigned int depth) {
+    if (node.resolution == 0) {
+        throw InvalidGraphFormatException("Graph contains a node with a resolution of 0");
+    }
+    if (depth > MAX_DEPTH) {
+        throw InvalidGraphFormatException("Graph contains GraphNodes nested too deeply");
+    }
+    uint64_t num_sub_nodes = static_cast<uint64_t>(node.resolution) * node.resolution;
+    if (num_sub_nodes > static_cast<uint64_t>(codes_end - codes)) {
+        throw InvalidGraphFormatException("Graph layout is missing nodes");
+    }
+    node.subNodes = std::vector<std::vector<std::shared_ptr<Node<T>>>>(node.resolution);
+    for (auto &row : node.subNodes) {
+        row.reserve(node.resolution);
+        for (unsigned int col = 0; col < node.resolution; col++) {
+            if (codes == codes_end) {
+                throw InvalidGraphFormatException("Graph layout is missing nodes");
+            }
+            uint32_t code = *codes++;
+            if (code == 0) {
+                if (values == values_end) {
+                    throw InvalidGraphFormatException("Graph is missing values");
+                }
+                auto real_node = std::make_shared<RealNode<T>>(&node);
+                std::memcpy(&real_node->containedValue(), values, sizeof(T));
+                values += sizeof(T);
+                row.emplace_back(std::move(real_node));
+            } else {
+                std::shared_ptr<GraphNode<T>> graph_node(new GraphNode<T>(
+                        code, &node, typename GraphNode<T>::UninitializedSubNodes()));
+                readSubNodes(*graph_node, codes, codes_end, values, values_end, depth + 1);
+                row.emplace_back(std::move(graph_node));
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+// C++ STD Includes
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "GraphNode.h"
+#include "Area.h"
+#include "LocationalCode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * A quadtree graph (ie. one where every GraphNode has a resolution of 2)
+     * stored without any pointers, as a flat array of RealNodes
+     *
+     * Each RealNode is identified by its locational code, the Morton code of its
+     * bottom left corner at the finest possible depth, together with its depth
+     * in the tree. The codes are kept sorted (in Z-order), so every GraphNode's
+     * RealNodes are stored together, and its values are kept in a parallel array.
+     * This makes the graph much smaller, and much faster to scan, than the same
+     * graph made of GraphNodes.
+     *
+     * The layout of a LinearQuadtree is fixed once it is created, but the values
+     * it contains may be changed.
+     */
+    template<typename T>
+    class LinearQuadtree {
+    public:
+        // The deepest a RealNode may be in the tree (limited by the number
+        // of bits in a locational code)
+        static constexpr unsigned int MAX_DEPTH = 31;
+
+        /**
+         * A RealNode found by a query on a LinearQuadtree, together with where it is
+         */
+        struct Leaf {
+            // The index of the node in the LinearQuadtree
+            size_t index;
+
+            // The coordinates of the bottom left corner of the node
+            Coordinates coordinates;
+
+            // The length/width of the node
+            double scale;
+
+            // The value contained by the node (this points into the LinearQuadtree)
+            T *value;
+
+            /**
+             * Gets the value contained by this node
+             * @return a reference to the object contained by this node
+             */
+            T &containedValue() const {
+                return *value;
+            }
+        };
+
+        /**
+         * This is thrown when trying to create a LinearQuadtree from a graph
+         * that is not a quadtree
+         */
+        class NotAQuadtreeException : public std::runtime_error {
+        public:
+            explicit NotAQuadtreeException(const char *m) : std::runtime_error(m) {}
+        };
+
+        // Delete the default constructor
+        LinearQuadtree() = delete;
+
+        /**
+         * Creates a LinearQuadtree with the same layout and values as the given graph
+         *
+         * Throws a NotAQuadtreeException if any GraphNode in the given graph does
+         * not have a resolution of 2, or if the graph is deeper than `MAX_DEPTH`
+         * @param graph the graph to copy
+         */
+        explicit LinearQuadtree(GraphNode<T> &graph);
+
+        /**
+         * Creates a graph made of GraphNodes with the same layout and values as
+         * this one
+         * @return the top level node of the created graph
+         */
+        std::shared_ptr<GraphNode<T>> toGraphNode();
+
+        /**
+         * Gets the RealNode containing the given coordinates, by binary search
+         * @param coordinates the coordinates to look for a node at (coordinates
+         * outside the graph are moved to the closest point on its boundary)
+         * @return the RealNode containing the given coordinates
+         */
+        Leaf getClosestNodeToCoordinates(Coordinates coordinates);
+
+        /**
+         * Gets all RealNodes in a given area
+         * @param area the area to look for nodes in
+         * @return all RealNodes that overlap the given area, in Z-order
+         */
+        std::vector<Leaf> getAllNodesInArea(Area<T> &area);
+
+        /**
+         * Gets all RealNodes in a given axis aligned rectangle. Every GraphNode
+         * entirely within the rectangle is found by a single scan over its range
+         * of locational codes, without checking any of the nodes below it.
+         * @param min the bottom left corner of the rectangle
+         * @param max the top right corner of the rectangle
+         * @return all RealNodes that overlap the rectangle, in Z-order
+         */
+        std::vector<Leaf> getAllNodesInRectangle(Coordinates min, Coordinates max);
+
+        /**
+         * Gets every RealNode in this graph
+         * @return every RealNode in this graph, in Z-order
+         */
+        std::vector<Leaf> getAllSubNodes();
+
+        /**
+         * Gets every RealNode that shares (part of) an edge with the given node
+         * @param node the node to get the neighbours of
+         * @return all RealNodes sharing an edge with the given node
+         */
+        std::vector<Leaf> getNeighbours(const Leaf &node);
+
+        /**
+         * Gets the number of RealNodes in this graph
+         * @return the number of RealNodes in this graph
+         */
+        size_t getNumNodes() const;
+
+        /**
+         * Gets the coordinates of this graph
+         * @return the coordinates of the bottom left corner of this graph
+         */
+        Coordinates getCoordinates() const;
+
+        /**
+         * Gets the scale of this graph
+         * @return the length/width of this graph
+         */
+        double getScale() const;
+
+    private:
+        /**
+         * How much of a cell a query covers
+         */
+        enum class Overlap {
+            NONE,
+            PARTIAL,
+            FULL
+        };
+
+        /**
+         * Appends the RealNodes at or below a node, in Z-order
+         * @param node the node to append
+         * @param code the locational code of the node
+         * @param depth the depth of the node
+         */
+        void appendNode(Node<T> &node, uint64_t code, unsigned int depth);
+
+        /**
+         * Gets the index of the RealNode containing the cell with the given code
+         * @param code the locational code of a cell at the deepest depth
+         * @return the index of the RealNode containing that cell
+         */
+        size_t getIndexOfNodeContaining(uint64_t code) const;
+
+        /**
+         * Gets the number of locational codes covered by a cell at a given depth
+         * @param depth the depth of the cell
+         * @return the number of locational codes covered by the cell
+         */
+        static uint64_t getCodeRangeSize(unsigned int depth);
+
+        /**
+         * Gets the coordinates of the bottom left corner of a cell
+         * @param code the locational code of the cell
+         * @return the coordinates of the bottom left corner of the cell
+         */
+        Coordinates getCoordinatesOfCode(uint64_t code) const;
+
+        /**
+         * Gets the length/width of a cell at a given depth
+         * @param depth the depth of the cell
+         * @return the length/width of the cell
+         */
+        double getScaleAtDepth(unsigned int depth) const;
+
+        /**
+         * Creates a Leaf for the RealNode at the given index
+         * @param index the index of the node
+         * @return a Leaf for the node
+         */
+        Leaf makeLeaf(size_t index);
+
+        /**
+         * Recursively finds all RealNodes in the cell with the given code that
+         * overlap a query
+         * @param code the locational code of the cell
+         * @param depth the depth of the cell
+         * @param overlap a function that takes the coordinates and scale of a
+         * cell, and returns how much of it the query covers
+         * @param leaves the list to add all found nodes to
+         */
+        void getAllNodesInCell(uint64_t code, unsigned int depth,
+                               const std::function<Overlap(Coordinates, double)> &overlap,
+                               std::vector<Leaf> &leaves);
+
+        // The locational code of every RealNode, in increasing order
+        std::vector<uint64_t> codes;
+
+        // The depth of every RealNode (parallel to `codes`)
+        std::vector<uint8_t> depths;
+
+        // The value contained by every RealNode (parallel to `codes`)
+        std::vector<T> values;
+
+        // The coordinates of the bottom left corner of this graph
+        Coordinates origin;
+
+        // The length/width of this graph
+        double scale;
+    };
+}
+
+#include "LinearQuadtree.tpp"
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "LinearQuadtree.h"
+
+namespace multi_resolution_graph {
+
+template <typename T>
+LinearQuadtree<T>::LinearQuadtree(GraphNode<T> &graph) :
+    origin(graph.getCoordinates()),
+    scale(graph.getScale())
+{
+    appendNode(graph, 0, 0);
+}
+
+template <typename T>
+std::shared_ptr<GraphNode<T>> LinearQuadtree<T>::toGraphNode() {
+    auto graph = std::make_shared<GraphNode<T>>(2, scale, origin);
+    for (size_t i = 0; i < codes.size(); i++) {
+        // Walk down to the node, splitting any RealNodes in the way
+        std::shared_ptr<GraphNode<T>> graph_node = graph;
+        for (unsigned int depth = 1; depth <= depths[i]; depth++) {
+            unsigned int quadrant = (codes[i] >> (2 * (MAX_DEPTH - depth))) & 3;
+            std::shared_ptr<Node<T>> sub_node =
+                    graph_node->getSubNodes()[quadrant >> 1][quadrant & 1];
+            if (depth == depths[i]) {
+                std::static_pointer_cast<RealNode<T>>(sub_node)->containedValue() = values[i];
+            } else if (auto sub_graph_node = asGraphNode(sub_node)) {
+                graph_node = sub_graph_node;
+            } else {
+                graph_node = std::static_pointer_cast<GraphNode<T>>(
+                        graph_node->changeResolutionOfNode(sub_node, 2));
+            }
+        }
+    }
+    return graph;
+}
+
+template <typename T>
+typename LinearQuadtree<T>::Leaf
+LinearQuadtree<T>::getClosestNodeToCoordinates(Coordinates coordinates) {
+    // Find the cell at the deepest depth containing the coordinates
+    const double num_cells = std::ldexp(1.0, MAX_DEPTH);
+    auto index = [&](double position, double min) {
+        double cell = std::floor((position - min) / scale * num_cells);
+        return static_cast<uint32_t>(std::max(0.0, std::min(num_cells - 1, cell)));
+    };
+    uint64_t code = encodeMorton(index(coordinates.x, origin.x), index(coordinates.y, origin.y));
+    return makeLeaf(getIndexOfNodeContaining(code));
+}
+
+template <typename T>
+std::vector<typename LinearQuadtree<T>::Leaf>
+LinearQuadtree<T>::getAllNodesInArea(Area<T> &area) {
+    std::vector<Leaf> leaves;
+    getAllNodesInCell(0, 0,
+                      [&](Coordinates cell_origin, double cell_scale) {
+                          return area.overlapsSquare(cell_origin, cell_scale) ?
+                                 Overlap::PARTIAL : Overlap::NONE;
+                      },
+                      leaves);
+    return leaves;
+}
+
+template <typename T>
+std::vector<typename LinearQuadtree<T>::Leaf>
+LinearQuadtree<T>::getAllNodesInRectangle(Coordinates min, Coordinates max) {
+    std::vector<Leaf> leaves;
+    getAllNodesInCell(0, 0,
+                      [&](Coordinates cell_origin, double cell_scale) {
+                          Coordinates cell_max = {cell_origin.x + cell_scale,
+                                                  cell_origin.y + cell_scale};
+                          if (cell_origin.x > max.x || cell_max.x < min.x ||
+                              cell_origin.y > max.y || cell_max.y < min.y) {
+                              return Overlap::NONE;
+                          }
+                          if (cell_origin.x >= min.x && cell_max.x <= max.x &&
+                              cell_origin.y >= min.y && cell_max.y <= max.y) {
+                              return Overlap::FULL;
+                          }
+                          return Overlap::PARTIAL;
+                      },
+                      leaves);
+    return leaves;
+}
+
+template <typename T>
+std::vector<typename LinearQuadtree<T>::Leaf> LinearQuadtree<T>::getAllSubNodes() {
+    std::vector<Leaf> leaves;
+    leaves.reserve(codes.size());
+    for (size_t i = 0; i < codes.size(); i++) {
+        leaves.emplace_back(makeLeaf(i));
+    }
+    return leaves;
+}
+
+template <typename T>
+std::vector<typename LinearQuadtree<T>::Leaf>
+LinearQuadtree<T>::getNeighbours(const Leaf &node) {
+    // Everything here is measured in cells at the deepest depth
+    const uint64_t num_cells = uint64_t(1) << MAX_DEPTH;
+    uint64_t code = codes[node.index];
+    unsigned int depth = depths[node.index];
+    uint64_t size = uint64_t(1) << (MAX_DEPTH - depth);
+    uint64_t x = decodeMortonX(code);
+    uint64_t y = decodeMortonY(code);
+    uint64_t x_step = interleaveBits(size);
+    uint64_t y_step = interleaveBits(size) << 1;
+
+    // The code of the cell the same size as the node on each side of it, and
+    // a function that checks if a node in that cell touches the shared edge
+    using EdgeCheck = std::function<bool(uint64_t, uint64_t, uint64_t)>;
+    std::vector<std::pair<uint64_t, EdgeCheck>> sides;
+    if (x + size < num_cells) {
+        sides.emplace_back(addMortonX(code, x_step),
+                           [&](uint64_t other_x, uint64_t, uint64_t) { return other_x == x + size; });
+    }
+    if (x > 0) {
+        sides.emplace_back(subtractMortonX(code, x_step),
+                           [&](uint64_t other_x, uint64_t, uint64_t other_size) {
+                               return other_x + other_size == x;
+                           });
+    }
+    if (y + size < num_cells) {
+        sides.emplace_back(addMortonY(code, y_step),
+                           [&](uint64_t, uint64_t other_y, uint64_t) { return other_y == y + size; });
+    }
+    if (y > 0) {
+        sides.emplace_back(subtractMortonY(code, y_step),
+                           [&](uint64_t, uint64_t other_y, uint64_t other_size) {
+                               return other_y + other_size == y;
+                           });
+    }
+
+    std::vector<Leaf> neighbours;
+    for (auto &side : sides) {
+        uint64_t side_code = side.first;
+        size_t index = getIndexOfNodeContaining(side_code);
+        if (depths[index] <= depth) {
+            // The neighbouring cell is (part of) a single node
+            neighbours.emplace_back(makeLeaf(index));
+            continue;
+        }
+        // The neighbouring cell is split, so scan through the nodes in it for
+        // the ones along the shared edge
+        uint64_t side_code_end = side_code + getCodeRangeSize(depth);
+        for (; index < codes.size() && codes[index] < side_code_end; index++) {
+            uint64_t other_size = uint64_t(1) << (MAX_DEPTH - depths[index]);
+            if (side.second(decodeMortonX(codes[index]), decodeMortonY(codes[index]),
+                            other_size)) {
+                neighbours.emplace_back(makeLeaf(index));
+            }
+        }
+    }
+    return neighbours;
+}
+
+template <typename T>
+size_t LinearQuadtree<T>::getNumNodes() const {
+    return codes.size();
+}
+
+template <typename T>
+Coordinates LinearQuadtree<T>::getCoordinates() const {
+    return origin;
+}
+
+template <typename T>
+double LinearQuadtree<T>::getScale() const {
+    return scale;
+}
+
+template <typename T>
+void LinearQuadtree<T>::appendNode(Node<T> &node, uint64_t code, unsigned int depth) {
+    auto graph_node = asGraphNode(&node);
+    if (!graph_node) {
+        codes.emplace_back(code);
+        depths.emplace_back(depth);
+        values.emplace_back(static_cast<RealNode<T> &>(node).containedValue());
+        return;
+    }
+
+    if (graph_node->getResolution() != 2) {
+        throw NotAQuadtreeException("Graph contains a GraphNode without a resolution of 2");
+    }
+    if (depth >= MAX_DEPTH) {
+        throw NotAQuadtreeException("Graph is too deep to store as a LinearQuadtree");
+    }
+
+    // Going through the quadrants in Z-order keeps the codes sorted
+    std::vector<std::vector<std::shared_ptr<Node<T>>>> sub_nodes = graph_node->getSubNodes();
+    for (unsigned int quadrant = 0; quadrant < 4; quadrant++) {
+        uint64_t sub_node_code = code |
+                (uint64_t(quadrant) << (2 * (MAX_DEPTH - depth - 1)));
+        appendNode(*sub_nodes[quadrant >> 1][quadrant & 1], sub_node_code, depth + 1);
+    }
+}
+
+template <typename T>
+size_t LinearQuadtree<T>::getIndexOfNodeContaining(uint64_t code) const {
+    // The node containing the cell is the last one that starts at or before it
+    return std::upper_bound(codes.begin(), codes.end(), code) - codes.begin() - 1;
+}
+
+template <typename T>
+uint64_t LinearQuadtree<T>::getCodeRangeSize(unsigned int depth) {
+    return uint64_t(1) << (2 * (MAX_DEPTH - depth));
+}
+
+template <typename T>
+Coordinates LinearQuadtree<T>::getCoordinatesOfCode(uint64_t code) const {
+    return {origin.x + std::ldexp(scale * decodeMortonX(code), -int(MAX_DEPTH)),
+            origin.y + std::ldexp(scale * decodeMortonY(code), -int(MAX_DEPTH))};
+}
+
+template <typename T>
+double LinearQuadtree<T>::getScaleAtDepth(unsigned int depth) const {
+    return std::ldexp(scale, -int(depth));
+}
+
+template <typename T>
+typename LinearQuadtree<T>::Leaf LinearQuadtree<T>::makeLeaf(size_t index) {
+    return {index, getCoordinatesOfCode(codes[index]), getScaleAtDepth(depths[index]),
+            &values[index]};
+}
+
+template <typename T>
+void LinearQuadtree<T>::getAllNodesInCell(
+        uint64_t code, unsigned int depth,
+        const std::function<Overlap(Coordinates, double)> &overlap,
+        std::vector<Leaf> &leaves) {
+    Overlap cell_overlap = overlap(getCoordinatesOfCode(code), getScaleAtDepth(depth));
+    if (cell_overlap == Overlap::NONE) {
+        return;
+    }
+
+    size_t index = getIndexOfNodeContaining(code);
+    if (cell_overlap == Overlap::FULL || depths[index] == depth) {
+        // Every node in this cell is wanted (or this cell is a single node), and
+        // they're all stored together, so just take all of them
+        uint64_t code_end = code + getCodeRangeSize(depth);
+        for (; index < codes.size() && codes[index] < code_end; index++) {
+            leaves.emplace_back(makeLeaf(index));
+        }
+        return;
+    }
+
+    for (unsigned int quadrant = 0; quadrant < 4; quadrant++) {
+        uint64_t sub_cell_code = code | (uint64_t(quadrant) << (2 * (MAX_DEPTH - depth - 1)));
+        getAllNodesInCell(sub_cell_code, depth + 1, overlap, leaves);
+    }
+}
+
+}
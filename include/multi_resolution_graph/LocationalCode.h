@@ -0,0 +1,120 @@
+#pragma once
+
+// C++ STD Includes
+#include <cstdint>
+
+namespace multi_resolution_graph {
+    // Helpers for working with Morton (Z-order) codes, which interleave the bits
+    // of an x and y index (x in the even bits, y in the odd bits). Sorting cells
+    // by their Morton code keeps every quadtree cell's descendants together.
+
+    // The bits of a Morton code that hold the x index
+    constexpr uint64_t MORTON_X_BITS = 0x5555555555555555ull;
+
+    // The bits of a Morton code that hold the y index
+    constexpr uint64_t MORTON_Y_BITS = 0xAAAAAAAAAAAAAAAAull;
+
+    /**
+     * Spreads the bits of a number out into the even bits of a 64 bit number
+     * @param value the number to spread out
+     * @return `value`, with a 0 bit inserted above each bit
+     */
+    inline uint64_t interleaveBits(uint32_t value) {
+        uint64_t bits = value;
+        bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFull;
+        bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFull;
+        bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+        bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+        return bits;
+    }
+
+    /**
+     * The reverse of `interleaveBits`
+     * @param bits a number with the bits to gather in its even bits
+     * @return the even bits of `bits`, packed together
+     */
+    inline uint32_t compactBits(uint64_t bits) {
+        bits &= 0x5555555555555555ull;
+        bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+        bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+        bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFull;
+        bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFull;
+        bits = (bits | (bits >> 16)) & 0x00000000FFFFFFFFull;
+        return static_cast<uint32_t>(bits);
+    }
+
+    /**
+     * Gets the Morton code of a cell
+     * @param x the column of the cell
+     * @param y the row of the cell
+     * @return the Morton code of the cell
+     */
+    inline uint64_t encodeMorton(uint32_t x, uint32_t y) {
+        return interleaveBits(x) | (interleaveBits(y) << 1);
+    }
+
+    /**
+     * Gets the column of a cell from its Morton code
+     * @param code the Morton code of the cell
+     * @return the column of the cell
+     */
+    inline uint32_t decodeMortonX(uint64_t code) {
+        return compactBits(code);
+    }
+
+    /**
+     * Gets the row of a cell from its Morton code
+     * @param code the Morton code of the cell
+     * @return the row of the cell
+     */
+    inline uint32_t decodeMortonY(uint64_t code) {
+        return compactBits(code >> 1);
+    }
+
+    /**
+     * Adds to the x index of a Morton code, without decoding it
+     * (wraps around if the x index overflows)
+     * @param code the Morton code to add to
+     * @param x_step the Morton code of the amount to add (ie. `interleaveBits(step)`)
+     * @return `code`, with its x index increased by the step
+     */
+    inline uint64_t addMortonX(uint64_t code, uint64_t x_step) {
+        // Filling in the y bits makes carries skip over them
+        return (((code | MORTON_Y_BITS) + x_step) & MORTON_X_BITS) | (code & MORTON_Y_BITS);
+    }
+
+    /**
+     * Adds to the y index of a Morton code, without decoding it
+     * (wraps around if the y index overflows)
+     * @param code the Morton code to add to
+     * @param y_step the Morton code of the amount to add (ie. `interleaveBits(step) << 1`)
+     * @return `code`, with its y index increased by the step
+     */
+    inline uint64_t addMortonY(uint64_t code, uint64_t y_step) {
+        return (((code | MORTON_X_BITS) + y_step) & MORTON_Y_BITS) | (code & MORTON_X_BITS);
+    }
+
+    /**
+     * Subtracts from the x index of a Morton code, without decoding it
+     * (wraps around if the x index underflows)
+     * @param code the Morton code to subtract from
+     * @param x_step the Morton code of the amount to subtract (ie. `interleaveBits(step)`)
+     * @return `code`, with its x index decreased by the step
+     */
+    inline uint64_t subtractMortonX(uint64_t code, uint64_t x_step) {
+        // Clearing the y bits makes borrows skip over them
+        return (((code & MORTON_X_BITS) - x_step) & MORTON_X_BITS) | (code & MORTON_Y_BITS);
+    }
+
+    /**
+     * Subtracts from the y index of a Morton code, without decoding it
+     * (wraps around if the y index underflows)
+     * @param code the Morton code to subtract from
+     * @param y_step the Morton code of the amount to subtract (ie. `interleaveBits(step) << 1`)
+     * @return `code`, with its y index decreased by the step
+     */
+    inline uint64_t subtractMortonY(uint64_t code, uint64_t y_step) {
+        return (((code & MORTON_Y_BITS) - y_step) & MORTON_Y_BITS) | (code & MORTON_X_BITS);
+    }
+}
@@ -0,0 +1,301 @@
+#pragma once
+
+// C++ STD Includes
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GraphNode.h"
+#include "Area.h"
+
+namespace multi_resolution_graph {
+    /**
+     * A read-only view of a graph stored in a flat block of memory, usually a
+     * memory mapped file
+     *
+     * The graph is queried in place, so opening and querying it never allocates
+     * anything per node, and every process that maps the same file shares a single
+     * physical copy of it. Nodes refer to each other by index rather than by
+     * pointer, so the layout is the same wherever it is mapped.
+     *
+     * The layout (written with `writeGraph`) is:
+     *  - a `Header`
+     *  - a `FlatNode` for every node, in breadth first order, starting with the
+     *    top level node. The sub-nodes of each GraphNode are stored together,
+     *    row by row
+     *  - the `contained_value` of every RealNode, starting at `values_offset`
+     *
+     * Everything is stored in the byte order of the machine that wrote it.
+     * Only graphs containing trivially copyable values may be mapped.
+     */
+    template<typename T>
+    class MappedGraph {
+    public:
+        // The version of the layout written by `writeGraph`
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        // The magic string at the start of every mapped graph
+        static constexpr char MAGIC[8] = "MRGMAP";
+
+        // Written in the byte order of the writing machine, so that graphs
+        // written with a different byte order can be detected
+        static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        /**
+         * The fixed size header at the start of every mapped graph
+         */
+        struct Header {
+            // Always `MAGIC`
+            char magic[8];
+
+            // The version of the layout
+            uint32_t version;
+
+            // Always `BYTE_ORDER_MARK`
+            uint32_t byte_order_mark;
+
+            // The size of each contained value, in bytes
+            uint32_t value_size;
+
+            // Unused, keeps the following members 8 byte aligned
+            uint32_t reserved;
+
+            // The scale of the top level node
+            double scale;
+
+            // The coordinates of the top level node
+            double x;
+            double y;
+
+            // The total number of nodes
+            uint64_t num_nodes;
+
+            // The number of contained values (ie. the number of RealNodes)
+            uint64_t num_values;
+
+            // The offset of the contained values from the start of the graph, in bytes
+            uint64_t values_offset;
+        };
+
+        /**
+         * A single node in a mapped graph
+         */
+        struct FlatNode {
+            // The length/width of this node in units of number of nodes
+            // (0 if this node is a RealNode)
+            uint32_t resolution;
+
+            // Unused, keeps `index` 8 byte aligned
+            uint32_t reserved;
+
+            // For a GraphNode, the index of its first sub-node. For a RealNode,
+            // the index of its contained value
+            uint64_t index;
+        };
+
+        /**
+         * A RealNode found by a query on a MappedGraph, together with where it is
+         */
+        struct Leaf {
+            // The index of the node in the mapped graph
+            uint64_t node_index;
+
+            // The coordinates of the bottom left corner of the node
+            Coordinates coordinates;
+
+            // The length/width of the node
+            double scale;
+
+            // The value contained by the node (this points into the mapped graph)
+            const T *value;
+
+            /**
+             * Gets the value contained by this node
+             * @return a reference to the object contained by this node
+             */
+            const T &containedValue() const {
+                return *value;
+            }
+        };
+
+        /**
+         * This is thrown when the data being mapped is not a valid graph
+         */
+        class InvalidGraphFormatException : public std::runtime_error {
+        public:
+            explicit InvalidGraphFormatException(const char *m) : std::runtime_error(m) {}
+        };
+
+        /**
+         * This is thrown when a graph file cannot be mapped into memory
+         */
+        class MappingFailedException : public std::runtime_error {
+        public:
+            explicit MappingFailedException(const std::string &m) : std::runtime_error(m) {}
+        };
+
+        /**
+         * Writes the given graph in the layout expected by MappedGraph
+         * @param graph the graph to write
+         * @param out the stream to write the graph to
+         */
+        static void writeGraph(GraphNode<T> &graph, std::ostream &out);
+
+        // Delete the default constructor
+        MappedGraph() = delete;
+
+        /**
+         * Maps a graph file (written with `writeGraph`) into memory, read-only
+         *
+         * Throws a MappingFailedException if the file cannot be mapped, and an
+         * InvalidGraphFormatException if the file is not a valid graph
+         * @param file_path the path to the file to map
+         */
+        explicit MappedGraph(const std::string &file_path);
+
+        /**
+         * Creates a view over a graph (written with `writeGraph`) that is already
+         * in memory. The memory is not owned by this view, and must outlive it.
+         *
+         * Throws an InvalidGraphFormatException if the memory does not hold a
+         * valid graph
+         * @param data the start of the graph, which must be 8 byte aligned
+         * @param size the size of the graph, in bytes
+         */
+        MappedGraph(const void *data, size_t size);
+
+        /**
+         * Unmaps the graph file, if this view mapped one
+         */
+        ~MappedGraph();
+
+        // Copying is not allowed, as a copy would unmap the graph file from
+        // under the original
+        MappedGraph(const MappedGraph &) = delete;
+        MappedGraph &operator=(const MappedGraph &) = delete;
+
+        /**
+         * Gets the RealNode containing the given coordinates
+         * @param coordinates the coordinates to look for a node at (coordinates
+         * outside the graph are moved to the closest point on its boundary)
+         * @return the RealNode containing the given coordinates
+         */
+        Leaf getClosestNodeToCoordinates(Coordinates coordinates) const;
+
+        /**
+         * Gets the closest RealNode to the given coordinates that passes a filter
+         * (as with GraphNode, distance is measured to the bottom left corner of
+         * each node)
+         * @param coordinates the coordinates to find a node relative to
+         * @param filter a function that takes a RealNode, and returns if it passes
+         * @return the closest node that passes the filter, if there is one
+         */
+        std::optional<Leaf> getClosestNodeToCoordinatesThatPassesFilter(
+                Coordinates coordinates, const std::function<bool(const Leaf &)> &filter) const;
+
+        /**
+         * Gets all RealNodes below nodes that pass a filter
+         * @param filter a function that takes the coordinates and scale of a
+         * node, and returns if the node (and the nodes below it) should be searched
+         * @return all RealNodes that passed the filter, as did all nodes above them
+         */
+        std::vector<Leaf> getAllNodesThatPassFilter(
+                const std::function<bool(Coordinates, double)> &filter) const;
+
+        /**
+         * Gets all RealNodes in a given area
+         * @param area the area to look for nodes in
+         * @return all RealNodes that overlap the given area
+         */
+        std::vector<Leaf> getAllNodesInArea(Area<T> &area) const;
+
+        /**
+         * Gets every RealNode in this graph
+         * @return every RealNode in this graph
+         */
+        std::vector<Leaf> getAllSubNodes() const;
+
+        /**
+         * Gets every RealNode that shares (part of) an edge with the given node
+         * @param node the node to get the neighbours of
+         * @return all RealNodes sharing an edge with the given node
+         */
+        std::vector<Leaf> getNeighbours(const Leaf &node) const;
+
+        /**
+         * Gets the coordinates of the top level node
+         * @return the coordinates of the bottom left corner of this graph
+         */
+        Coordinates getCoordinates() const;
+
+        /**
+         * Gets the scale of this graph
+         * @return the length/width of this graph
+         */
+        double getScale() const;
+
+    private:
+        /**
+         * Checks that the view is over a valid graph
+         *
+         * Throws an InvalidGraphFormatException if it is not
+         */
+        void checkGraph();
+
+        /**
+         * Recursively finds the closest RealNode below a given node that passes
+         * a filter, walking the mapped nodes in place
+         * @param node_index the index of the node to search below
+         * @param origin the coordinates of the bottom left corner of the node
+         * @param node_scale the length/width of the node
+         * @param coordinates the coordinates to find a node relative to
+         * @param filter a function that takes a RealNode, and returns if it passes
+         * @param closest_node_found the closest node found so far, replaced if a
+         * closer one is found below this node
+         * @param distance_to_closest_node_found the distance to the closest node
+         * found so far
+         */
+        void getClosestNodeToCoordinatesThatPassesFilter(
+                uint64_t node_index, Coordinates origin, double node_scale, Coordinates coordinates,
+                const std::function<bool(const Leaf &)> &filter,
+                std::optional<Leaf> &closest_node_found, double &distance_to_closest_node_found) const;
+
+        /**
+         * Recursively finds all RealNodes below a given node that pass a filter
+         * @param node_index the index of the node to search below
+         * @param origin the coordinates of the bottom left corner of the node
+         * @param node_scale the length/width of the node
+         * @param filter a function that takes the coordinates and scale of a
+         * node, and returns if the node (and the nodes below it) should be searched
+         * @param leaves the list to add all found nodes to
+         */
+        void getAllNodesThatPassFilter(
+                uint64_t node_index, Coordinates origin, double node_scale,
+                const std::function<bool(Coordinates, double)> &filter,
+                std::vector<Leaf> &leaves) const;
+
+        // The start of the graph
+        const char *data;
+
+        // The size of the graph, in bytes
+        size_t size;
+
+        // Whether `data` was mapped by this view (and so must be unmapped by it)
+        bool owns_mapping;
+
+        // The header at the start of the graph
+        const Header *header;
+
+        // Every node in the graph, in breadth first order
+        const FlatNode *nodes;
+
+        // The contained values of every RealNode
+        const T *values;
+    };
+}
+
+#include "MappedGraph.tpp"
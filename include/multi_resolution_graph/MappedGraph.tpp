@@ -0,0 +1,339 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedGraph.h"
+
+namespace multi_resolution_graph {
+
+template <typename T>
+void MappedGraph<T>::writeGraph(GraphNode<T> &graph, std::ostream &out) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only graphs of trivially copyable values can be mapped");
+
+    // Lay the nodes out breadth first, so that the sub-nodes of every
+    // GraphNode end up next to each other
+    std::vector<Node<T> *> order = {&graph};
+    std::vector<FlatNode> flat_nodes;
+    std::vector<T> values;
+    for (size_t i = 0; i < order.size(); i++) {
+        if (auto graph_node = asGraphNode(order[i])) {
+            flat_nodes.push_back({static_cast<uint32_t>(graph_node->getResolution()), 0,
+                                  order.size()});
+            for (auto &row : graph_node->getSubNodes()) {
+                for (auto &sub_node : row) {
+                    order.emplace_back(sub_node.get());
+                }
+            }
+        } else {
+            flat_nodes.push_back({0, 0, values.size()});
+            values.emplace_back(static_cast<RealNode<T> *>(order[i])->containedValue());
+        }
+    }
+
+    const uint64_t alignment = std::max<uint64_t>(8, alignof(T));
+    uint64_t nodes_end = sizeof(Header) + flat_nodes.size() * sizeof(FlatNode);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.byte_order_mark = BYTE_ORDER_MARK;
+    header.value_size = sizeof(T);
+    header.scale = graph.getScale();
+    header.x = graph.getCoordinates().x;
+    header.y = graph.getCoordinates().y;
+    header.num_nodes = flat_nodes.size();
+    header.num_values = values.size();
+    header.values_offset = (nodes_end + alignment - 1) / alignment * alignment;
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    out.write(reinterpret_cast<const char *>(flat_nodes.data()),
+              flat_nodes.size() * sizeof(FlatNode));
+    std::vector<char> padding(header.values_offset - nodes_end, 0);
+    out.write(padding.data(), padding.size());
+    out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+MappedGraph<T>::MappedGraph(const std::string &file_path) :
+    data(nullptr),
+    size(0),
+    owns_mapping(false)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only graphs of trivially copyable values can be mapped");
+
+    int file = open(file_path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw MappingFailedException("Could not open " + file_path + ": " +
+                                     std::strerror(errno));
+    }
+    struct stat file_stats;
+    if (fstat(file, &file_stats) != 0 || file_stats.st_size == 0) {
+        close(file);
+        throw MappingFailedException("Could not get the size of " + file_path);
+    }
+    size = file_stats.st_size;
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    // The mapping stays valid once the file is closed
+    close(file);
+    if (mapping == MAP_FAILED) {
+        throw MappingFailedException("Could not map " + file_path + ": " +
+                                     std::strerror(errno));
+    }
+    data = static_cast<const char *>(mapping);
+    owns_mapping = true;
+
+    try {
+        checkGraph();
+    } catch (...) {
+        munmap(const_cast<char *>(data), size);
+        throw;
+    }
+}
+
+template <typename T>
+MappedGraph<T>::MappedGraph(const void *data, size_t size) :
+    data(static_cast<const char *>(data)),
+    size(size),
+    owns_mapping(false)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only graphs of trivially copyable values can be mapped");
+    checkGraph();
+}
+
+template <typename T>
+MappedGraph<T>::~MappedGraph() {
+    if (owns_mapping) {
+        munmap(const_cast<char *>(data), size);
+    }
+}
+
+template <typename T>
+void MappedGraph<T>::checkGraph() {
+    const uint64_t alignment = std::max<uint64_t>(8, alignof(T));
+    if (reinterpret_cast<uintptr_t>(data) % alignment != 0) {
+        throw InvalidGraphFormatException("Graph data is not aligned");
+    }
+    if (size < sizeof(Header)) {
+        throw InvalidGraphFormatException("Graph data is too short to hold a header");
+    }
+
+    const Header *graph_header = reinterpret_cast<const Header *>(data);
+    if (std::memcmp(graph_header->magic, MAGIC, sizeof(graph_header->magic)) != 0) {
+        throw InvalidGraphFormatException("Data is not a mapped graph");
+    }
+    if (graph_header->version != FORMAT_VERSION) {
+        throw InvalidGraphFormatException("Unsupported graph format version");
+    }
+    if (graph_header->byte_order_mark != BYTE_ORDER_MARK) {
+        throw InvalidGraphFormatException("Graph was written with a different byte order");
+    }
+    if (graph_header->value_size != sizeof(T)) {
+        throw InvalidGraphFormatException("Graph contains values of a different size");
+    }
+
+    // Check the nodes and values fit where the header says they are
+    // (dividing rather than multiplying, so huge counts can't overflow)
+    uint64_t space_for_nodes = graph_header->values_offset - sizeof(Header);
+    if (graph_header->num_nodes == 0 ||
+        graph_header->values_offset < sizeof(Header) ||
+        graph_header->values_offset > size ||
+        graph_header->values_offset % alignment != 0 ||
+        space_for_nodes / sizeof(FlatNode) < graph_header->num_nodes ||
+        (size - graph_header->values_offset) / sizeof(T) < graph_header->num_values) {
+        throw InvalidGraphFormatException("Graph data does not match its header");
+    }
+
+    // Sub-nodes always come after their parent, so checking this is enough
+    // to know that following indices will never leave the graph or loop forever
+    const FlatNode *graph_nodes = reinterpret_cast<const FlatNode *>(data + sizeof(Header));
+    for (uint64_t i = 0; i < graph_header->num_nodes; i++) {
+        const FlatNode &node = graph_nodes[i];
+        if (node.resolution == 0) {
+            if (node.index >= graph_header->num_values) {
+                throw InvalidGraphFormatException("Graph node refers to a missing value");
+            }
+        } else if (node.index <= i || node.index > graph_header->num_nodes ||
+                   (graph_header->num_nodes - node.index) / node.resolution <
+                   node.resolution) {
+            throw InvalidGraphFormatException("Graph node refers to missing sub-nodes");
+        }
+    }
+
+    // Only keep the pointers into the graph once we know they are valid
+    header = graph_header;
+    nodes = graph_nodes;
+    values = reinterpret_cast<const T *>(data + graph_header->values_offset);
+}
+
+template <typename T>
+typename MappedGraph<T>::Leaf
+MappedGraph<T>::getClosestNodeToCoordinates(Coordinates coordinates) const {
+    uint64_t node_index = 0;
+    Coordinates node_origin = getCoordinates();
+    double node_scale = getScale();
+    while (nodes[node_index].resolution != 0) {
+        const FlatNode &node = nodes[node_index];
+        double sub_node_scale = node_scale / node.resolution;
+        auto index = [&](double position, double min) {
+            double cell = std::floor((position - min) / sub_node_scale);
+            return static_cast<unsigned int>(
+                    std::max(0.0, std::min<double>(node.resolution - 1, cell)));
+        };
+        unsigned int row = index(coordinates.y, node_origin.y);
+        unsigned int col = index(coordinates.x, node_origin.x);
+        node_scale = sub_node_scale;
+        node_origin = {node_origin.x + col * node_scale, node_origin.y + row * node_scale};
+        node_index = node.index + row * node.resolution + col;
+    }
+    return {node_index, node_origin, node_scale, &values[nodes[node_index].index]};
+}
+
+template <typename T>
+std::optional<typename MappedGraph<T>::Leaf>
+MappedGraph<T>::getClosestNodeToCoordinatesThatPassesFilter(
+        Coordinates coordinates, const std::function<bool(const Leaf &)> &filter) const {
+    std::optional<Leaf> closest_node_found;
+    double distance_to_closest_node_found = 0;
+    getClosestNodeToCoordinatesThatPassesFilter(0, getCoordinates(), getScale(), coordinates, filter,
+                                                closest_node_found, distance_to_closest_node_found);
+    return closest_node_found;
+}
+
+template <typename T>
+void MappedGraph<T>::getClosestNodeToCoordinatesThatPassesFilter(
+        uint64_t node_index, Coordinates origin, double node_scale, Coordinates coordinates,
+        const std::function<bool(const Leaf &)> &filter,
+        std::optional<Leaf> &closest_node_found, double &distance_to_closest_node_found) const {
+    // The corner of every RealNode below this node is inside it, so skip it if
+    // even the closest point in it is no closer than the closest node found
+    if (closest_node_found) {
+        double dx = std::max(0.0, std::max(origin.x - coordinates.x, coordinates.x - (origin.x + node_scale)));
+        double dy = std::max(0.0, std::max(origin.y - coordinates.y, coordinates.y - (origin.y + node_scale)));
+        if (std::hypot(dx, dy) >= distance_to_closest_node_found) {
+            return;
+        }
+    }
+
+    const FlatNode &node = nodes[node_index];
+    if (node.resolution == 0) {
+        Leaf leaf = {node_index, origin, node_scale, &values[node.index]};
+        if (!filter(leaf)) {
+            return;
+        }
+        double distance_to_leaf = distance(origin, coordinates);
+        if (!closest_node_found || distance_to_leaf < distance_to_closest_node_found) {
+            closest_node_found = leaf;
+            distance_to_closest_node_found = distance_to_leaf;
+        }
+        return;
+    }
+
+    double sub_node_scale = node_scale / node.resolution;
+    for (unsigned int row = 0; row < node.resolution; row++) {
+        for (unsigned int col = 0; col < node.resolution; col++) {
+            Coordinates sub_node_origin = {origin.x + col * sub_node_scale,
+                                           origin.y + row * sub_node_scale};
+            getClosestNodeToCoordinatesThatPassesFilter(
+                    node.index + row * node.resolution + col, sub_node_origin, sub_node_scale,
+                    coordinates, filter, closest_node_found, distance_to_closest_node_found);
+        }
+    }
+}
+
+template <typename T>
+std::vector<typename MappedGraph<T>::Leaf> MappedGraph<T>::getAllNodesThatPassFilter(
+        const std::function<bool(Coordinates, double)> &filter) const {
+    std::vector<Leaf> leaves;
+    getAllNodesThatPassFilter(0, getCoordinates(), getScale(), filter, leaves);
+    return leaves;
+}
+
+template <typename T>
+std::vector<typename MappedGraph<T>::Leaf>
+MappedGraph<T>::getAllNodesInArea(Area<T> &area) const {
+    return getAllNodesThatPassFilter([&](Coordinates node_origin, double node_scale) {
+        return area.overlapsSquare(node_origin, node_scale);
+    });
+}
+
+template <typename T>
+std::vector<typename MappedGraph<T>::Leaf> MappedGraph<T>::getAllSubNodes() const {
+    return getAllNodesThatPassFilter([](Coordinates, double) { return true; });
+}
+
+template <typename T>
+std::vector<typename MappedGraph<T>::Leaf>
+MappedGraph<T>::getNeighbours(const Leaf &node) const {
+    // Allow for a little floating point error when checking if edges touch
+    const double tolerance = getScale() * 1e-9;
+    Coordinates min = node.coordinates;
+    Coordinates max = {min.x + node.scale, min.y + node.scale};
+
+    // A node shares an edge with the given one if the two (closed) squares
+    // overlap along a line, rather than at just a corner
+    auto touches_edge = [&](Coordinates other_origin, double other_scale) {
+        double overlap_x = std::min(max.x, other_origin.x + other_scale) -
+                           std::max(min.x, other_origin.x);
+        double overlap_y = std::min(max.y, other_origin.y + other_scale) -
+                           std::max(min.y, other_origin.y);
+        return overlap_x >= -tolerance && overlap_y >= -tolerance &&
+               (overlap_x > tolerance || overlap_y > tolerance);
+    };
+
+    std::vector<Leaf> neighbours;
+    for (const Leaf &leaf : getAllNodesThatPassFilter(touches_edge)) {
+        if (leaf.node_index != node.node_index) {
+            neighbours.emplace_back(leaf);
+        }
+    }
+    return neighbours;
+}
+
+template <typename T>
+Coordinates MappedGraph<T>::getCoordinates() const {
+    return {header->x, header->y};
+}
+
+template <typename T>
+double MappedGraph<T>::getScale() const {
+    return header->scale;
+}
+
+template <typename T>
+void MappedGraph<T>::getAllNodesThatPassFilter(
+        uint64_t node_index, Coordinates origin, double node_scale,
+        const std::function<bool(Coordinates, double)> &filter,
+        std::vector<Leaf> &leaves) const {
+    if (!filter(origin, node_scale)) {
+        return;
+    }
+    const FlatNode &node = nodes[node_index];
+    if (node.resolution == 0) {
+        leaves.push_back({node_index, origin, node_scale, &values[node.index]});
+        return;
+    }
+
+    double sub_node_scale = node_scale / node.resolution;
+    for (unsigned int row = 0; row < node.resolution; row++) {
+        for (unsigned int col = 0; col < node.resolution; col++) {
+            Coordinates sub_node_origin = {origin.x + col * sub_node_scale,
+                                           origin.y + row * sub_node_scale};
+            getAllNodesThatPassFilter(node.index + row * node.resolution + col,
+                                      sub_node_origin, sub_node_scale, filter, leaves);
+        }
+    }
+}
+
+}
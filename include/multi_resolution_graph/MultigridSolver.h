@@ -0,0 +1,221 @@
+#pragma once
+
+// C++ STD Includes
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "FiniteVolumeStencil.h"
+#include "GraphNode.h"
+#include "ValueLayers.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Solves Poisson problems (`-laplacian(u) = f`, with `u = 0` along the edges
+     * of the graph) over the RealNodes of a graph with geometric multigrid,
+     * using the GraphNode hierarchy of the graph as the coarse grids
+     *
+     * The finest level is the RealNodes themselves, discretized with the faces
+     * of a FiniteVolumeStencil. Each coarser level cuts the graph one depth
+     * higher: every GraphNode at that depth becomes a single cell covering all
+     * of its sub nodes, and every RealNode above that depth stays as it is. The
+     * faces of a coarse cell are the faces of the RealNodes in it that cross
+     * over to a different cell, so no extra neighbour searches are needed.
+     *
+     * A V-cycle smooths with weighted Jacobi (run in parallel with OpenMP),
+     * restricts the residual to the next level by summing it over each coarse
+     * cell, solves for a correction there, and adds the correction back to
+     * every cell inside each coarse cell. After the layout of the graph changes,
+     * `update` must be called.
+     *
+     * @tparam T the type of value contained by the RealNodes of the graph
+     * @tparam V the type of value stored in each layer
+     */
+    template<typename T, typename V = double>
+    class MultigridSolver {
+    public:
+        // Delete the default constructor
+        MultigridSolver() = delete;
+
+        /**
+         * Creates a MultigridSolver for the faces of the given stencil, and
+         * builds every level
+         * @param stencil the faces of the RealNodes to solve over (must outlive this object)
+         */
+        explicit MultigridSolver(FiniteVolumeStencil<T, V> &stencil);
+
+        /**
+         * Builds every level again after the layout of the graph changed. The
+         * stencil must be updated first (see `FiniteVolumeStencil::update`).
+         */
+        void update();
+
+        /**
+         * Sets the number of smoothing steps taken on each level before and
+         * after the correction from the next level (default is 2 and 2)
+         * @param num_pre_smoothing_steps the number of steps before the correction
+         * @param num_post_smoothing_steps the number of steps after the correction
+         */
+        void setNumSmoothingSteps(unsigned int num_pre_smoothing_steps, unsigned int num_post_smoothing_steps);
+
+        /**
+         * Sets the weight of each Jacobi step, for both smoothing and
+         * `solveWithJacobi` (default is 0.8)
+         * @param weight the weight of each step, between 0 and 1
+         */
+        void setJacobiWeight(double weight);
+
+        /**
+         * Gets the number of levels, including the finest
+         * @return the number of levels
+         */
+        size_t getNumLevels() const;
+
+        /**
+         * Gets the number of cells in a level
+         * @param level the level, where 0 is the finest
+         * @return the number of cells in the level
+         */
+        size_t getNumCells(size_t level) const;
+
+        /**
+         * Solves with V-cycles until the residual drops below a fraction of the
+         * right hand side, starting from the values already in the solution layer
+         * @param solution the index of the layer to solve for
+         * @param source the index of the layer holding `f`
+         * @param tolerance the largest allowed ratio between the norm of the
+         * residual and the norm of the (area weighted) right hand side
+         * @param max_num_cycles the largest number of V-cycles to run
+         * @return the number of V-cycles run
+         */
+        unsigned int solve(size_t solution, size_t source, double tolerance, unsigned int max_num_cycles);
+
+        /**
+         * Runs a single V-cycle, improving the values in the solution layer
+         * @param solution the index of the layer to solve for
+         * @param source the index of the layer holding `f`
+         */
+        void vCycle(size_t solution, size_t source);
+
+        /**
+         * Solves with weighted Jacobi steps on the finest level alone, which is
+         * much slower than `solve` but useful for comparison
+         * @param solution the index of the layer to solve for
+         * @param source the index of the layer holding `f`
+         * @param tolerance the largest allowed ratio between the norm of the
+         * residual and the norm of the (area weighted) right hand side
+         * @param max_num_iterations the largest number of steps to take
+         * @return the number of steps taken
+         */
+        unsigned int solveWithJacobi(size_t solution, size_t source, double tolerance,
+                                     unsigned int max_num_iterations);
+
+        /**
+         * Gets the ratio between the norm of the residual and the norm of the
+         * (area weighted) right hand side
+         * @param solution the index of the layer holding the solution
+         * @param source the index of the layer holding `f`
+         * @return the relative norm of the residual, or the norm of the residual
+         * if the right hand side is 0
+         */
+        double getRelativeResidual(size_t solution, size_t source);
+
+    private:
+        // The number of smoothing steps taken on the coarsest level, which is
+        // small enough for this to be close to an exact solve
+        static constexpr unsigned int NUM_COARSEST_SMOOTHING_STEPS = 50;
+
+        // The linear system on one level, in compressed sparse row form, with
+        // the buffers used while cycling
+        struct Level {
+            // The index of the first off diagonal entry of every cell, plus
+            // the total number of entries
+            std::vector<size_t> offsets;
+
+            // The cell on the other side of every off diagonal entry
+            std::vector<size_t> neighbours;
+
+            // The weight (face length over distance) of every off diagonal entry
+            std::vector<double> weights;
+
+            // The diagonal entry of every cell, including its faces on the
+            // edges of the graph
+            std::vector<double> diagonal;
+
+            // The cell in the next coarser level that contains every cell
+            std::vector<size_t> coarse_cells;
+
+            // The solution, right hand side, and scratch space
+            std::vector<double> solution;
+            std::vector<double> rhs;
+            std::vector<double> scratch;
+        };
+
+        /**
+         * Finds the ancestors of every RealNode under a GraphNode
+         * @param graph_node the GraphNode to search under
+         * @param path the ancestors of the GraphNode, followed by the GraphNode itself
+         * @param ancestors the ancestors of every RealNode by leaf id, with the
+         * RealNode itself at the end
+         */
+        static void findAncestors(GraphNode<T> &graph_node, std::vector<Node<T> *> &path,
+                                  std::vector<std::vector<Node<T> *>> &ancestors);
+
+        /**
+         * Fills in the linear system of a level from the faces of the RealNodes
+         * @param level the level to fill in
+         * @param leaf_cells the cell containing every RealNode, by leaf id
+         * @param cell_scales the scale of every cell
+         */
+        void buildLevel(Level &level, const std::vector<size_t> &leaf_cells,
+                        const std::vector<double> &cell_scales) const;
+
+        /**
+         * Takes weighted Jacobi steps on a level
+         * @param level the level to smooth
+         * @param num_steps the number of steps to take
+         */
+        void smooth(Level &level, unsigned int num_steps) const;
+
+        /**
+         * Computes `rhs - A * solution` on a level into its scratch space
+         * @param level the level to compute the residual of
+         * @return the norm of the residual
+         */
+        static double computeResidual(Level &level);
+
+        /**
+         * Runs a V-cycle starting from a given level, with its right hand side
+         * and initial solution already set
+         * @param level_index the level to start from
+         */
+        void vCycle(size_t level_index);
+
+        /**
+         * Copies the right hand side and solution out of their layers into the
+         * finest level
+         * @param solution the index of the layer holding the solution
+         * @param source the index of the layer holding `f`
+         * @return the norm of the right hand side
+         */
+        double loadFinestLevel(size_t solution, size_t source);
+
+        // The faces of the RealNodes
+        FiniteVolumeStencil<T, V> &stencil;
+
+        // Every level, from finest to coarsest
+        std::vector<Level> levels;
+
+        // The number of smoothing steps before the correction from the next level
+        unsigned int num_pre_smoothing_steps;
+
+        // The number of smoothing steps after the correction from the next level
+        unsigned int num_post_smoothing_steps;
+
+        // The weight of each Jacobi step
+        double jacobi_weight;
+    };
+}
+
+#include "MultigridSolver.tpp"
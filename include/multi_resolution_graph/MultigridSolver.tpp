@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "MultigridSolver.h"
+
+namespace multi_resolution_graph {
+
+template <typename T, typename V>
+MultigridSolver<T, V>::MultigridSolver(FiniteVolumeStencil<T, V> &stencil) :
+    stencil(stencil),
+    num_pre_smoothing_steps(2),
+    num_post_smoothing_steps(2),
+    jacobi_weight(0.8)
+{
+    update();
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::update() {
+    const std::vector<std::shared_ptr<RealNode<T>>> &leaves = stencil.getValueLayers().getLeaves();
+    const size_t num_leaves = leaves.size();
+
+    std::vector<std::vector<Node<T> *>> ancestors(num_leaves);
+    std::vector<Node<T> *> path = {&stencil.getValueLayers().getGraph()};
+    findAncestors(stencil.getValueLayers().getGraph(), path, ancestors);
+    size_t max_depth = 0;
+    for (auto& leaf_ancestors : ancestors) {
+        max_depth = std::max(max_depth, leaf_ancestors.size() - 1);
+    }
+
+    // The finest level is just the RealNodes
+    levels.clear();
+    levels.emplace_back();
+    std::vector<size_t> leaf_cells(num_leaves);
+    std::vector<double> cell_scales(num_leaves);
+    for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+        leaf_cells[leaf] = leaf;
+        cell_scales[leaf] = leaves[leaf]->getScale();
+    }
+    buildLevel(levels.back(), leaf_cells, cell_scales);
+
+    // Each coarser level cuts the graph one depth higher, down to the whole
+    // graph as a single cell
+    for (size_t depth = max_depth; depth-- > 0;) {
+        std::unordered_map<Node<T> *, size_t> cell_ids;
+        std::vector<size_t> coarse_leaf_cells(num_leaves);
+        std::vector<double> coarse_cell_scales;
+        for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+            Node<T> *cell = ancestors[leaf][std::min(depth, ancestors[leaf].size() - 1)];
+            auto inserted = cell_ids.insert({cell, cell_ids.size()});
+            if (inserted.second) {
+                coarse_cell_scales.push_back(cell->getScale());
+            }
+            coarse_leaf_cells[leaf] = inserted.first->second;
+        }
+        if (coarse_cell_scales.size() == cell_scales.size()) {
+            // Only GraphNodes with a resolution of 1 were cut, so this level
+            // would be the same as the last one
+            continue;
+        }
+
+        Level &fine_level = levels.back();
+        fine_level.coarse_cells.resize(cell_scales.size());
+        for (size_t leaf = 0; leaf < num_leaves; leaf++) {
+            fine_level.coarse_cells[leaf_cells[leaf]] = coarse_leaf_cells[leaf];
+        }
+        levels.emplace_back();
+        buildLevel(levels.back(), coarse_leaf_cells, coarse_cell_scales);
+        leaf_cells = std::move(coarse_leaf_cells);
+        cell_scales = std::move(coarse_cell_scales);
+    }
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::setNumSmoothingSteps(unsigned int num_pre_smoothing_steps,
+                                                 unsigned int num_post_smoothing_steps) {
+    this->num_pre_smoothing_steps = num_pre_smoothing_steps;
+    this->num_post_smoothing_steps = num_post_smoothing_steps;
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::setJacobiWeight(double weight) {
+    jacobi_weight = weight;
+}
+
+template <typename T, typename V>
+size_t MultigridSolver<T, V>::getNumLevels() const {
+    return levels.size();
+}
+
+template <typename T, typename V>
+size_t MultigridSolver<T, V>::getNumCells(size_t level) const {
+    return levels[level].diagonal.size();
+}
+
+template <typename T, typename V>
+unsigned int MultigridSolver<T, V>::solve(size_t solution, size_t source, double tolerance,
+                                          unsigned int max_num_cycles) {
+    double rhs_norm = loadFinestLevel(solution, source);
+    double target = tolerance * (rhs_norm > 0 ? rhs_norm : 1);
+    unsigned int num_cycles = 0;
+    while (num_cycles < max_num_cycles && computeResidual(levels[0]) > target) {
+        vCycle(0);
+        num_cycles++;
+    }
+
+    std::vector<V> &solution_values = stencil.getValueLayers().getLayer(solution);
+    std::copy(levels[0].solution.begin(), levels[0].solution.end(), solution_values.begin());
+    return num_cycles;
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::vCycle(size_t solution, size_t source) {
+    loadFinestLevel(solution, source);
+    vCycle(0);
+    std::vector<V> &solution_values = stencil.getValueLayers().getLayer(solution);
+    std::copy(levels[0].solution.begin(), levels[0].solution.end(), solution_values.begin());
+}
+
+template <typename T, typename V>
+unsigned int MultigridSolver<T, V>::solveWithJacobi(size_t solution, size_t source, double tolerance,
+                                                    unsigned int max_num_iterations) {
+    double rhs_norm = loadFinestLevel(solution, source);
+    double target = tolerance * (rhs_norm > 0 ? rhs_norm : 1);
+    unsigned int num_iterations = 0;
+    while (num_iterations < max_num_iterations && computeResidual(levels[0]) > target) {
+        smooth(levels[0], 1);
+        num_iterations++;
+    }
+
+    std::vector<V> &solution_values = stencil.getValueLayers().getLayer(solution);
+    std::copy(levels[0].solution.begin(), levels[0].solution.end(), solution_values.begin());
+    return num_iterations;
+}
+
+template <typename T, typename V>
+double MultigridSolver<T, V>::getRelativeResidual(size_t solution, size_t source) {
+    double rhs_norm = loadFinestLevel(solution, source);
+    double residual_norm = computeResidual(levels[0]);
+    return rhs_norm > 0 ? residual_norm / rhs_norm : residual_norm;
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::findAncestors(GraphNode<T> &graph_node, std::vector<Node<T> *> &path,
+                                          std::vector<std::vector<Node<T> *>> &ancestors) {
+    for (auto& row : graph_node.getSubNodes()) {
+        for (auto& sub_node : row) {
+            path.push_back(sub_node.get());
+            GraphNode<T> *sub_graph_node = asGraphNode(sub_node.get());
+            if (sub_graph_node) {
+                findAncestors(*sub_graph_node, path, ancestors);
+            } else {
+                ancestors[static_cast<RealNode<T> *>(sub_node.get())->getLeafId()] = path;
+            }
+            path.pop_back();
+        }
+    }
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::buildLevel(Level &level, const std::vector<size_t> &leaf_cells,
+                                       const std::vector<double> &cell_scales) const {
+    const size_t num_cells = cell_scales.size();
+    const std::vector<size_t> &face_offsets = stencil.getFaceOffsets();
+    const std::vector<size_t> &face_neighbours = stencil.getFaceNeighbours();
+    const std::vector<double> &face_lengths = stencil.getFaceLengths();
+
+    // Gather the faces of the RealNodes that cross between cells
+    std::vector<std::vector<std::pair<size_t, double>>> cell_faces(num_cells);
+    for (size_t leaf = 0; leaf + 1 < face_offsets.size(); leaf++) {
+        size_t cell = leaf_cells[leaf];
+        for (size_t face = face_offsets[leaf]; face < face_offsets[leaf + 1]; face++) {
+            size_t neighbour_cell = leaf_cells[face_neighbours[face]];
+            if (neighbour_cell != cell) {
+                cell_faces[cell].push_back({neighbour_cell, face_lengths[face]});
+            }
+        }
+    }
+
+    // Merge the faces between each pair of cells into one entry
+    level.offsets.assign(num_cells + 1, 0);
+    level.neighbours.clear();
+    level.weights.clear();
+    level.diagonal.assign(num_cells, 0);
+    for (size_t cell = 0; cell < num_cells; cell++) {
+        std::vector<std::pair<size_t, double>> &faces = cell_faces[cell];
+        std::sort(faces.begin(), faces.end());
+        double scale = cell_scales[cell];
+        double boundary_length = 4 * scale;
+        for (size_t i = 0; i < faces.size();) {
+            size_t neighbour_cell = faces[i].first;
+            double length = 0;
+            for (; i < faces.size() && faces[i].first == neighbour_cell; i++) {
+                length += faces[i].second;
+            }
+            double weight = length / ((scale + cell_scales[neighbour_cell]) / 2);
+            level.neighbours.push_back(neighbour_cell);
+            level.weights.push_back(weight);
+            level.diagonal[cell] += weight;
+            boundary_length -= length;
+        }
+        // Whatever is left of the perimeter lies on the edge of the graph,
+        // half a cell away from the boundary value
+        if (boundary_length > 1e-9 * scale) {
+            level.diagonal[cell] += boundary_length / (scale / 2);
+        }
+        level.offsets[cell + 1] = level.neighbours.size();
+    }
+
+    level.coarse_cells.clear();
+    level.solution.assign(num_cells, 0);
+    level.rhs.assign(num_cells, 0);
+    level.scratch.assign(num_cells, 0);
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::smooth(Level &level, unsigned int num_steps) const {
+    const size_t num_cells = level.diagonal.size();
+    const size_t *offsets = level.offsets.data();
+    const size_t *neighbours = level.neighbours.data();
+    const double *weights = level.weights.data();
+    const double *diagonal = level.diagonal.data();
+    const double *rhs = level.rhs.data();
+    const double weight = jacobi_weight;
+    for (unsigned int step = 0; step < num_steps; step++) {
+        const double *solution = level.solution.data();
+        double *new_solution = level.scratch.data();
+        #pragma omp parallel for schedule(static)
+        for (size_t cell = 0; cell < num_cells; cell++) {
+            double residual = rhs[cell] - diagonal[cell] * solution[cell];
+            for (size_t entry = offsets[cell]; entry < offsets[cell + 1]; entry++) {
+                residual += weights[entry] * solution[neighbours[entry]];
+            }
+            new_solution[cell] = solution[cell] + weight * residual / diagonal[cell];
+        }
+        std::swap(level.solution, level.scratch);
+    }
+}
+
+template <typename T, typename V>
+double MultigridSolver<T, V>::computeResidual(Level &level) {
+    const size_t num_cells = level.diagonal.size();
+    const size_t *offsets = level.offsets.data();
+    const size_t *neighbours = level.neighbours.data();
+    const double *weights = level.weights.data();
+    const double *diagonal = level.diagonal.data();
+    const double *rhs = level.rhs.data();
+    const double *solution = level.solution.data();
+    double *residuals = level.scratch.data();
+    double sum_of_squares = 0;
+    #pragma omp parallel for schedule(static) reduction(+:sum_of_squares)
+    for (size_t cell = 0; cell < num_cells; cell++) {
+        double residual = rhs[cell] - diagonal[cell] * solution[cell];
+        for (size_t entry = offsets[cell]; entry < offsets[cell + 1]; entry++) {
+            residual += weights[entry] * solution[neighbours[entry]];
+        }
+        residuals[cell] = residual;
+        sum_of_squares += residual * residual;
+    }
+    return std::sqrt(sum_of_squares);
+}
+
+template <typename T, typename V>
+void MultigridSolver<T, V>::vCycle(size_t level_index) {
+    Level &level = levels[level_index];
+    if (level_index + 1 == levels.size()) {
+        smooth(level, NUM_COARSEST_SMOOTHING_STEPS);
+        return;
+    }
+
+    smooth(level, num_pre_smoothing_steps);
+
+    // Restrict the residual by summing it over each coarse cell, since the
+    // right hand side is already integrated over the area of each cell
+    computeResidual(level);
+    Level &coarse_level = levels[level_index + 1];
+    std::fill(coarse_level.rhs.begin(), coarse_level.rhs.end(), 0);
+    std::fill(coarse_level.solution.begin(), coarse_level.solution.end(), 0);
+    const size_t num_cells = level.diagonal.size();
+    for (size_t cell = 0; cell < num_cells; cell++) {
+        coarse_level.rhs[level.coarse_cells[cell]] += level.scratch[cell];
+    }
+
+    vCycle(level_index + 1);
+
+    // Add the correction to every cell inside each coarse cell
+    const size_t *coarse_cells = level.coarse_cells.data();
+    const double *correction = coarse_level.solution.data();
+    double *solution = level.solution.data();
+    #pragma omp parallel for schedule(static)
+    for (size_t cell = 0; cell < num_cells; cell++) {
+        solution[cell] += correction[coarse_cells[cell]];
+    }
+
+    smooth(level, num_post_smoothing_steps);
+}
+
+template <typename T, typename V>
+double MultigridSolver<T, V>::loadFinestLevel(size_t solution, size_t source) {
+    Level &level = levels[0];
+    const std::vector<V> &solution_values = stencil.getValueLayers().getLayer(solution);
+    const std::vector<V> &source_values = stencil.getValueLayers().getLayer(source);
+    const std::vector<double> &areas = stencil.getAreas();
+    const size_t num_cells = level.diagonal.size();
+    double sum_of_squares = 0;
+    #pragma omp parallel for schedule(static) reduction(+:sum_of_squares)
+    for (size_t cell = 0; cell < num_cells; cell++) {
+        level.solution[cell] = solution_values[cell];
+        level.rhs[cell] = source_values[cell] * areas[cell];
+        sum_of_squares += level.rhs[cell] * level.rhs[cell];
+    }
+    return std::sqrt(sum_of_squares);
+}
+
+}
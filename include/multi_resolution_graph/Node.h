@@ -3,7 +3,9 @@
 // C++ STD Includes
 #include <vector>
 #include <memory>
+#include <optional>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 
 namespace multi_resolution_graph {
@@ -23,6 +25,14 @@ namespace multi_resolution_graph {
         return c1.x == c2.x && c1.y == c2.y;
     }
 
+    /**
+     * The kinds of node a graph is made of (see `Node::getNodeType`)
+     */
+    enum class NodeType : uint8_t {
+        GRAPH_NODE,
+        REAL_NODE
+    };
+
     // We need to forward declare these here so that we can use it in
     // in the "Node" class
     template<typename T>
@@ -90,6 +100,12 @@ namespace multi_resolution_graph {
          */
         virtual Coordinates getCoordinates() = 0;
 
+        /**
+         * Gets the coordinates of the center of this node
+         * @return the coordinates of the center of this node
+         */
+        Coordinates getCenterCoordinates();
+
         /**
          * Gets the scale of this node
          * @return the length/width of this node
@@ -103,6 +119,27 @@ namespace multi_resolution_graph {
          * @return a vector of all RealNode's at or below this one
          */
         virtual std::vector<std::shared_ptr<RealNode<T>>> getAllSubNodes() = 0;
+
+        /**
+         * Gets the kind of node this is. Traversals switch on this and
+         * `static_cast` to the concrete node type, instead of going through
+         * the virtual functions above or using `dynamic_cast`.
+         * @return the kind of node this is
+         */
+        NodeType getNodeType() const {
+            return node_type;
+        }
+
+    protected:
+        /**
+         * Create a node of the given kind
+         * @param node_type the kind of node being created
+         */
+        explicit Node(NodeType node_type) : node_type(node_type) {}
+
+    private:
+        // The kind of node this is
+        NodeType node_type;
     };
 
 }
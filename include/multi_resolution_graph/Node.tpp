@@ -11,4 +11,12 @@ namespace multi_resolution_graph {
         return this->getAllNodesThatPassFilter(filter, true, false);
     }
 
+    template<typename T>
+    Coordinates Node<T>::getCenterCoordinates() {
+        // Our coordinates are those of our bottom left corner
+        Coordinates coordinates = this->getCoordinates();
+        double half_scale = this->getScale() / 2;
+        return {coordinates.x + half_scale, coordinates.y + half_scale};
+    }
+
 }
@@ -0,0 +1,65 @@
+#pragma once
+
+// C++ STD Includes
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "GraphNode.h"
+#include "RealNode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Removes redundant waypoints from paths through a graph
+     *
+     * Paths found over the centers of the RealNodes in a graph tend to zig-zag
+     * along the grid. This "pulls the string" tight by skipping any waypoints
+     * that can be cut straight past without crossing a blocked node.
+     */
+    template<typename T>
+    class PathSmoother {
+    public:
+        // Delete the default constructor
+        PathSmoother() = delete;
+
+        /**
+         * Creates a PathSmoother for paths through the given graph
+         * @param graph the graph that paths to be smoothed lie in
+         * @param is_blocked a function that takes the value contained by a node,
+         * and returns if that node blocks line of sight
+         */
+        PathSmoother(std::shared_ptr<GraphNode<T>> graph,
+                     std::function<bool(T &)> is_blocked);
+
+        /**
+         * Removes redundant waypoints from the given path
+         *
+         * This works greedily, keeping a waypoint only when the last kept
+         * waypoint cannot see the waypoint after it
+         *
+         * @param path a path through the graph, as a list of RealNodes whose
+         * centers are the waypoints of the path
+         * @return the given path with all redundant waypoints removed (the first
+         * and last nodes of the path are always kept)
+         */
+        std::vector<std::shared_ptr<RealNode<T>>>
+        smoothPath(const std::vector<std::shared_ptr<RealNode<T>>> &path);
+
+        /**
+         * Checks if there is a clear line of sight between two points
+         * @param start the point to look from
+         * @param end the point to look at
+         * @return if no node crossed by the line from `start` to `end` is blocked
+         */
+        bool hasLineOfSight(Coordinates start, Coordinates end);
+
+    private:
+        // The graph that paths to be smoothed lie in
+        std::shared_ptr<GraphNode<T>> graph;
+
+        // A function that returns if a node with a given value blocks line of sight
+        std::function<bool(T &)> is_blocked;
+    };
+}
+
+#include "PathSmoother.tpp"
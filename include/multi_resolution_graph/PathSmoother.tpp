@@ -0,0 +1,52 @@
+#pragma once
+
+#include "PathSmoother.h"
+
+namespace multi_resolution_graph {
+
+template<typename T>
+PathSmoother<T>::PathSmoother(std::shared_ptr<GraphNode<T>> graph,
+                              std::function<bool(T &)> is_blocked) :
+        graph(std::move(graph)),
+        is_blocked(std::move(is_blocked)) {}
+
+template<typename T>
+std::vector<std::shared_ptr<RealNode<T>>>
+PathSmoother<T>::smoothPath(const std::vector<std::shared_ptr<RealNode<T>>> &path) {
+    // With two or fewer waypoints there's nothing we could remove
+    if (path.size() <= 2) {
+        return path;
+    }
+
+    std::vector<std::shared_ptr<RealNode<T>>> smoothed_path = {path.front()};
+    size_t anchor = 0;
+    Coordinates anchor_coordinates = path[anchor]->getCenterCoordinates();
+    for (size_t i = 2; i < path.size(); i++) {
+        // Keep skipping waypoints for as long as we can see past them
+        if (hasLineOfSight(anchor_coordinates, path[i]->getCenterCoordinates())) {
+            continue;
+        }
+
+        // We can't see this waypoint, so we need to keep the one before it. If
+        // that's the anchor itself, the path must go through this waypoint
+        anchor = (i - 1 > anchor) ? i - 1 : i;
+        anchor_coordinates = path[anchor]->getCenterCoordinates();
+        smoothed_path.emplace_back(path[anchor]);
+    }
+
+    if (smoothed_path.back() != path.back()) {
+        smoothed_path.emplace_back(path.back());
+    }
+    return smoothed_path;
+}
+
+template<typename T>
+bool PathSmoother<T>::hasLineOfSight(Coordinates start, Coordinates end) {
+    // The traversal stops at the first blocked node, so we only need to check
+    // the last node it crossed
+    std::vector<std::shared_ptr<RealNode<T>>> crossed_nodes =
+            graph->getAllNodesAlongLine(start, end, is_blocked);
+    return crossed_nodes.empty() || !is_blocked(crossed_nodes.back()->containedValue());
+}
+
+}
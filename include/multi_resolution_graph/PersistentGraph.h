@@ -0,0 +1,207 @@
+#pragma once
+
+// C++ STD Includes
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "GraphNode.h"
+#include "Area.h"
+
+namespace multi_resolution_graph {
+    /**
+     * An immutable snapshot of a graph
+     *
+     * Modifying a PersistentGraph never changes it, but instead gives a new
+     * version of the graph. The new version shares every subtree that was not
+     * touched by the modification with the old one, so modifications only cost
+     * as much as the depth of the modified node, and any number of versions can
+     * be kept around cheaply. Since no version ever changes, any number of
+     * threads may query a version concurrently without locking.
+     *
+     * Nodes are only kept alive by the versions (and query results) that
+     * reference them, so nodes that are only part of old versions are freed
+     * once the last reference to those versions is dropped.
+     */
+    template<typename T>
+    class PersistentGraph {
+    public:
+        /**
+         * A single node in a PersistentGraph, which may be shared between versions
+         */
+        struct PersistentNode {
+            // The length/width of this node in units of number of nodes
+            // (0 if this node has no sub-nodes, ie. is equivalent to a RealNode)
+            unsigned int resolution;
+
+            // The value this node contains (only meaningful if this node
+            // has no sub-nodes)
+            T contained_value;
+
+            // Nodes located below this one, stored in the form
+            // sub_nodes[row * resolution + col]
+            std::vector<std::shared_ptr<const PersistentNode>> sub_nodes;
+        };
+
+        /**
+         * A node with no sub-nodes found by a query on a PersistentGraph,
+         * together with where it is
+         */
+        struct Leaf {
+            // The node itself (this keeps the node alive, even if every
+            // version containing it is dropped)
+            std::shared_ptr<const PersistentNode> node;
+
+            // The coordinates of the bottom left corner of the node
+            Coordinates coordinates;
+
+            // The length/width of the node
+            double scale;
+
+            /**
+             * Gets the value contained by this node
+             * @return a reference to the object contained by this node
+             */
+            const T &containedValue() const {
+                return node->contained_value;
+            }
+        };
+
+        // Delete the default constructor
+        PersistentGraph() = delete;
+
+        /**
+         * Creates a PersistentGraph with the same layout and values as the
+         * given graph
+         * @param graph the graph to copy
+         */
+        explicit PersistentGraph(GraphNode<T> &graph);
+
+        /**
+         * Gets the node containing the given coordinates
+         * @param coordinates the coordinates to look for a node at (coordinates
+         * outside the graph are moved to the closest point on its boundary)
+         * @return the node containing the given coordinates
+         */
+        Leaf getNodeAtCoordinates(Coordinates coordinates) const;
+
+        /**
+         * Gets all nodes (that have no sub-nodes) in a given area
+         * @param area the area to look for nodes in
+         * @return all nodes that overlap the given area
+         */
+        std::vector<Leaf> getAllNodesInArea(Area<T> &area) const;
+
+        /**
+         * Gets all the nodes in this graph that have no sub-nodes
+         * @return all the nodes in this graph that have no sub-nodes
+         */
+        std::vector<Leaf> getAllSubNodes() const;
+
+        /**
+         * Creates a new version of this graph with the value of the node at the
+         * given coordinates changed. This graph is left unchanged.
+         * @param coordinates the coordinates of the node to change the value of
+         * @param value the new value for the node
+         * @return a new version of this graph, with the value changed
+         */
+        [[nodiscard]] PersistentGraph setValueAtCoordinates(Coordinates coordinates,
+                                                            T value) const;
+
+        /**
+         * Creates a new version of this graph with the node at the given
+         * coordinates split into `resolution x resolution` nodes. This graph is
+         * left unchanged.
+         * @param coordinates the coordinates of the node to split
+         * @param resolution the resolution to split the node into
+         * @return a new version of this graph, with the node split
+         */
+        [[nodiscard]] PersistentGraph changeResolutionOfNodeAtCoordinates(
+                Coordinates coordinates, unsigned int resolution) const;
+
+        /**
+         * Gets the top level node of this graph
+         * @return the top level node of this graph
+         */
+        std::shared_ptr<const PersistentNode> getRootNode() const;
+
+        /**
+         * Gets the scale of this graph
+         * @return the length/width of this graph
+         */
+        double getScale() const;
+
+    private:
+        /**
+         * Creates a PersistentGraph from a given top level node
+         * @param root the top level node of the graph
+         * @param origin the coordinates of the bottom left corner of the graph
+         * @param scale the length/width of the graph
+         */
+        PersistentGraph(std::shared_ptr<const PersistentNode> root,
+                        Coordinates origin, double scale);
+
+        /**
+         * Recursively copies a node in a GraphNode graph
+         * @param node the node to copy
+         * @return a copy of the given node, and all nodes below it
+         */
+        static std::shared_ptr<const PersistentNode> copyNode(Node<T> &node);
+
+        /**
+         * Creates a copy of the path from the given node down to the node with
+         * no sub-nodes at the given coordinates, with that node replaced
+         * @param node the node to start at
+         * @param origin the coordinates of the bottom left corner of `node`
+         * @param node_scale the length/width of `node`
+         * @param coordinates the coordinates of the node to replace
+         * @param replace a function that takes the node to replace and
+         * returns the node to replace it with
+         * @return a copy of `node` with the node at the given coordinates replaced
+         */
+        static std::shared_ptr<const PersistentNode> replaceNodeAtCoordinates(
+                const std::shared_ptr<const PersistentNode> &node,
+                Coordinates origin, double node_scale, Coordinates coordinates,
+                const std::function<std::shared_ptr<const PersistentNode>(
+                        const PersistentNode &)> &replace);
+
+        /**
+         * Gets the index of the sub-node of a node containing some coordinates
+         * @param node the node to look in
+         * @param origin the coordinates of the bottom left corner of `node`
+         * @param node_scale the length/width of `node`
+         * @param coordinates the coordinates to look for
+         * @return the row and column of the sub-node containing the coordinates
+         */
+        static std::pair<unsigned int, unsigned int> getSubNodeIndex(
+                const PersistentNode &node, Coordinates origin,
+                double node_scale, Coordinates coordinates);
+
+        /**
+         * Recursively finds all nodes (that have no sub-nodes) below a given
+         * node that pass a filter
+         * @param node the node to search below
+         * @param origin the coordinates of the bottom left corner of `node`
+         * @param node_scale the length/width of `node`
+         * @param filter a function that takes the coordinates and scale of a
+         * node, and returns if the node (and the nodes below it) should be searched
+         * @param leaves the list to add all found nodes to
+         */
+        static void getAllNodesThatPassFilter(
+                const std::shared_ptr<const PersistentNode> &node,
+                Coordinates origin, double node_scale,
+                const std::function<bool(Coordinates, double)> &filter,
+                std::vector<Leaf> &leaves);
+
+        // The top level node of this graph
+        std::shared_ptr<const PersistentNode> root;
+
+        // The coordinates of the bottom left corner of this graph
+        Coordinates origin;
+
+        // The length/width of this graph
+        double scale;
+    };
+}
+
+#include "PersistentGraph.tpp"
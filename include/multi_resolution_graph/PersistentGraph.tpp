@@ -0,0 +1,181 @@
+#pragma once
+
+// C++ STD Includes
+#include <algorithm>
+#include <cmath>
+
+#include "PersistentGraph.h"
+
+namespace multi_resolution_graph {
+
+template<typename T>
+PersistentGraph<T>::PersistentGraph(GraphNode<T> &graph) :
+        PersistentGraph(copyNode(graph), graph.getCoordinates(), graph.getScale()) {}
+
+template<typename T>
+PersistentGraph<T>::PersistentGraph(std::shared_ptr<const PersistentNode> root,
+                                    Coordinates origin, double scale) :
+        root(std::move(root)),
+        origin(origin),
+        scale(scale) {}
+
+template<typename T>
+std::shared_ptr<const typename PersistentGraph<T>::PersistentNode>
+PersistentGraph<T>::copyNode(Node<T> &node) {
+    auto persistent_node = std::make_shared<PersistentNode>();
+    if (auto graph_node = asGraphNode(&node)) {
+        persistent_node->resolution = graph_node->getResolution();
+        for (auto &row : graph_node->getSubNodes()) {
+            for (auto &sub_node : row) {
+                persistent_node->sub_nodes.emplace_back(copyNode(*sub_node));
+            }
+        }
+    } else {
+        persistent_node->resolution = 0;
+        persistent_node->contained_value = static_cast<RealNode<T> &>(node).containedValue();
+    }
+    return persistent_node;
+}
+
+template<typename T>
+typename PersistentGraph<T>::Leaf
+PersistentGraph<T>::getNodeAtCoordinates(Coordinates coordinates) const {
+    std::shared_ptr<const PersistentNode> node = root;
+    Coordinates node_origin = origin;
+    double node_scale = scale;
+    while (node->resolution != 0) {
+        auto index = getSubNodeIndex(*node, node_origin, node_scale, coordinates);
+        node_scale /= node->resolution;
+        node_origin = {node_origin.x + index.second * node_scale,
+                       node_origin.y + index.first * node_scale};
+        node = node->sub_nodes[index.first * node->resolution + index.second];
+    }
+    return {node, node_origin, node_scale};
+}
+
+template<typename T>
+std::vector<typename PersistentGraph<T>::Leaf>
+PersistentGraph<T>::getAllNodesInArea(Area<T> &area) const {
+    std::vector<Leaf> leaves;
+    getAllNodesThatPassFilter(root, origin, scale,
+                              [&](Coordinates node_origin, double node_scale) {
+                                  return area.overlapsSquare(node_origin, node_scale);
+                              },
+                              leaves);
+    return leaves;
+}
+
+template<typename T>
+std::vector<typename PersistentGraph<T>::Leaf> PersistentGraph<T>::getAllSubNodes() const {
+    std::vector<Leaf> leaves;
+    getAllNodesThatPassFilter(root, origin, scale,
+                              [](Coordinates, double) { return true; }, leaves);
+    return leaves;
+}
+
+template<typename T>
+PersistentGraph<T> PersistentGraph<T>::setValueAtCoordinates(Coordinates coordinates,
+                                                             T value) const {
+    auto new_root = replaceNodeAtCoordinates(
+            root, origin, scale, coordinates, [&](const PersistentNode &) {
+                auto new_node = std::make_shared<PersistentNode>();
+                new_node->resolution = 0;
+                new_node->contained_value = std::move(value);
+                return std::shared_ptr<const PersistentNode>(std::move(new_node));
+            });
+    return PersistentGraph(new_root, origin, scale);
+}
+
+template<typename T>
+PersistentGraph<T> PersistentGraph<T>::changeResolutionOfNodeAtCoordinates(
+        Coordinates coordinates, unsigned int resolution) const {
+    auto new_root = replaceNodeAtCoordinates(
+            root, origin, scale, coordinates, [&](const PersistentNode &) {
+                // Every new sub-node is identical, so they can all share a single node
+                auto new_sub_node = std::make_shared<PersistentNode>();
+                new_sub_node->resolution = 0;
+                new_sub_node->contained_value = T();
+                auto new_node = std::make_shared<PersistentNode>();
+                new_node->resolution = resolution;
+                new_node->sub_nodes.assign(resolution * resolution, new_sub_node);
+                return std::shared_ptr<const PersistentNode>(std::move(new_node));
+            });
+    return PersistentGraph(new_root, origin, scale);
+}
+
+template<typename T>
+std::shared_ptr<const typename PersistentGraph<T>::PersistentNode>
+PersistentGraph<T>::getRootNode() const {
+    return root;
+}
+
+template<typename T>
+double PersistentGraph<T>::getScale() const {
+    return scale;
+}
+
+template<typename T>
+std::shared_ptr<const typename PersistentGraph<T>::PersistentNode>
+PersistentGraph<T>::replaceNodeAtCoordinates(
+        const std::shared_ptr<const PersistentNode> &node,
+        Coordinates node_origin, double node_scale, Coordinates coordinates,
+        const std::function<std::shared_ptr<const PersistentNode>(
+                const PersistentNode &)> &replace) {
+    if (node->resolution == 0) {
+        return replace(*node);
+    }
+
+    // Copy this node, sharing every sub-node except the one we're replacing
+    // something below
+    auto index = getSubNodeIndex(*node, node_origin, node_scale, coordinates);
+    double sub_node_scale = node_scale / node->resolution;
+    Coordinates sub_node_origin = {node_origin.x + index.second * sub_node_scale,
+                                   node_origin.y + index.first * sub_node_scale};
+    auto new_node = std::make_shared<PersistentNode>();
+    new_node->resolution = node->resolution;
+    new_node->sub_nodes = node->sub_nodes;
+    auto &sub_node = new_node->sub_nodes[index.first * node->resolution + index.second];
+    sub_node = replaceNodeAtCoordinates(sub_node, sub_node_origin, sub_node_scale,
+                                        coordinates, replace);
+    return new_node;
+}
+
+template<typename T>
+std::pair<unsigned int, unsigned int> PersistentGraph<T>::getSubNodeIndex(
+        const PersistentNode &node, Coordinates node_origin,
+        double node_scale, Coordinates coordinates) {
+    double sub_node_scale = node_scale / node.resolution;
+    auto index = [&](double position, double min) {
+        double cell = std::floor((position - min) / sub_node_scale);
+        return static_cast<unsigned int>(
+                std::max(0.0, std::min<double>(node.resolution - 1, cell)));
+    };
+    return {index(coordinates.y, node_origin.y), index(coordinates.x, node_origin.x)};
+}
+
+template<typename T>
+void PersistentGraph<T>::getAllNodesThatPassFilter(
+        const std::shared_ptr<const PersistentNode> &node,
+        Coordinates node_origin, double node_scale,
+        const std::function<bool(Coordinates, double)> &filter,
+        std::vector<Leaf> &leaves) {
+    if (!filter(node_origin, node_scale)) {
+        return;
+    }
+    if (node->resolution == 0) {
+        leaves.push_back({node, node_origin, node_scale});
+        return;
+    }
+
+    double sub_node_scale = node_scale / node->resolution;
+    for (unsigned int row = 0; row < node->resolution; row++) {
+        for (unsigned int col = 0; col < node->resolution; col++) {
+            Coordinates sub_node_origin = {node_origin.x + col * sub_node_scale,
+                                           node_origin.y + row * sub_node_scale};
+            getAllNodesThatPassFilter(node->sub_nodes[row * node->resolution + col],
+                                      sub_node_origin, sub_node_scale, filter, leaves);
+        }
+    }
+}
+
+}
@@ -20,6 +20,8 @@ namespace multi_resolution_graph {
 
         bool overlapsNode(Node<T> &node) override;
 
+        bool overlapsSquare(Coordinates bottom_left, double scale) override;
+
         std::shared_ptr<Area<T>> clone() const {
             return std::make_shared<Polygon<T>>(*this);
         };
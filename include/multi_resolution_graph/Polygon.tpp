@@ -10,19 +10,24 @@ boundary_points(boundary_points){};
 
 template <typename T>
 bool Polygon<T>::overlapsNode(Node<T>& node) {
+    return overlapsSquare(node.getCoordinates(), node.getScale());
+}
+
+template <typename T>
+bool Polygon<T>::overlapsSquare(Coordinates bottom_left, double scale) {
     // Get the 4 corner points of this node
-    Coordinates p1 = node.getCoordinates();
+    Coordinates p1 = bottom_left;
     Coordinates p2 = {
-            p1.x + node.getScale(),
+            p1.x + scale,
             p1.y
     };
     Coordinates p3 = {
-            p1.x + node.getScale(),
-            p1.y + node.getScale()
+            p1.x + scale,
+            p1.y + scale
     };
     Coordinates p4 = {
             p1.x,
-            p1.y + node.getScale()
+            p1.y + scale
     };
     std::vector<Coordinates> node_points = {p1, p2, p3, p4};
     std::vector<std::pair<Coordinates, Coordinates>> node_edges = {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <limits>
+
 #include "Node.h"
 #include "GraphNode.h"
 
@@ -7,10 +9,12 @@
 namespace multi_resolution_graph {
     template <typename T>
     class GraphNode;
+    template <typename T, typename V>
+    class ValueLayers;
 
     // TODO: Really detailed comment explaining what exactly this class is
     template<typename T>
-    class RealNode : public Node<T>, public std::enable_shared_from_this<RealNode<T>> {
+    class RealNode final : public Node<T>, public std::enable_shared_from_this<RealNode<T>> {
     public:
         std::optional<std::shared_ptr<RealNode<T>>>
         getClosestNodeToCoordinates(Coordinates coordinates) override;
@@ -45,11 +49,18 @@ namespace multi_resolution_graph {
         explicit RealNode(GraphNode<T> *parent);
 
 
-        // TODO: This is a likely spot to start for performance improvements
-        // TODO: Should not be using raw pointers here
         /**
-         * Get the neighbouring nodes to this node
-         * @return a vector of all neighbouring nodes
+         * Get the neighbouring nodes to this node, ie. every RealNode that shares
+         * (part of) an edge with this one, including all the smaller nodes along
+         * an edge
+         *
+         * If the graph is a quadtree, the neighbours on each side are found from
+         * the cell this node covers, with a single lookup per side (a hash lookup
+         * if the graph has a locational index, see
+         * `GraphNode::enableLocationalIndex`). Otherwise, the graph is searched
+         * for nodes touching the edges of this one.
+         * @return a vector of all neighbouring nodes, ordered by side (below,
+         * above, left, then right), and then along each side
          */
         std::vector<std::shared_ptr<RealNode<T>>> getNeighbours();
 
@@ -58,20 +69,52 @@ namespace multi_resolution_graph {
          * Converts this RealNode into a GraphNode
          * Note: Will invalidate any pointers to this Node
          * @param resolution the resolution of the new GraphNode
+         * @param split a function that sets the values of the new RealNodes from
+         * this one (see `GraphNode::changeResolutionOfNode`)
          */
         std::shared_ptr<Node < T>> convertToGraphNode(
-        unsigned int resolution
+        unsigned int resolution,
+        const typename GraphNode<T>::ValueSplit &split = nullptr
         );
 
         // TODO: Better comment? Bit hard, since it's so generic
-        // TODO: YOU ARE HERE - make this return by reference and remove `setContainedValue` below
         /**
          * Gets the value contained by this node
+         *
+         * Changing the value through this reference does not update the value
+         * aggregates of the graph (see `GraphNode::enableValueAggregates`), use
+         * `setContainedValue` for that
          * @return a reference to the object contained by this node
          */
         T &containedValue();
 
+        /**
+         * Sets the value contained by this node, and updates the value aggregates
+         * of every node above it (if the graph keeps them)
+         * @param value the new value of this node
+         */
+        void setContainedValue(T value);
+
+        // The leaf id of a RealNode that has not been given one (see `getLeafId`)
+        static constexpr size_t NO_LEAF_ID = std::numeric_limits<size_t>::max();
+
+        /**
+         * Gets the id of this node in the ValueLayers of its graph, which is the
+         * index of this node's value in each layer (see `ValueLayers`)
+         * @return the leaf id of this node, or `NO_LEAF_ID` if the ValueLayers of
+         * this graph have not been updated since this node was created
+         */
+        size_t getLeafId() const;
+
     private:
+        // GraphNodes fill in the cached coordinates of their sub-nodes
+        // when they are frozen
+        friend class GraphNode<T>;
+
+        // ValueLayers hand out leaf ids
+        template <typename U, typename V>
+        friend class ValueLayers;
+
         // TODO: Better comment here?
         // We use a raw pointer here so that we may initialise it in the GraphNode
         // constructor without having to call `share_from_this`
@@ -89,6 +132,9 @@ namespace multi_resolution_graph {
 
         // The cached coordinates of this node
         Coordinates cached_coordinates;
+
+        // The index of this node's value in each layer of its graph's ValueLayers
+        size_t leaf_id;
     };
 }
 
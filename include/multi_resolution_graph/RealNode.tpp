@@ -4,8 +4,11 @@ namespace multi_resolution_graph {
 
 template <typename T>
 RealNode<T>::RealNode(GraphNode<T>* parent):
+        Node<T>(NodeType::REAL_NODE),
         parent(parent),
-        have_cached_coordinates(false)
+        contained_value(),
+        have_cached_coordinates(false),
+        leaf_id(NO_LEAF_ID)
 {
 }
 
@@ -17,30 +20,7 @@ std::optional<std::shared_ptr<RealNode<T>>> RealNode<T>::getClosestNodeToCoordin
 
 template <typename T>
 std::vector<std::shared_ptr<RealNode<T>>> RealNode<T>::getNeighbours() {
-    // Find the closest nodes above, below, to the left, and to the right of this node
-    std::vector<std::function<bool(Node<T>&)>> filters = {
-            // Filter to find the node below this one
-            [&](Node<T> &n) { return n.getCoordinates().y < this->getCoordinates().y; },
-            // Filter to find the node above this one
-            [&](Node<T> &n) { return n.getCoordinates().y > this->getCoordinates().y; },
-            // Filter to find the node to the left of this one
-            [&](Node<T> &n) { return n.getCoordinates().x < this->getCoordinates().x; },
-            // Filter to find the node to the right of this one
-            [&](Node<T> &n) { return n.getCoordinates().x > this->getCoordinates().x; }
-    };
-
-    std::vector<std::shared_ptr<RealNode<T>>> neighbours;
-    for (auto& filter : filters){
-        std::optional<std::shared_ptr<RealNode<T>>> node =
-                parent->getClosestNodeToCoordinatesThatPassesFilter(
-                    this->getCoordinates(), filter,
-                    true);
-        if (node) {
-            neighbours.push_back(*node);
-        }
-    }
-
-    return neighbours;
+    return parent->getNeighboursOfSubNode(this);
 }
 
 template <typename T>
@@ -98,8 +78,9 @@ double RealNode<T>::getScale() {
 }
 
 template <typename T>
-std::shared_ptr<Node<T>> RealNode<T>::convertToGraphNode(unsigned int resolution) {
-    return parent->changeResolutionOfNode(this->shared_from_this(), resolution);
+std::shared_ptr<Node<T>> RealNode<T>::convertToGraphNode(unsigned int resolution,
+                                                         const typename GraphNode<T>::ValueSplit &split) {
+    return parent->changeResolutionOfNode(this->shared_from_this(), resolution, split);
 }
 
 template <typename T>
@@ -107,4 +88,17 @@ T& RealNode<T>::containedValue() {
     return contained_value;
 }
 
+template <typename T>
+void RealNode<T>::setContainedValue(T value) {
+    contained_value = std::move(value);
+    if (parent->hasValueAggregates()) {
+        parent->updateValueAggregatesAbove(parent->getValueProjection());
+    }
+}
+
+template <typename T>
+size_t RealNode<T>::getLeafId() const {
+    return leaf_id;
+}
+
 }
@@ -11,11 +11,16 @@ Rectangle<T>::Rectangle(double width, double height, Coordinates bottom_left_poi
 
 template <typename T>
 bool Rectangle<T>::overlapsNode(Node<T>& node) {
+    return overlapsSquare(node.getCoordinates(), node.getScale());
+}
+
+template <typename T>
+bool Rectangle<T>::overlapsSquare(Coordinates bottom_left, double scale) {
     // TODO: Some comments here would probably be a good idea.....
-    double nx_min = node.getCoordinates().x;
-    double ny_min = node.getCoordinates().y;
-    double nx_max = nx_min + node.getScale();
-    double ny_max = ny_min + node.getScale();
+    double nx_min = bottom_left.x;
+    double ny_min = bottom_left.y;
+    double nx_max = nx_min + scale;
+    double ny_max = ny_min + scale;
     double rx_min = bottom_left_coordinates.x;
     double ry_min = bottom_left_coordinates.y;
     double rx_max = rx_min + width;
@@ -0,0 +1,266 @@
+#pragma once
+
+// C++ STD Includes
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphNode.h"
+#include "GraphSerializer.h"
+#include "Area.h"
+
+namespace multi_resolution_graph {
+    /**
+     * A graph too large to keep in memory, split into tiles that are loaded
+     * from disk as they are needed
+     *
+     * Each tile is one of the top level nodes of the full graph, stored on its own
+     * (with GraphSerializer) in a tile directory written by `writeTiles`. Loaded
+     * tiles are kept in a least recently used cache, and the least recently used
+     * tiles are dropped whenever the loaded tiles use more than the memory budget.
+     *
+     * Nodes returned by queries keep the tile they are in loaded for as long as
+     * they are held, even if the cache drops it, so they are always safe to use.
+     * They are read-only snapshots of the tile on disk: tiles are never written
+     * back, so a value changed through `containedValue()` is lost once the tile
+     * is dropped, and later queries that load the tile again see the value on
+     * disk (as may queries made while the node is held, if the tile was dropped
+     * and reloaded in between). Rewrite the tiles with `writeTiles` to change them.
+     * Queries are answered over the whole graph, loading whichever tiles are
+     * needed, so neighbours and areas may span several tiles.
+     *
+     * A TiledGraph is not safe to use from several threads at once.
+     */
+    template<typename T>
+    class TiledGraph {
+    public:
+        // The version of the tile directory layout written by `writeTiles`
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        // The magic string at the start of the index file of every tile directory
+        static constexpr char MAGIC[8] = "MRGTILE";
+
+        // The name of the index file in every tile directory
+        static constexpr const char *INDEX_FILE_NAME = "graph.tiles";
+
+        /**
+         * The contents of the index file of a tile directory
+         */
+        struct Index {
+            // Always `MAGIC`
+            char magic[8];
+
+            // The version of the layout
+            uint32_t version;
+
+            // The number of tiles along each side of the graph
+            uint32_t resolution;
+
+            // The length/width of the whole graph
+            double scale;
+
+            // The coordinates of the bottom left corner of the whole graph
+            double x;
+            double y;
+        };
+
+        /**
+         * This is thrown when a tile directory (or a tile in it) cannot be read
+         * or written
+         */
+        class TileFileException : public std::runtime_error {
+        public:
+            explicit TileFileException(const std::string &m) : std::runtime_error(m) {}
+        };
+
+        /**
+         * Writes each top level node of a graph as a separate tile
+         * @param graph the graph to write
+         * @param directory the directory to write the tiles to (created if it
+         * does not exist)
+         */
+        static void writeTiles(GraphNode<T> &graph, const std::string &directory);
+
+        // Delete the default constructor
+        TiledGraph() = delete;
+
+        /**
+         * Opens a tile directory written by `writeTiles`. No tiles are loaded until
+         * they are needed.
+         *
+         * Throws a TileFileException if the directory cannot be read
+         * @param directory the tile directory
+         * @param memory_budget the (approximate) number of bytes that the loaded
+         * tiles may use before tiles start being dropped. The most recently used
+         * tile is always kept, even if it alone is over budget
+         */
+        TiledGraph(const std::string &directory, size_t memory_budget);
+
+        /**
+         * Gets the RealNode containing the given coordinates
+         * @param coordinates the coordinates to look for a node at (coordinates
+         * outside the graph are moved to the closest point on its boundary)
+         * @return the RealNode containing the given coordinates
+         */
+        std::shared_ptr<RealNode<T>> getClosestNodeToCoordinates(Coordinates coordinates);
+
+        /**
+         * Gets all RealNodes in a given area, across all tiles
+         * @param area the area to look for nodes in
+         * @return all RealNodes in the given Area
+         */
+        std::vector<std::shared_ptr<RealNode<T>>> getAllNodesInArea(Area<T> &area);
+
+        /**
+         * Gets every RealNode that shares (part of) an edge with the given node,
+         * including nodes in neighbouring tiles
+         * @param node a node returned by a query on this graph
+         * @return all RealNodes sharing an edge with the given node (never the
+         * node itself, even if its tile was dropped and reloaded)
+         */
+        std::vector<std::shared_ptr<RealNode<T>>>
+        getNeighbours(const std::shared_ptr<RealNode<T>> &node);
+
+        /**
+         * Loads every tile within a given distance of a position, so that queries
+         * around that position don't have to wait for tiles to be loaded
+         *
+         * This is meant to be called whenever the robot moves. Tiles are loaded
+         * furthest first, so if they don't all fit in the memory budget, the ones
+         * closest to the position are the ones that are kept.
+         * @param position the position of the robot
+         * @param radius the distance from the position to load tiles within
+         */
+        void prefetchAround(Coordinates position, double radius);
+
+        /**
+         * Gets a tile, loading it if it is not already loaded
+         *
+         * Throws a TileFileException if the tile cannot be read
+         * @param row the row of the tile
+         * @param col the column of the tile
+         * @return the top level node of the tile
+         */
+        std::shared_ptr<GraphNode<T>> getTile(unsigned int row, unsigned int col);
+
+        /**
+         * Checks if a tile is currently loaded
+         * @param row the row of the tile
+         * @param col the column of the tile
+         * @return if the tile is currently loaded
+         */
+        bool isTileLoaded(unsigned int row, unsigned int col) const;
+
+        /**
+         * Gets the (approximate) memory used by the loaded tiles
+         * @return the number of bytes used by the loaded tiles
+         */
+        size_t getMemoryUsage() const;
+
+        /**
+         * Get the number of tiles along each side of this graph
+         * @return the number of tiles along each side of this graph
+         */
+        unsigned int getResolution() const;
+
+        /**
+         * Gets the scale of this graph
+         * @return the length/width of this graph
+         */
+        double getScale() const;
+
+        /**
+         * Gets the coordinates of this graph
+         * @return the coordinates of the bottom left corner of this graph
+         */
+        Coordinates getCoordinates() const;
+
+    private:
+        /**
+         * A loaded tile
+         */
+        struct LoadedTile {
+            // The top level node of the tile
+            std::shared_ptr<GraphNode<T>> tile;
+
+            // The (approximate) memory used by the tile, in bytes
+            size_t memory_usage;
+
+            // Where the tile is in the least recently used list
+            typename std::list<size_t>::iterator lru_position;
+        };
+
+        /**
+         * Gets the path to the file for a tile
+         * @param directory the tile directory
+         * @param row the row of the tile
+         * @param col the column of the tile
+         * @return the path to the file for the tile
+         */
+        static std::string getTilePath(const std::string &directory,
+                                       unsigned int row, unsigned int col);
+
+        /**
+         * Estimates the memory used by a node and every node below it
+         * @param node the node to estimate the memory usage of
+         * @return the (approximate) number of bytes used
+         */
+        static size_t estimateMemoryUsage(Node<T> &node);
+
+        /**
+         * Gets the range of tiles (along one axis) overlapping a range of positions
+         * @param min the start of the range of positions
+         * @param max the end of the range of positions
+         * @param origin the position of the start of the graph along the axis
+         * @return the first and last tile (inclusive) that overlap the range
+         */
+        std::pair<unsigned int, unsigned int> getTileRange(double min, double max,
+                                                           double origin) const;
+
+        /**
+         * Drops the least recently used tiles until the loaded tiles are within
+         * the memory budget (or only one tile is left)
+         */
+        void dropTilesOverBudget();
+
+        /**
+         * Makes a pointer to a node that keeps the tile the node is in loaded
+         * @param tile the top level node of the tile the node is in
+         * @param node the node
+         * @return a pointer to the node, that keeps the tile loaded
+         */
+        static std::shared_ptr<RealNode<T>> keepTileLoaded(
+                const std::shared_ptr<GraphNode<T>> &tile,
+                const std::shared_ptr<RealNode<T>> &node);
+
+        // The directory the tiles are stored in
+        std::string directory;
+
+        // The number of tiles along each side of this graph
+        unsigned int resolution;
+
+        // The length/width of this graph
+        double scale;
+
+        // The coordinates of the bottom left corner of this graph
+        Coordinates origin;
+
+        // The number of bytes that loaded tiles may use
+        size_t memory_budget;
+
+        // The number of bytes used by the loaded tiles
+        size_t memory_usage;
+
+        // The loaded tiles, by `row * resolution + col`
+        std::unordered_map<size_t, LoadedTile> loaded_tiles;
+
+        // The loaded tiles, from the most recently used to the least
+        std::list<size_t> lru_tiles;
+    };
+}
+
+#include "TiledGraph.tpp"
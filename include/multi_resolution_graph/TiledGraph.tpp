@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "TiledGraph.h"
+
+namespace multi_resolution_graph {
+
+template <typename T>
+void TiledGraph<T>::writeTiles(GraphNode<T> &graph, const std::string &directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        throw TileFileException("Could not create " + directory + ": " + error.message());
+    }
+
+    Index index{};
+    std::memcpy(index.magic, MAGIC, sizeof(index.magic));
+    index.version = FORMAT_VERSION;
+    index.resolution = graph.getResolution();
+    index.scale = graph.getScale();
+    index.x = graph.getCoordinates().x;
+    index.y = graph.getCoordinates().y;
+
+    std::ofstream index_file(directory + "/" + INDEX_FILE_NAME, std::ios::binary);
+    index_file.write(reinterpret_cast<const char *>(&index), sizeof(Index));
+    if (!index_file) {
+        throw TileFileException("Could not write the index of " + directory);
+    }
+
+    std::vector<std::vector<std::shared_ptr<Node<T>>>> tiles = graph.getSubNodes();
+    for (unsigned int row = 0; row < index.resolution; row++) {
+        for (unsigned int col = 0; col < index.resolution; col++) {
+            std::ofstream tile_file(getTilePath(directory, row, col), std::ios::binary);
+            std::shared_ptr<Node<T>> &tile = tiles[row][col];
+            if (auto graph_node = asGraphNode(tile)) {
+                GraphSerializer<T>::writeGraph(*graph_node, tile_file);
+            } else {
+                // Every tile must be a GraphNode, so wrap lone RealNodes in one
+                GraphNode<T> wrapper(1, tile->getScale(), tile->getCoordinates());
+                wrapper.getAllSubNodes()[0]->containedValue() =
+                        std::static_pointer_cast<RealNode<T>>(tile)->containedValue();
+                GraphSerializer<T>::writeGraph(wrapper, tile_file);
+            }
+            if (!tile_file) {
+                throw TileFileException("Could not write " + getTilePath(directory, row, col));
+            }
+        }
+    }
+}
+
+template <typename T>
+TiledGraph<T>::TiledGraph(const std::string &directory, size_t memory_budget) :
+    directory(directory),
+    memory_budget(memory_budget),
+    memory_usage(0)
+{
+    Index index;
+    std::ifstream index_file(directory + "/" + INDEX_FILE_NAME, std::ios::binary);
+    if (!index_file.read(reinterpret_cast<char *>(&index), sizeof(Index))) {
+        throw TileFileException("Could not read the index of " + directory);
+    }
+    if (std::memcmp(index.magic, MAGIC, sizeof(index.magic)) != 0 ||
+        index.version != FORMAT_VERSION || index.resolution == 0) {
+        throw TileFileException(directory + " is not a valid tile directory");
+    }
+    resolution = index.resolution;
+    scale = index.scale;
+    origin = {index.x, index.y};
+}
+
+template <typename T>
+std::shared_ptr<RealNode<T>> TiledGraph<T>::getClosestNodeToCoordinates(Coordinates coordinates) {
+    unsigned int row = getTileRange(coordinates.y, coordinates.y, origin.y).first;
+    unsigned int col = getTileRange(coordinates.x, coordinates.x, origin.x).first;
+    std::shared_ptr<GraphNode<T>> tile = getTile(row, col);
+
+    // Walk down through the tile to the node containing the coordinates
+    std::shared_ptr<Node<T>> node = tile;
+    while (auto graph_node = asGraphNode(node)) {
+        Coordinates node_origin = graph_node->getCoordinates();
+        double sub_node_scale = graph_node->getScale() / graph_node->getResolution();
+        auto index = [&](double position, double min) {
+            double cell = std::floor((position - min) / sub_node_scale);
+            return static_cast<unsigned int>(
+                    std::max(0.0, std::min<double>(graph_node->getResolution() - 1, cell)));
+        };
+        node = graph_node->getSubNodes()[index(coordinates.y, node_origin.y)]
+                                        [index(coordinates.x, node_origin.x)];
+    }
+    return keepTileLoaded(tile, std::static_pointer_cast<RealNode<T>>(node));
+}
+
+template <typename T>
+std::vector<std::shared_ptr<RealNode<T>>> TiledGraph<T>::getAllNodesInArea(Area<T> &area) {
+    double tile_scale = scale / resolution;
+    std::vector<std::shared_ptr<RealNode<T>>> nodes;
+    for (unsigned int row = 0; row < resolution; row++) {
+        for (unsigned int col = 0; col < resolution; col++) {
+            Coordinates tile_origin = {origin.x + col * tile_scale, origin.y + row * tile_scale};
+            if (!area.overlapsSquare(tile_origin, tile_scale)) {
+                continue;
+            }
+            std::shared_ptr<GraphNode<T>> tile = getTile(row, col);
+            for (auto &node : tile->getAllNodesInArea(area)) {
+                nodes.emplace_back(keepTileLoaded(tile, node));
+            }
+        }
+    }
+    return nodes;
+}
+
+template <typename T>
+std::vector<std::shared_ptr<RealNode<T>>>
+TiledGraph<T>::getNeighbours(const std::shared_ptr<RealNode<T>> &node) {
+    // Allow for a little floating point error when checking if edges touch
+    const double tolerance = scale * 1e-9;
+    Coordinates min = node->getCoordinates();
+    Coordinates max = {min.x + node->getScale(), min.y + node->getScale()};
+
+    // A node shares an edge with the given one if the two (closed) squares
+    // overlap along a line, rather than at just a corner
+    auto touches_edge = [&](Node<T> &other) {
+        Coordinates other_min = other.getCoordinates();
+        double other_scale = other.getScale();
+        double overlap_x = std::min(max.x, other_min.x + other_scale) -
+                           std::max(min.x, other_min.x);
+        double overlap_y = std::min(max.y, other_min.y + other_scale) -
+                           std::max(min.y, other_min.y);
+        return overlap_x >= -tolerance && overlap_y >= -tolerance &&
+               (overlap_x > tolerance || overlap_y > tolerance);
+    };
+
+    // Only the tile the node is in, and the tiles next to it, can contain neighbours
+    auto rows = getTileRange(min.y - tolerance, max.y + tolerance, origin.y);
+    auto cols = getTileRange(min.x - tolerance, max.x + tolerance, origin.x);
+    std::vector<std::shared_ptr<RealNode<T>>> neighbours;
+    for (unsigned int row = rows.first; row <= rows.second; row++) {
+        for (unsigned int col = cols.first; col <= cols.second; col++) {
+            std::shared_ptr<GraphNode<T>> tile = getTile(row, col);
+            for (auto &other : tile->getAllNodesThatPassFilter(touches_edge, true, false)) {
+                // Loading a tile may have dropped and reloaded the tile the node
+                // is in, so the node is recognized by where it is rather than by
+                // pointer
+                Coordinates other_min = other->getCoordinates();
+                bool is_node = std::abs(other_min.x - min.x) <= tolerance &&
+                               std::abs(other_min.y - min.y) <= tolerance &&
+                               std::abs(other->getScale() - node->getScale()) <= tolerance;
+                if (!is_node) {
+                    neighbours.emplace_back(keepTileLoaded(tile, other));
+                }
+            }
+        }
+    }
+    return neighbours;
+}
+
+template <typename T>
+void TiledGraph<T>::prefetchAround(Coordinates position, double radius) {
+    double tile_scale = scale / resolution;
+    auto rows = getTileRange(position.y - radius, position.y + radius, origin.y);
+    auto cols = getTileRange(position.x - radius, position.x + radius, origin.x);
+
+    // Find the distance to every tile within the radius
+    std::vector<std::pair<double, size_t>> tiles_in_range;
+    for (unsigned int row = rows.first; row <= rows.second; row++) {
+        for (unsigned int col = cols.first; col <= cols.second; col++) {
+            Coordinates tile_origin = {origin.x + col * tile_scale, origin.y + row * tile_scale};
+            Coordinates closest_point = {
+                    std::clamp(position.x, tile_origin.x, tile_origin.x + tile_scale),
+                    std::clamp(position.y, tile_origin.y, tile_origin.y + tile_scale)};
+            double distance_to_tile = distance(position, closest_point);
+            if (distance_to_tile <= radius) {
+                tiles_in_range.emplace_back(distance_to_tile, row * resolution + col);
+            }
+        }
+    }
+
+    // Load the furthest tiles first, so the closest tiles are the most recently
+    // used (and so the last to be dropped)
+    std::sort(tiles_in_range.begin(), tiles_in_range.end(),
+              [](auto &a, auto &b) { return a.first > b.first; });
+    for (auto &tile : tiles_in_range) {
+        getTile(tile.second / resolution, tile.second % resolution);
+    }
+}
+
+template <typename T>
+std::shared_ptr<GraphNode<T>> TiledGraph<T>::getTile(unsigned int row, unsigned int col) {
+    size_t tile_id = row * resolution + col;
+
+    // If the tile is already loaded, just mark it as the most recently used
+    auto loaded_tile = loaded_tiles.find(tile_id);
+    if (loaded_tile != loaded_tiles.end()) {
+        lru_tiles.splice(lru_tiles.begin(), lru_tiles, loaded_tile->second.lru_position);
+        return loaded_tile->second.tile;
+    }
+
+    std::ifstream tile_file(getTilePath(directory, row, col), std::ios::binary);
+    if (!tile_file) {
+        throw TileFileException("Could not open " + getTilePath(directory, row, col));
+    }
+    std::shared_ptr<GraphNode<T>> tile = GraphSerializer<T>::readGraph(tile_file);
+    size_t tile_memory_usage = estimateMemoryUsage(*tile);
+
+    lru_tiles.push_front(tile_id);
+    loaded_tiles[tile_id] = {tile, tile_memory_usage, lru_tiles.begin()};
+    memory_usage += tile_memory_usage;
+    dropTilesOverBudget();
+    return tile;
+}
+
+template <typename T>
+bool TiledGraph<T>::isTileLoaded(unsigned int row, unsigned int col) const {
+    return loaded_tiles.count(row * resolution + col) != 0;
+}
+
+template <typename T>
+size_t TiledGraph<T>::getMemoryUsage() const {
+    return memory_usage;
+}
+
+template <typename T>
+unsigned int TiledGraph<T>::getResolution() const {
+    return resolution;
+}
+
+template <typename T>
+double TiledGraph<T>::getScale() const {
+    return scale;
+}
+
+template <typename T>
+Coordinates TiledGraph<T>::getCoordinates() const {
+    return origin;
+}
+
+template <typename T>
+std::string TiledGraph<T>::getTilePath(const std::string &directory,
+                                       unsigned int row, unsigned int col) {
+    return directory + "/tile_" + std::to_string(row) + "_" + std::to_string(col) + ".graph";
+}
+
+template <typename T>
+size_t TiledGraph<T>::estimateMemoryUsage(Node<T> &node) {
+    // Every node also has a shared_ptr control block
+    const size_t control_block_size = 2 * sizeof(void *);
+    auto graph_node = asGraphNode(&node);
+    if (!graph_node) {
+        return sizeof(RealNode<T>) + control_block_size;
+    }
+
+    size_t resolution = graph_node->getResolution();
+    size_t memory_usage = sizeof(GraphNode<T>) + control_block_size +
+                          resolution * sizeof(std::vector<std::shared_ptr<Node<T>>>) +
+                          resolution * resolution * sizeof(std::shared_ptr<Node<T>>);
+    for (auto &row : graph_node->getSubNodes()) {
+        for (auto &sub_node : row) {
+            memory_usage += estimateMemoryUsage(*sub_node);
+        }
+    }
+    return memory_usage;
+}
+
+template <typename T>
+std::pair<unsigned int, unsigned int> TiledGraph<T>::getTileRange(double min, double max,
+                                                                  double origin) const {
+    double tile_scale = scale / resolution;
+    auto tile = [&](double position) {
+        double cell = std::floor((position - origin) / tile_scale);
+        return static_cast<unsigned int>(
+                std::max(0.0, std::min<double>(resolution - 1, cell)));
+    };
+    return {tile(min), tile(max)};
+}
+
+template <typename T>
+void TiledGraph<T>::dropTilesOverBudget() {
+    while (memory_usage > memory_budget && lru_tiles.size() > 1) {
+        auto dropped_tile = loaded_tiles.find(lru_tiles.back());
+        memory_usage -= dropped_tile->second.memory_usage;
+        loaded_tiles.erase(dropped_tile);
+        lru_tiles.pop_back();
+    }
+}
+
+template <typename T>
+std::shared_ptr<RealNode<T>> TiledGraph<T>::keepTileLoaded(
+        const std::shared_ptr<GraphNode<T>> &tile, const std::shared_ptr<RealNode<T>> &node) {
+    // This shares ownership of the whole tile, but points at the node. The tile
+    // is never written back, so a change made through this pointer lives only as
+    // long as this copy of the tile (see the TiledGraph class comment)
+    return std::shared_ptr<RealNode<T>>(tile, node.get());
+}
+
+}
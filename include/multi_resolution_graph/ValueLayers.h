@@ -0,0 +1,217 @@
+#pragma once
+
+// C++ STD Includes
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphNode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Named layers of values stored alongside a graph, with one value per
+     * RealNode in each layer (ex. a static cost, a dynamic cost, and a velocity)
+     *
+     * Each layer is a single dense array, indexed by the leaf id of each
+     * RealNode (see `RealNode::getLeafId`). Scanning or updating every value in
+     * a layer therefore never touches the nodes themselves, and the bulk
+     * operations below run as simple contiguous (vectorizable) loops.
+     *
+     * Leaf ids are stored in the RealNodes, so a graph should only have one
+     * ValueLayers at a time. After the layout of the graph changes, `update`
+     * must be called to give ids to any new RealNodes. The values contained by
+     * the RealNodes themselves (see `RealNode::containedValue`) are separate
+     * from, and unaffected by, the values in the layers.
+     *
+     * @tparam T the type of value contained by the RealNodes of the graph
+     * @tparam V the type of value stored in each layer
+     */
+    template<typename T, typename V = double>
+    class ValueLayers {
+    public:
+        /**
+         * This is thrown when a layer with a given name cannot be found
+         */
+        class LayerNotFoundException : public std::runtime_error {
+        public:
+            explicit LayerNotFoundException(const std::string &m) : std::runtime_error(m) {}
+        };
+
+        // Delete the default constructor
+        ValueLayers() = delete;
+
+        /**
+         * Creates ValueLayers (with no layers) for the given graph, and gives
+         * every RealNode in the graph a leaf id
+         * @param graph the graph to store values for (must outlive this object)
+         */
+        explicit ValueLayers(GraphNode<T> &graph);
+
+        /**
+         * Adds a layer, with the same value for every RealNode
+         *
+         * If a layer with the given name already exists, it is left as it is
+         * @param name the name of the layer
+         * @param initial_value the value to give every RealNode in the layer
+         * @return the index of the layer
+         */
+        size_t addLayer(const std::string &name, V initial_value = V());
+
+        /**
+         * Checks if there is a layer with the given name
+         * @param name the name of the layer
+         * @return if there is a layer with the given name
+         */
+        bool hasLayer(const std::string &name) const;
+
+        /**
+         * Gets the index of a layer, which can be used instead of its name to
+         * avoid looking it up on every access
+         *
+         * Throws a LayerNotFoundException if there is no layer with the given name
+         * @param name the name of the layer
+         * @return the index of the layer
+         */
+        size_t getLayerIndex(const std::string &name) const;
+
+        /**
+         * Gets all the values in a layer
+         * @param layer the index of the layer
+         * @return the values in the layer, indexed by leaf id
+         */
+        std::vector<V> &getLayer(size_t layer);
+
+        /**
+         * Gets all the values in a layer
+         *
+         * Throws a LayerNotFoundException if there is no layer with the given name
+         * @param name the name of the layer
+         * @return the values in the layer, indexed by leaf id
+         */
+        std::vector<V> &getLayer(const std::string &name);
+
+        /**
+         * Gets the value of a RealNode in a layer
+         * @param layer the index of the layer
+         * @param node a RealNode in the graph (which must have a leaf id)
+         * @return a reference to the value of the node in the layer
+         */
+        V &getValue(size_t layer, const RealNode<T> &node);
+
+        /**
+         * Gets the value of a RealNode in a layer
+         *
+         * Throws a LayerNotFoundException if there is no layer with the given name
+         * @param name the name of the layer
+         * @param node a RealNode in the graph (which must have a leaf id)
+         * @return a reference to the value of the node in the layer
+         */
+        V &getValue(const std::string &name, const RealNode<T> &node);
+
+        /**
+         * Gets the graph the values are for
+         * @return the graph the values are for
+         */
+        GraphNode<T> &getGraph();
+
+        /**
+         * Gets every RealNode in the graph
+         * @return every RealNode in the graph, indexed by leaf id
+         */
+        const std::vector<std::shared_ptr<RealNode<T>>> &getLeaves() const;
+
+        /**
+         * Gets the number of RealNodes in the graph (and so values in each layer)
+         * @return the number of RealNodes in the graph
+         */
+        size_t getNumLeaves() const;
+
+        /**
+         * Renumbers the RealNodes in the graph after its layout has changed
+         *
+         * RealNodes that already had a leaf id keep their values in every layer
+         * (though usually under a new id). RealNodes created since the last
+         * update are given the initial value of each layer.
+         */
+        void update();
+
+        /**
+         * Sets every value in a layer
+         * @param layer the index of the layer
+         * @param value the value to set
+         */
+        void fill(size_t layer, V value);
+
+        /**
+         * Multiplies every value in a layer by a factor
+         * @param layer the index of the layer
+         * @param factor the factor to multiply by
+         */
+        void scale(size_t layer, V factor);
+
+        /**
+         * Adds a multiple of one layer to another, value by value
+         * (ie. `destination[i] += factor * source[i]`)
+         * @param destination the index of the layer to add to
+         * @param source the index of the layer to add
+         * @param factor the factor to multiply each value in `source` by
+         */
+        void addScaled(size_t destination, size_t source, V factor = V(1));
+
+        /**
+         * Copies every value in one layer into another
+         * @param destination the index of the layer to copy into
+         * @param source the index of the layer to copy
+         */
+        void copy(size_t destination, size_t source);
+
+        /**
+         * Replaces every value in a layer with the result of a function of it
+         * @param layer the index of the layer
+         * @param function a function that takes a value, and returns its new value
+         */
+        void transform(size_t layer, const std::function<V(V)> &function);
+
+        /**
+         * Adds up every value in a layer
+         * @param layer the index of the layer
+         * @return the sum of every value in the layer
+         */
+        V sum(size_t layer) const;
+
+        /**
+         * Gets the smallest value in a layer
+         * @param layer the index of the layer (must not be empty)
+         * @return the smallest value in the layer
+         */
+        V min(size_t layer) const;
+
+        /**
+         * Gets the largest value in a layer
+         * @param layer the index of the layer (must not be empty)
+         * @return the largest value in the layer
+         */
+        V max(size_t layer) const;
+
+    private:
+        // The graph the values are for
+        GraphNode<T> &graph;
+
+        // Every RealNode in the graph, indexed by leaf id
+        std::vector<std::shared_ptr<RealNode<T>>> leaves;
+
+        // The values in each layer, indexed by leaf id
+        std::vector<std::vector<V>> layers;
+
+        // The value each layer was created with, used for new RealNodes
+        std::vector<V> initial_values;
+
+        // The index of each layer, by name
+        std::unordered_map<std::string, size_t> layer_indices;
+    };
+}
+
+#include "ValueLayers.tpp"
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+
+#include "ValueLayers.h"
+
+namespace multi_resolution_graph {
+
+template <typename T, typename V>
+ValueLayers<T, V>::ValueLayers(GraphNode<T> &graph) :
+    graph(graph)
+{
+    update();
+}
+
+template <typename T, typename V>
+size_t ValueLayers<T, V>::addLayer(const std::string &name, V initial_value) {
+    auto existing_layer = layer_indices.find(name);
+    if (existing_layer != layer_indices.end()) {
+        return existing_layer->second;
+    }
+    layers.emplace_back(leaves.size(), initial_value);
+    initial_values.emplace_back(initial_value);
+    layer_indices[name] = layers.size() - 1;
+    return layers.size() - 1;
+}
+
+template <typename T, typename V>
+bool ValueLayers<T, V>::hasLayer(const std::string &name) const {
+    return layer_indices.count(name) != 0;
+}
+
+template <typename T, typename V>
+size_t ValueLayers<T, V>::getLayerIndex(const std::string &name) const {
+    auto layer = layer_indices.find(name);
+    if (layer == layer_indices.end()) {
+        throw LayerNotFoundException("No layer named \"" + name + "\"");
+    }
+    return layer->second;
+}
+
+template <typename T, typename V>
+std::vector<V> &ValueLayers<T, V>::getLayer(size_t layer) {
+    return layers[layer];
+}
+
+template <typename T, typename V>
+std::vector<V> &ValueLayers<T, V>::getLayer(const std::string &name) {
+    return layers[getLayerIndex(name)];
+}
+
+template <typename T, typename V>
+V &ValueLayers<T, V>::getValue(size_t layer, const RealNode<T> &node) {
+    return layers[layer][node.getLeafId()];
+}
+
+template <typename T, typename V>
+V &ValueLayers<T, V>::getValue(const std::string &name, const RealNode<T> &node) {
+    return layers[getLayerIndex(name)][node.getLeafId()];
+}
+
+template <typename T, typename V>
+GraphNode<T> &ValueLayers<T, V>::getGraph() {
+    return graph;
+}
+
+template <typename T, typename V>
+const std::vector<std::shared_ptr<RealNode<T>>> &ValueLayers<T, V>::getLeaves() const {
+    return leaves;
+}
+
+template <typename T, typename V>
+size_t ValueLayers<T, V>::getNumLeaves() const {
+    return leaves.size();
+}
+
+template <typename T, typename V>
+void ValueLayers<T, V>::update() {
+    std::vector<std::shared_ptr<RealNode<T>>> old_leaves = std::move(leaves);
+    leaves = graph.getAllSubNodes();
+
+    std::vector<std::vector<V>> old_layers = std::move(layers);
+    layers.clear();
+    for (size_t layer = 0; layer < old_layers.size(); layer++) {
+        layers.emplace_back(leaves.size(), initial_values[layer]);
+    }
+
+    for (size_t leaf_id = 0; leaf_id < leaves.size(); leaf_id++) {
+        RealNode<T> &leaf = *leaves[leaf_id];
+        // Only trust the old id if it really was this node's (ex. it wasn't
+        // copied over from another graph)
+        size_t old_leaf_id = leaf.leaf_id;
+        if (old_leaf_id < old_leaves.size() && old_leaves[old_leaf_id].get() == &leaf) {
+            for (size_t layer = 0; layer < layers.size(); layer++) {
+                layers[layer][leaf_id] = old_layers[layer][old_leaf_id];
+            }
+        }
+        leaf.leaf_id = leaf_id;
+    }
+}
+
+template <typename T, typename V>
+void ValueLayers<T, V>::fill(size_t layer, V value) {
+    V *values = layers[layer].data();
+    const size_t num_values = layers[layer].size();
+    #pragma omp simd
+    for (size_t i = 0; i < num_values; i++) {
+        values[i] = value;
+    }
+}
+
+template <typename T, typename V>
+void ValueLayers<T, V>::scale(size_t layer, V factor) {
+    V *values = layers[layer].data();
+    const size_t num_values = layers[layer].size();
+    #pragma omp simd
+    for (size_t i = 0; i < num_values; i++) {
+        values[i] *= factor;
+    }
+}
+
+template <typename T, typename V>
+void ValueLayers<T, V>::addScaled(size_t destination, size_t source, V factor) {
+    V *destination_values = layers[destination].data();
+    const V *source_values = layers[source].data();
+    const size_t num_values = layers[destination].size();
+    #pragma omp simd
+    for (size_t i = 0; i < num_values; i++) {
+        destination_values[i] += factor * source_values[i];
+    }
+}
+
+template <typename T, typename V>
+void ValueLayers<T, V>::copy(size_t destination, size_t source) {
+    std::copy(layers[source].begin(), layers[source].end(), layers[destination].begin());
+}
+
+template <typename T, typename V>
+void ValueLayers<T, V>::transform(size_t layer, const std::function<V(V)> &function) {
+    std::transform(layers[layer].begin(), layers[layer].end(), layers[layer].begin(), function);
+}
+
+template <typename T, typename V>
+V ValueLayers<T, V>::sum(size_t layer) const {
+    const V *values = layers[layer].data();
+    const size_t num_values = layers[layer].size();
+    V total = V();
+    #pragma omp simd reduction(+:total)
+    for (size_t i = 0; i < num_values; i++) {
+        total += values[i];
+    }
+    return total;
+}
+
+template <typename T, typename V>
+V ValueLayers<T, V>::min(size_t layer) const {
+    return *std::min_element(layers[layer].begin(), layers[layer].end());
+}
+
+template <typename T, typename V>
+V ValueLayers<T, V>::max(size_t layer) const {
+    return *std::max_element(layers[layer].begin(), layers[layer].end());
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// C++ STD Includes
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "GraphNode.h"
+
+namespace multi_resolution_graph {
+    /**
+     * Common ways of carrying the values contained by RealNodes through changes
+     * to the resolution of a graph
+     *
+     * The split policies are for `GraphNode::changeResolutionOfNode` (and
+     * `RealNode::convertToGraphNode`), and set the values of the RealNodes a
+     * node is split into from the value of that node. The merge policies are
+     * for `GraphNode::mergeSubNode` (and `GraphNode::convertToRealNode`), and
+     * reduce the values of the RealNodes being merged to a single value.
+     *
+     * The nodes being split or merged are discarded afterwards, so every
+     * policy moves values out of them wherever it can, rather than copying.
+     *
+     * @tparam T the type of value contained by the RealNodes of the graph
+     */
+    template<typename T>
+    class ValuePolicies {
+    public:
+        using ValueSplit = typename GraphNode<T>::ValueSplit;
+        using ValueReduction = typename GraphNode<T>::ValueReduction;
+
+        // A function that takes the value of a node being split, and the row
+        // and column of a new sub-node, and returns the value of that sub-node
+        using SubNodeValueFunction = std::function<T(const T &, unsigned int, unsigned int)>;
+
+        // A function that takes two values, and combines them into one
+        using ValueCombination = std::function<T(T &&, T &&)>;
+
+        /**
+         * Gives every new RealNode the value of the node being split. The value
+         * is copied into all but one of the new RealNodes, and moved into the last
+         * @return the split policy
+         */
+        static ValueSplit replicate();
+
+        /**
+         * Gives every new RealNode the value at its center of a linear
+         * approximation of the values around the node being split, with the
+         * gradient fitted by least squares to the values at the centers of the
+         * neighbours of the node (so a linear field is kept exactly, whatever
+         * the sizes of the neighbours)
+         *
+         * T must support `T + T`, `T - T` and `T * double`, and `T()` must be zero
+         * @return the split policy
+         */
+        static ValueSplit interpolate();
+
+        /**
+         * Sets the value of every new RealNode with a given function
+         * @param function a function that takes the value of the node being
+         * split, and the row and column of a new RealNode, and returns the value
+         * of that RealNode
+         * @return the split policy
+         */
+        static ValueSplit fromFunction(const SubNodeValueFunction &function);
+
+        /**
+         * Reduces the RealNodes being merged to the mean of their values,
+         * weighted by the area of each node
+         *
+         * T must support `T + T` and `T * double`, and `T()` must be zero
+         * @return the merge policy
+         */
+        static ValueReduction mean();
+
+        /**
+         * Reduces the RealNodes being merged to the value of the first (bottom
+         * left) of them, which is moved rather than copied
+         * @return the merge policy
+         */
+        static ValueReduction first();
+
+        /**
+         * Reduces the RealNodes being merged by combining their values in turn,
+         * starting from the first (bottom left) of them. Every value is moved
+         * into the combination, rather than copied
+         * @param combination a function that combines two values into one
+         * @return the merge policy
+         */
+        static ValueReduction fold(const ValueCombination &combination);
+    };
+}
+
+#include "ValuePolicies.tpp"
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+#include "ValuePolicies.h"
+
+namespace multi_resolution_graph {
+
+template <typename T>
+typename ValuePolicies<T>::ValueSplit ValuePolicies<T>::replicate() {
+    return [](RealNode<T> &node, const std::vector<std::shared_ptr<RealNode<T>>> &new_nodes) {
+        for (size_t i = 0; i + 1 < new_nodes.size(); i++) {
+            new_nodes[i]->containedValue() = node.containedValue();
+        }
+        new_nodes.back()->containedValue() = std::move(node.containedValue());
+    };
+}
+
+template <typename T>
+typename ValuePolicies<T>::ValueSplit ValuePolicies<T>::interpolate() {
+    return [](RealNode<T> &node, const std::vector<std::shared_ptr<RealNode<T>>> &new_nodes) {
+        const T &value = node.containedValue();
+        Coordinates origin = node.getCoordinates();
+        double scale = node.getScale();
+        Coordinates center = {origin.x + scale / 2, origin.y + scale / 2};
+
+        // Fit the gradient to the differences to every neighbour by least
+        // squares, over the full offset of each neighbour's center (a larger
+        // neighbour's center is offset along both axes). The normal equations are
+        // [sum_xx sum_xy; sum_xy sum_yy] * gradient = [sum_x; sum_y]
+        double sum_xx = 0, sum_xy = 0, sum_yy = 0;
+        T sum_x = T(), sum_y = T();
+        std::vector<std::shared_ptr<RealNode<T>>> neighbours = node.getNeighbours();
+        for (auto& neighbour : neighbours) {
+            Coordinates neighbour_center = neighbour->getCenterCoordinates();
+            double dx = neighbour_center.x - center.x;
+            double dy = neighbour_center.y - center.y;
+            T difference = neighbour->containedValue() - value;
+            sum_xx += dx * dx;
+            sum_xy += dx * dy;
+            sum_yy += dy * dy;
+            sum_x = sum_x + difference * dx;
+            sum_y = sum_y + difference * dy;
+        }
+
+        T x_slope = T(), y_slope = T();
+        double determinant = sum_xx * sum_yy - sum_xy * sum_xy;
+        if (determinant > 1e-9 * (sum_xx + sum_yy) * (sum_xx + sum_yy)) {
+            x_slope = (sum_x * sum_yy - sum_y * sum_xy) * (1 / determinant);
+            y_slope = (sum_y * sum_xx - sum_x * sum_xy) * (1 / determinant);
+        } else if (sum_xx + sum_yy > 0) {
+            // Every neighbour is along one line through the center (ex. a node in
+            // the corner of a graph with a single neighbour), so only the slope
+            // along that line can be found
+            double direction_x = sum_xx > 0 ? sum_xx : sum_xy;
+            double direction_y = sum_xx > 0 ? sum_xy : sum_yy;
+            double length = std::hypot(direction_x, direction_y);
+            direction_x /= length;
+            direction_y /= length;
+            T sum = T();
+            double sum_squares = 0;
+            for (auto& neighbour : neighbours) {
+                Coordinates neighbour_center = neighbour->getCenterCoordinates();
+                double offset = (neighbour_center.x - center.x) * direction_x +
+                                (neighbour_center.y - center.y) * direction_y;
+                sum = sum + (neighbour->containedValue() - value) * offset;
+                sum_squares += offset * offset;
+            }
+            T slope = sum * (1 / sum_squares);
+            x_slope = slope * direction_x;
+            y_slope = slope * direction_y;
+        }
+
+        auto resolution = static_cast<unsigned int>(std::lround(std::sqrt(new_nodes.size())));
+        double sub_node_scale = scale / resolution;
+        for (unsigned int row = 0; row < resolution; row++) {
+            for (unsigned int col = 0; col < resolution; col++) {
+                double x_offset = (col + 0.5) * sub_node_scale - scale / 2;
+                double y_offset = (row + 0.5) * sub_node_scale - scale / 2;
+                new_nodes[row * resolution + col]->containedValue() =
+                        value + x_slope * x_offset + y_slope * y_offset;
+            }
+        }
+    };
+}
+
+template <typename T>
+typename ValuePolicies<T>::ValueSplit ValuePolicies<T>::fromFunction(const SubNodeValueFunction &function) {
+    return [function](RealNode<T> &node, const std::vector<std::shared_ptr<RealNode<T>>> &new_nodes) {
+        auto resolution = static_cast<unsigned int>(std::lround(std::sqrt(new_nodes.size())));
+        for (unsigned int row = 0; row < resolution; row++) {
+            for (unsigned int col = 0; col < resolution; col++) {
+                new_nodes[row * resolution + col]->containedValue() =
+                        function(node.containedValue(), row, col);
+            }
+        }
+    };
+}
+
+template <typename T>
+typename ValuePolicies<T>::ValueReduction ValuePolicies<T>::mean() {
+    return [](const std::vector<std::shared_ptr<RealNode<T>>> &nodes) {
+        T total = T();
+        double total_area = 0;
+        for (auto& node : nodes) {
+            double area = node->getScale() * node->getScale();
+            total = total + node->containedValue() * area;
+            total_area += area;
+        }
+        if (total_area > 0) {
+            total = total * (1 / total_area);
+        }
+        return total;
+    };
+}
+
+template <typename T>
+typename ValuePolicies<T>::ValueReduction ValuePolicies<T>::first() {
+    return [](const std::vector<std::shared_ptr<RealNode<T>>> &nodes) {
+        return std::move(nodes.front()->containedValue());
+    };
+}
+
+template <typename T>
+typename ValuePolicies<T>::ValueReduction ValuePolicies<T>::fold(const ValueCombination &combination) {
+    return [combination](const std::vector<std::shared_ptr<RealNode<T>>> &nodes) {
+        T value = std::move(nodes.front()->containedValue());
+        for (size_t i = 1; i < nodes.size(); i++) {
+            value = combination(std::move(value), std::move(nodes[i]->containedValue()));
+        }
+        return value;
+    };
+}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+// C++ STD Includes
+#include <memory>
+#include <mutex>
+
+#include "PersistentGraph.h"
+
+namespace multi_resolution_graph {
+    /**
+     * A graph that is modified by a single writer while being read by many readers
+     *
+     * Readers take a snapshot of the current version of the graph, which never
+     * changes no matter what the writer does, and query it without locking.
+     * Each modification by the writer publishes a new version that shares every
+     * untouched part of the graph with the previous one. Old versions are freed
+     * once the last reader holding them drops their snapshot.
+     */
+    template<typename T>
+    class VersionedGraph {
+    public:
+        // Delete the default constructor
+        VersionedGraph() = delete;
+
+        /**
+         * Creates a VersionedGraph whose first version has the same layout
+         * and values as the given graph
+         * @param graph the graph to copy
+         */
+        explicit VersionedGraph(GraphNode<T> &graph);
+
+        /**
+         * Gets the current version of the graph
+         * @return the current version of the graph, which will not be changed
+         * by any later modification
+         */
+        std::shared_ptr<const PersistentGraph<T>> getSnapshot() const;
+
+        /**
+         * Publishes a new version of the graph with the value of the node at
+         * the given coordinates changed
+         * @param coordinates the coordinates of the node to change the value of
+         * @param value the new value for the node
+         */
+        void setValueAtCoordinates(Coordinates coordinates, T value);
+
+        /**
+         * Publishes a new version of the graph with the node at the given
+         * coordinates split into `resolution x resolution` nodes
+         * @param coordinates the coordinates of the node to split
+         * @param resolution the resolution to split the node into
+         */
+        void changeResolutionOfNodeAtCoordinates(Coordinates coordinates,
+                                                 unsigned int resolution);
+
+    private:
+        /**
+         * Publishes a new version of the graph, created from the current version
+         * @param modify a function that takes the current version of the
+         * graph, and returns the new version
+         */
+        void publish(const std::function<PersistentGraph<T>(const PersistentGraph<T> &)> &modify);
+
+        // The current version of the graph. This must only be accessed through
+        // `std::atomic_load` and `std::atomic_store`, as readers may load it
+        // while the writer is publishing a new version
+        std::shared_ptr<const PersistentGraph<T>> current_version;
+
+        // Makes sure only one modification is applied at a time, so that no
+        // modification is lost if there is more than one writer
+        std::mutex writer_mutex;
+    };
+}
+
+#include "VersionedGraph.tpp"
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "VersionedGraph.h"
+
+namespace multi_resolution_graph {
+
+template<typename T>
+VersionedGraph<T>::VersionedGraph(GraphNode<T> &graph) :
+        current_version(std::make_shared<const PersistentGraph<T>>(graph)) {}
+
+template<typename T>
+std::shared_ptr<const PersistentGraph<T>> VersionedGraph<T>::getSnapshot() const {
+    return std::atomic_load(&current_version);
+}
+
+template<typename T>
+void VersionedGraph<T>::setValueAtCoordinates(Coordinates coordinates, T value) {
+    publish([&](const PersistentGraph<T> &version) {
+        return version.setValueAtCoordinates(coordinates, std::move(value));
+    });
+}
+
+template<typename T>
+void VersionedGraph<T>::changeResolutionOfNodeAtCoordinates(Coordinates coordinates,
+                                                            unsigned int resolution) {
+    publish([&](const PersistentGraph<T> &version) {
+        return version.changeResolutionOfNodeAtCoordinates(coordinates, resolution);
+    });
+}
+
+template<typename T>
+void VersionedGraph<T>::publish(
+        const std::function<PersistentGraph<T>(const PersistentGraph<T> &)> &modify) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    std::shared_ptr<const PersistentGraph<T>> version = std::atomic_load(&current_version);
+    std::atomic_store(&current_version,
+                      std::shared_ptr<const PersistentGraph<T>>(
+                              std::make_shared<const PersistentGraph<T>>(modify(*version))));
+}
+
+}
@@ -0,0 +1,142 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/AdaptiveRefiner.h"
+#include "multi_resolution_graph/GraphFactory.h"
+#include "multi_resolution_graph/Rectangle.h"
+#include "multi_resolution_graph/ValuePolicies.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class AdaptiveRefinerTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // An 8x8 graph, split evenly into 1x1 nodes
+        graph = std::make_shared<GraphNode<double>>(8, 8);
+        setValues(*graph);
+    }
+
+    // A step from 0 to 1 at x = 4.3
+    static double field(Coordinates coordinates) {
+        return coordinates.x > 4.3 ? 1 : 0;
+    }
+
+    // Sets the value of every node in a graph to the field at its center
+    static void setValues(GraphNode<double> &graph_node) {
+        for (auto& node : graph_node.getAllSubNodes()) {
+            node->containedValue() = field(node->getCenterCoordinates());
+        }
+    }
+
+    // Sets the value of every new node to the field at its center
+    static void splitWithField(RealNode<double> &node, const std::vector<std::shared_ptr<RealNode<double>>> &new_nodes) {
+        Coordinates origin = node.getCoordinates();
+        auto resolution = static_cast<unsigned int>(std::lround(std::sqrt(new_nodes.size())));
+        double sub_node_scale = node.getScale() / resolution;
+        for (unsigned int row = 0; row < resolution; row++) {
+            for (unsigned int col = 0; col < resolution; col++) {
+                new_nodes[row * resolution + col]->containedValue() =
+                        field({origin.x + (col + 0.5) * sub_node_scale, origin.y + (row + 0.5) * sub_node_scale});
+            }
+        }
+    }
+
+    std::shared_ptr<GraphNode<double>> graph;
+};
+
+TEST_F(AdaptiveRefinerTest, constructor_rejects_bad_tolerances){
+    auto indicator = [](RealNode<double> &) { return 0.0; };
+    EXPECT_THROW(AdaptiveRefiner<double>(indicator, 0.1, 0.1),
+                 AdaptiveRefiner<double>::InvalidToleranceException);
+}
+
+TEST_F(AdaptiveRefinerTest, refine_follows_step){
+    AdaptiveRefiner<double> refiner(
+            AdaptiveRefiner<double>::valueGradient([](const double &value) { return value; }), 0.1, 0.01);
+    refiner.setMinScale(0.125);
+    refiner.setValueSplit(splitWithField);
+    refiner.setValueReduction(ValuePolicies<double>::mean());
+
+    AdaptiveRefiner<double>::RefinementResult result = refiner.refineUntilStable(*graph, 10);
+    EXPECT_GT(result.num_splits, 0);
+    EXPECT_EQ(0, refiner.refine(*graph).num_splits);
+
+    for (auto& node : graph->getAllSubNodes()) {
+        Coordinates coordinates = node->getCoordinates();
+        bool touches_step = coordinates.x <= 4.3 && coordinates.x + node->getScale() >= 4.3;
+        if (touches_step) {
+            EXPECT_EQ(0.125, node->getScale());
+        }
+        if (coordinates.x + node->getScale() < 3 || coordinates.x > 6) {
+            EXPECT_EQ(1, node->getScale());
+        }
+    }
+}
+
+TEST_F(AdaptiveRefinerTest, refine_respects_max_num_nodes){
+    AdaptiveRefiner<double> refiner(
+            AdaptiveRefiner<double>::valueGradient([](const double &value) { return value; }), 0.1, 0.01);
+    refiner.setValueSplit(splitWithField);
+    refiner.setSubNodeResolution(3);
+    refiner.setMaxNumNodes(100);
+
+    refiner.refineUntilStable(*graph, 10);
+    size_t num_nodes = graph->getAllSubNodes().size();
+    EXPECT_LE(num_nodes, 100);
+    EXPECT_GT(num_nodes, 100 - 8);
+}
+
+TEST_F(AdaptiveRefinerTest, refine_coarsens_smooth_areas){
+    // Split everything, then let the refiner merge back everything away from the step
+    for (auto& node : graph->getAllSubNodes()) {
+        node->convertToGraphNode(2, splitWithField);
+    }
+    AdaptiveRefiner<double> refiner(
+            AdaptiveRefiner<double>::valueGradient([](const double &value) { return value; }), 0.1, 0.01);
+    refiner.setMinScale(0.5);
+    refiner.setValueReduction(ValuePolicies<double>::mean());
+
+    AdaptiveRefiner<double>::RefinementResult result = refiner.refine(*graph);
+    EXPECT_EQ(0, result.num_splits);
+    // Every node but those in the column the step is in
+    EXPECT_EQ(64 - 8, result.num_merges);
+    for (auto& node : graph->getAllSubNodes()) {
+        EXPECT_EQ(field(node->getCenterCoordinates()), node->containedValue());
+    }
+}
+
+// Times a refinement pass over a large graph, which is mostly spent
+// evaluating the error indicator
+TEST_F(AdaptiveRefinerTest, refine_benchmark){
+    GraphFactory<double> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Rectangle<double> everywhere(8, 8, {0, 0});
+    graph_factory.setMaxScaleInArea(everywhere, 0.05);
+    std::shared_ptr<GraphNode<double>> large_graph = graph_factory.createGraph();
+    setValues(*large_graph);
+    AdaptiveRefiner<double> refiner(
+            AdaptiveRefiner<double>::valueGradient([](const double &value) { return value; }), 0.1, 0.01);
+    refiner.setSubNodeResolution(graph_factory.getSubNodeResolution());
+    refiner.setValueSplit(splitWithField);
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    AdaptiveRefiner<double>::RefinementResult result = refiner.refine(*large_graph);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto refine_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Refining graph with " << 256 * 256 << " nodes, splitting "
+              << result.num_splits << " (us) = " << refine_time.count() << std::endl;
+    EXPECT_EQ(2 * 256, result.num_splits);
+}
+
+}
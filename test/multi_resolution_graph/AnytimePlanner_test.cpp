@@ -0,0 +1,136 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <memory>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+// Project Includes
+#include "multi_resolution_graph/AnytimePlanner.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class AnytimePlannerTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        graph = std::make_shared<GraphNode<int>>(8, 8);
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = 0;
+        }
+
+        // Put a wall across most of the middle of the graph
+        for (int col = 0; col < 7; col++) {
+            node(col, 4)->containedValue() = 1;
+        }
+    }
+
+    // Gets the RealNode at the given column and row of the top level of the graph
+    std::shared_ptr<RealNode<int>> node(int col, int row) {
+        return std::dynamic_pointer_cast<RealNode<int>>(graph->getSubNodes()[row][col]);
+    }
+
+    // Gets the total length of the given path
+    static double pathLength(const std::vector<std::shared_ptr<RealNode<int>>>& path) {
+        double length = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            length += distance(path[i-1]->getCenterCoordinates(),
+                               path[i]->getCenterCoordinates());
+        }
+        return length;
+    }
+
+    // An 8x8 graph with 1x1 nodes
+    std::shared_ptr<GraphNode<int>> graph;
+
+    // Nodes with a value of 1 are blocked
+    std::function<bool(int&)> is_blocked = [](int& value) { return value == 1; };
+};
+
+TEST_F(AnytimePlannerTest, plan_with_plenty_of_time_finds_optimal_path){
+    AnytimePlanner<int> planner(is_blocked);
+
+    AnytimePlanner<int>::PlanningResult result = planner.plan(
+            node(0,0), node(0,7),
+            AnytimePlanner<int>::Clock::now() + std::chrono::seconds(10));
+
+    EXPECT_EQ(1, result.suboptimality_bound);
+    ASSERT_FALSE(result.path.empty());
+    EXPECT_EQ(node(0,0), result.path.front());
+    EXPECT_EQ(node(0,7), result.path.back());
+
+    // We have to go around the end of the wall and back
+    EXPECT_DOUBLE_EQ(21, pathLength(result.path));
+    for (auto& path_node : result.path) {
+        EXPECT_FALSE(is_blocked(path_node->containedValue()));
+    }
+}
+
+TEST_F(AnytimePlannerTest, plan_resumes_with_passed_deadline){
+    AnytimePlanner<int> planner(is_blocked);
+
+    // With a deadline that's already passed, every call should make a little
+    // progress, and we should eventually get to the optimal path
+    AnytimePlanner<int>::PlanningResult result;
+    double last_bound = std::numeric_limits<double>::infinity();
+    int num_calls = 0;
+    do {
+        result = planner.plan(node(0,0), node(0,7), AnytimePlanner<int>::Clock::now());
+        EXPECT_LE(result.suboptimality_bound, last_bound);
+        last_bound = result.suboptimality_bound;
+        num_calls++;
+    } while (result.suboptimality_bound > 1 && num_calls < 1000);
+
+    EXPECT_EQ(1, result.suboptimality_bound);
+    EXPECT_DOUBLE_EQ(21, pathLength(result.path));
+}
+
+TEST_F(AnytimePlannerTest, constructor_rejects_non_positive_decrement){
+    EXPECT_THROW(AnytimePlanner<int>(is_blocked, 3, 0), std::invalid_argument);
+    EXPECT_THROW(AnytimePlanner<int>(is_blocked, 3, -0.5), std::invalid_argument);
+}
+
+TEST_F(AnytimePlannerTest, plan_returns_bound_for_suboptimal_path){
+    AnytimePlanner<int> planner(is_blocked, 5, 1);
+
+    // Keep planning until we get our first path
+    AnytimePlanner<int>::PlanningResult result;
+    do {
+        result = planner.plan(node(0,0), node(0,7), AnytimePlanner<int>::Clock::now());
+    } while (result.path.empty());
+
+    // The path we found must be within the bound we were given
+    EXPECT_LE(pathLength(result.path), 21 * result.suboptimality_bound);
+}
+
+TEST_F(AnytimePlannerTest, plan_no_path){
+    // Close off the gap at the end of the wall
+    node(7,4)->containedValue() = 1;
+    AnytimePlanner<int> planner(is_blocked);
+
+    AnytimePlanner<int>::PlanningResult result = planner.plan(
+            node(0,0), node(0,7),
+            AnytimePlanner<int>::Clock::now() + std::chrono::seconds(10));
+
+    EXPECT_TRUE(result.path.empty());
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), result.suboptimality_bound);
+}
+
+TEST_F(AnytimePlannerTest, plan_after_graph_changed){
+    AnytimePlanner<int> planner(is_blocked);
+    auto deadline = AnytimePlanner<int>::Clock::now() + std::chrono::seconds(10);
+    planner.plan(node(0,0), node(0,7), deadline);
+
+    // Open up a gap right next to the start
+    node(0,4)->containedValue() = 0;
+    planner.notifyGraphChanged();
+
+    AnytimePlanner<int>::PlanningResult result = planner.plan(node(0,0), node(0,7), deadline);
+    EXPECT_EQ(1, result.suboptimality_bound);
+    EXPECT_DOUBLE_EQ(7, pathLength(result.path));
+}
+
+}
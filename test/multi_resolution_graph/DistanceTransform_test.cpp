@@ -0,0 +1,240 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/DistanceTransform.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class DistanceTransformTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 16x16 graph split evenly into 1x1 nodes, with the bottom left
+        // quarter split again into 0.5x0.5 nodes
+        graph = std::make_shared<GraphNode<double>>(2, 16);
+        for (unsigned int i = 0; i < 3; i++) {
+            std::vector<std::shared_ptr<RealNode<double>>> nodes = graph->getAllSubNodes();
+            for (auto& node : nodes) {
+                node->convertToGraphNode(2);
+            }
+        }
+        for (auto& node : graph->getAllSubNodes()) {
+            Coordinates coordinates = node->getCoordinates();
+            if (coordinates.x < 8 && coordinates.y < 8) {
+                node->convertToGraphNode(2);
+            }
+        }
+    }
+
+    static bool isBlocked(const double &value) {
+        return value > 0;
+    }
+
+    // Blocks every node with its center in a rectangle
+    void block(double min_x, double min_y, double max_x, double max_y, double value = 1) {
+        for (auto& node : graph->getAllSubNodes()) {
+            Coordinates center = node->getCenterCoordinates();
+            if (center.x >= min_x && center.x <= max_x && center.y >= min_y && center.y <= max_y) {
+                node->containedValue() = value;
+            }
+        }
+    }
+
+    // Checks every distance against the distance to every blocked node
+    void expectDistancesNear(ValueLayers<double> &value_layers, DistanceTransform<double> &transform,
+                             double tolerance) {
+        std::vector<std::shared_ptr<RealNode<double>>> blocked_nodes;
+        for (auto& node : value_layers.getLeaves()) {
+            if (isBlocked(node->containedValue())) {
+                blocked_nodes.push_back(node);
+            }
+        }
+        for (auto& node : value_layers.getLeaves()) {
+            Coordinates center = node->getCenterCoordinates();
+            double expected = std::numeric_limits<double>::infinity();
+            for (auto& blocked_node : blocked_nodes) {
+                Coordinates blocked_center = blocked_node->getCenterCoordinates();
+                double half_scale = blocked_node->getScale() / 2;
+                double dx = std::max(0.0, std::abs(center.x - blocked_center.x) - half_scale);
+                double dy = std::max(0.0, std::abs(center.y - blocked_center.y) - half_scale);
+                expected = std::min(expected, std::hypot(dx, dy));
+            }
+            if (std::isinf(expected)) {
+                EXPECT_TRUE(std::isinf(transform.getDistance(*node)));
+            } else {
+                EXPECT_NEAR(expected, transform.getDistance(*node), tolerance);
+            }
+            EXPECT_EQ(transform.getDistance(*node), value_layers.getValue(transform.getLayer(), *node));
+        }
+    }
+
+    std::shared_ptr<GraphNode<double>> graph;
+};
+
+TEST_F(DistanceTransformTest, no_blocked_nodes){
+    ValueLayers<double> value_layers(*graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+    DistanceTransform<double> transform(stencil, isBlocked);
+
+    for (auto& node : value_layers.getLeaves()) {
+        EXPECT_TRUE(std::isinf(transform.getDistance(*node)));
+        EXPECT_EQ(nullptr, transform.getClosestBlockedNode(*node));
+    }
+}
+
+TEST_F(DistanceTransformTest, distances_to_blocked_nodes){
+    block(10, 10, 12, 11);
+    block(3, 5, 3.5, 7);
+    ValueLayers<double> value_layers(*graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+    DistanceTransform<double> transform(stencil, isBlocked);
+
+    EXPECT_EQ(value_layers.getLayerIndex("distance"), transform.getLayer());
+    expectDistancesNear(value_layers, transform, 1e-9);
+    std::shared_ptr<RealNode<double>> node = graph->getNodeContainingCoordinates({15.5, 10.5});
+    EXPECT_EQ(graph->getNodeContainingCoordinates({11.5, 10.5}), transform.getClosestBlockedNode(*node));
+    EXPECT_DOUBLE_EQ(3.5, transform.getDistance(*node));
+}
+
+TEST_F(DistanceTransformTest, update_when_blocking){
+    block(10, 10, 12, 11);
+    ValueLayers<double> value_layers(*graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+    DistanceTransform<double> transform(stencil, isBlocked);
+
+    block(2, 2, 3, 3);
+    EXPECT_GT(transform.update(), 0);
+    expectDistancesNear(value_layers, transform, 1e-9);
+
+    // Nothing changed, so nothing is visited
+    EXPECT_EQ(0, transform.update());
+}
+
+TEST_F(DistanceTransformTest, update_when_freeing){
+    block(10, 10, 12, 11);
+    block(2, 2, 3, 3);
+    ValueLayers<double> value_layers(*graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+    DistanceTransform<double> transform(stencil, isBlocked);
+
+    block(2, 2, 3, 3, 0);
+    transform.update();
+    expectDistancesNear(value_layers, transform, 1e-9);
+
+    block(10, 10, 12, 11, 0);
+    transform.update();
+    expectDistancesNear(value_layers, transform, 1e-9);
+}
+
+TEST_F(DistanceTransformTest, update_given_nodes){
+    ValueLayers<double> value_layers(*graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+    DistanceTransform<double> transform(stencil, isBlocked);
+
+    // Move a single blocked node across the graph
+    std::shared_ptr<RealNode<double>> last_node;
+    for (double x = 0.25; x < 16; x += 1.5) {
+        std::vector<std::shared_ptr<RealNode<double>>> changed_nodes;
+        if (last_node) {
+            last_node->containedValue() = 0;
+            changed_nodes.push_back(last_node);
+        }
+        last_node = graph->getNodeContainingCoordinates({x, x / 2});
+        last_node->containedValue() = 1;
+        changed_nodes.push_back(last_node);
+        transform.update(changed_nodes);
+        expectDistancesNear(value_layers, transform, 1e-9);
+    }
+}
+
+TEST_F(DistanceTransformTest, max_distance){
+    block(10, 10, 12, 11);
+    ValueLayers<double> value_layers(*graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+    DistanceTransform<double> transform(stencil, isBlocked, "clearance", 2);
+
+    EXPECT_EQ(transform.getLayer(), value_layers.getLayerIndex("clearance"));
+    for (auto& node : value_layers.getLeaves()) {
+        double distance = transform.getDistance(*node);
+        EXPECT_TRUE(distance <= 2 || std::isinf(distance));
+    }
+    EXPECT_DOUBLE_EQ(1.5, transform.getDistance(*graph->getNodeContainingCoordinates({13.5, 10.5})));
+    EXPECT_TRUE(std::isinf(transform.getDistance(*graph->getNodeContainingCoordinates({14.5, 10.5}))));
+}
+
+TEST_F(DistanceTransformTest, rebuild_after_split){
+    block(10, 10, 12, 11);
+    ValueLayers<double> value_layers(*graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+    DistanceTransform<double> transform(stencil, isBlocked);
+
+    graph->getNodeContainingCoordinates({13.5, 13.5})->convertToGraphNode(2);
+    stencil.update();
+    transform.rebuild();
+    EXPECT_EQ(value_layers.getNumLeaves(), graph->getAllSubNodes().size());
+    expectDistancesNear(value_layers, transform, 1e-9);
+}
+
+// Compares the time to find every distance from scratch with the time to
+// update them as a small obstacle moves
+TEST_F(DistanceTransformTest, update_benchmark){
+    GraphFactory<double> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<double> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.01);
+    graph_factory.setBalanced(true);
+    std::shared_ptr<GraphNode<double>> large_graph = graph_factory.createGraph();
+    for (auto& node : large_graph->getAllSubNodes()) {
+        Coordinates center = node->getCenterCoordinates();
+        if (std::abs(std::hypot(center.x - 4.1, center.y - 3.9) - 0.8) < 0.01) {
+            node->containedValue() = 1;
+        }
+    }
+    ValueLayers<double> value_layers(*large_graph);
+    FiniteVolumeStencil<double> stencil(value_layers);
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    DistanceTransform<double> transform(stencil, isBlocked, "distance", 0.2);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto build_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    // Move a small obstacle across the circle
+    const int num_moves = 50;
+    size_t num_visited = 0;
+    std::shared_ptr<RealNode<double>> last_node;
+    begin = std::chrono::steady_clock::now();
+    for (int move = 0; move < num_moves; move++) {
+        std::vector<std::shared_ptr<RealNode<double>>> changed_nodes;
+        if (last_node) {
+            last_node->containedValue() = 0;
+            changed_nodes.push_back(last_node);
+        }
+        last_node = large_graph->getNodeContainingCoordinates({3.6 + move * 0.02, 3.9});
+        last_node->containedValue() = 1;
+        changed_nodes.push_back(last_node);
+        num_visited += transform.update(changed_nodes);
+    }
+    end = std::chrono::steady_clock::now();
+    auto update_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << value_layers.getNumLeaves() << " nodes:" << std::endl
+              << "Time to find every distance (us) = " << build_time.count() << std::endl
+              << "Time per update as an obstacle moves (us) = " << update_time.count() / num_moves
+              << ", visiting " << num_visited / num_moves << " nodes" << std::endl;
+    EXPECT_LT(num_visited / num_moves, value_layers.getNumLeaves() / 10);
+}
+
+}
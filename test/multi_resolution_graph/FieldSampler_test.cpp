@@ -0,0 +1,202 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/FieldSampler.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class FieldSamplerTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph split evenly into 1x1 nodes, with the bottom left
+        // quadrant split again into 0.5x0.5 nodes
+        graph = std::make_shared<GraphNode<double>>(2, 4);
+        for (auto& node : graph->getAllSubNodes()) {
+            node->convertToGraphNode(2);
+        }
+        for (auto& node : graph->getAllSubNodes()) {
+            Coordinates coordinates = node->getCoordinates();
+            if (coordinates.x < 2 && coordinates.y < 2) {
+                node->convertToGraphNode(2);
+            }
+        }
+        setValues(*graph);
+    }
+
+    static double field(Coordinates coordinates) {
+        return 2 * coordinates.x + coordinates.y;
+    }
+
+    // Sets the value of every node in a graph to the field at its center
+    static void setValues(GraphNode<double> &graph_node) {
+        for (auto& node : graph_node.getAllSubNodes()) {
+            node->containedValue() = field(node->getCenterCoordinates());
+        }
+    }
+
+    std::shared_ptr<GraphNode<double>> graph;
+};
+
+TEST_F(FieldSamplerTest, constant_field_is_constant){
+    for (auto& node : graph->getAllSubNodes()) {
+        node->containedValue() = 3;
+    }
+    FieldSampler<double> sampler(*graph);
+    for (double x = 0; x <= 4; x += 0.1) {
+        for (double y = 0; y <= 4; y += 0.1) {
+            EXPECT_NEAR(3, sampler.sample({x, y}), 1e-12);
+        }
+    }
+}
+
+TEST_F(FieldSamplerTest, linear_field_is_exact_on_even_graph){
+    graph = std::make_shared<GraphNode<double>>(4, 4);
+    setValues(*graph);
+    FieldSampler<double> sampler(*graph);
+
+    // Every corner of the nodes in the middle has four nodes around it
+    for (double x = 1; x <= 3; x += 0.125) {
+        for (double y = 1; y <= 3; y += 0.125) {
+            EXPECT_NEAR(field({x, y}), sampler.sample({x, y}), 1e-12);
+        }
+    }
+
+    // Coordinates outside the graph are moved onto its edge
+    EXPECT_EQ(sampler.sample({0, 2}), sampler.sample({-1, 2}));
+    EXPECT_EQ(sampler.sample({4, 4}), sampler.sample({5, 4.5}));
+}
+
+TEST_F(FieldSamplerTest, continuous_across_resolution_change){
+    FieldSampler<double> sampler(*graph);
+
+    // Walk across the edges of the small nodes, along and between their centers
+    for (double y : {0.75, 1.25, 1.6, 2.3}) {
+        double last_value = sampler.sample({0.25, y});
+        for (double x = 0.25; x <= 3.5; x += 0.001) {
+            double value = sampler.sample({x, y});
+            EXPECT_NEAR(last_value, value, 0.01);
+            if (x >= 1 && x <= 3) {
+                // Away from the edges of the graph, the field is still close to linear
+                EXPECT_NEAR(field({x, y}), value, 0.25);
+            }
+            last_value = value;
+        }
+    }
+    for (double x : {0.75, 1.25, 1.6, 2.3}) {
+        double last_value = sampler.sample({x, 0.25});
+        for (double y = 0.25; y <= 3.5; y += 0.001) {
+            double value = sampler.sample({x, y});
+            EXPECT_NEAR(last_value, value, 0.01);
+            last_value = value;
+        }
+    }
+}
+
+TEST_F(FieldSamplerTest, sample_function_of_value){
+    FieldSampler<double> sampler(*graph);
+    FieldSampler<double> negative_sampler(*graph, [](const double &value) { return -value; });
+    for (double x = 0; x <= 4; x += 0.3) {
+        EXPECT_NEAR(-sampler.sample({x, 4 - x}), negative_sampler.sample({x, 4 - x}), 1e-12);
+    }
+}
+
+TEST_F(FieldSamplerTest, batch_matches_single){
+    FieldSampler<double> sampler(*graph);
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> distribution(-0.5, 4.5);
+    std::vector<Coordinates> coordinates;
+    for (int i = 0; i < 5000; i++) {
+        coordinates.push_back({distribution(generator), distribution(generator)});
+    }
+
+    std::vector<double> values = sampler.sample(coordinates);
+    ASSERT_EQ(coordinates.size(), values.size());
+    for (size_t i = 0; i < coordinates.size(); i++) {
+        EXPECT_NEAR(sampler.sample(coordinates[i]), values[i], 1e-12);
+    }
+}
+
+// Compares the time to sample along many trajectories by finding the closest
+// node to each point, by sampling each point on its own, and in one batch
+TEST_F(FieldSamplerTest, sample_benchmark){
+    GraphFactory<double> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<double> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.01);
+    graph_factory.setBalanced(true);
+    std::shared_ptr<GraphNode<double>> large_graph = graph_factory.createGraph();
+    setValues(*large_graph);
+    large_graph->freeze();
+
+    // Short straight trajectories fanning out from around the circle
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> angle_distribution(0, 2 * M_PI);
+    std::vector<Coordinates> coordinates;
+    const int num_trajectories = 200;
+    const int num_points_per_trajectory = 100;
+    for (int trajectory = 0; trajectory < num_trajectories; trajectory++) {
+        double angle = angle_distribution(generator);
+        for (int point = 0; point < num_points_per_trajectory; point++) {
+            double distance = 2.0 * point / num_points_per_trajectory;
+            coordinates.push_back({4.1 + distance * std::cos(angle), 3.9 + distance * std::sin(angle)});
+        }
+    }
+    FieldSampler<double> sampler(*large_graph);
+
+    // Finding the closest node searches most of the graph for every point,
+    // so only time it over one trajectory
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    double closest_total = 0;
+    for (int point = 0; point < num_points_per_trajectory; point++) {
+        closest_total += (*large_graph->getClosestNodeToCoordinates(coordinates[point]))->containedValue();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto closest_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    std::vector<double> single_values;
+    for (auto& point : coordinates) {
+        single_values.push_back(sampler.sample(point));
+    }
+    end = std::chrono::steady_clock::now();
+    auto single_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    std::vector<double> batch_values = sampler.sample(coordinates);
+    end = std::chrono::steady_clock::now();
+    auto batch_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    large_graph->enableLocationalIndex();
+    begin = std::chrono::steady_clock::now();
+    std::vector<double> indexed_values = sampler.sample(coordinates);
+    end = std::chrono::steady_clock::now();
+    auto indexed_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Sampling " << coordinates.size() << " points in a graph with "
+              << large_graph->getAllSubNodes().size() << " nodes:" << std::endl
+              << "Closest node to each point (us, extrapolated from " << num_points_per_trajectory << " points) = "
+              << closest_time.count() * num_trajectories << std::endl
+              << "Sampling each point (us) = " << single_time.count() << std::endl
+              << "Sampling in a batch (us) = " << batch_time.count() << std::endl
+              << "Sampling in a batch with a locational index (us) = " << indexed_time.count() << std::endl;
+    for (size_t i = 0; i < coordinates.size(); i++) {
+        EXPECT_NEAR(single_values[i], batch_values[i], 1e-9);
+        EXPECT_NEAR(single_values[i], indexed_values[i], 1e-9);
+    }
+    EXPECT_GT(closest_total, 0);
+}
+
+}
@@ -0,0 +1,199 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/FiniteVolumeStencil.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class FiniteVolumeStencilTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph with the bottom left quadrant split, and the top right
+        // of that split again, for 10 RealNodes of three different sizes
+        graph = std::make_shared<GraphNode<int>>(2, 4);
+        auto quadrant = std::static_pointer_cast<GraphNode<int>>(
+                graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2));
+        quadrant->changeResolutionOfNode(quadrant->getSubNodes()[1][1], 2);
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(FiniteVolumeStencilTest, faces_match_neighbours){
+    ValueLayers<int> value_layers(*graph);
+    FiniteVolumeStencil<int> stencil(value_layers);
+    ASSERT_EQ(10, stencil.getNumLeaves());
+
+    const std::vector<size_t> &offsets = stencil.getFaceOffsets();
+    const std::vector<size_t> &neighbours = stencil.getFaceNeighbours();
+    const std::vector<double> &lengths = stencil.getFaceLengths();
+    const std::vector<double> &distances = stencil.getFaceDistances();
+    double total_area = 0;
+    for (size_t leaf = 0; leaf < stencil.getNumLeaves(); leaf++) {
+        std::shared_ptr<RealNode<int>> node = value_layers.getLeaves()[leaf];
+        std::vector<std::shared_ptr<RealNode<int>>> expected_neighbours = node->getNeighbours();
+        ASSERT_EQ(expected_neighbours.size(), offsets[leaf + 1] - offsets[leaf]);
+        for (size_t face = offsets[leaf]; face < offsets[leaf + 1]; face++) {
+            std::shared_ptr<RealNode<int>> neighbour = expected_neighbours[face - offsets[leaf]];
+            EXPECT_EQ(neighbour->getLeafId(), neighbours[face]);
+            EXPECT_EQ(std::min(node->getScale(), neighbour->getScale()), lengths[face]);
+            EXPECT_EQ((node->getScale() + neighbour->getScale()) / 2, distances[face]);
+        }
+        total_area += stencil.getAreas()[leaf];
+    }
+    EXPECT_EQ(16, total_area);
+}
+
+TEST_F(FiniteVolumeStencilTest, faces_are_symmetric){
+    ValueLayers<int> value_layers(*graph);
+    FiniteVolumeStencil<int> stencil(value_layers);
+
+    const std::vector<size_t> &offsets = stencil.getFaceOffsets();
+    const std::vector<size_t> &neighbours = stencil.getFaceNeighbours();
+    for (size_t leaf = 0; leaf < stencil.getNumLeaves(); leaf++) {
+        for (size_t face = offsets[leaf]; face < offsets[leaf + 1]; face++) {
+            size_t neighbour = neighbours[face];
+            auto begin = neighbours.begin() + offsets[neighbour];
+            auto end = neighbours.begin() + offsets[neighbour + 1];
+            auto reverse_face = std::find(begin, end, leaf);
+            ASSERT_NE(end, reverse_face);
+            EXPECT_EQ(stencil.getFaceLengths()[face],
+                      stencil.getFaceLengths()[reverse_face - neighbours.begin()]);
+        }
+    }
+}
+
+TEST_F(FiniteVolumeStencilTest, apply_custom_kernel){
+    ValueLayers<int> value_layers(*graph);
+    size_t count = value_layers.addLayer("count");
+    size_t scratch = value_layers.addLayer("scratch");
+    FiniteVolumeStencil<int> stencil(value_layers);
+    const std::vector<size_t> &offsets = stencil.getFaceOffsets();
+
+    stencil.apply(count, scratch, [&](size_t leaf, const double *) {
+        return static_cast<double>(offsets[leaf + 1] - offsets[leaf]);
+    });
+    for (auto& node : value_layers.getLeaves()) {
+        EXPECT_EQ(node->getNeighbours().size(), value_layers.getValue(scratch, *node));
+    }
+
+    // Iterating leaves the result in the given layer
+    value_layers.fill(count, 1);
+    stencil.iterate(count, scratch, 3, [](size_t, const double *) { return 0; });
+    EXPECT_EQ(0, value_layers.sum(count));
+    stencil.iterate(count, scratch, 3, [](size_t leaf, const double *values) { return values[leaf] + 1; });
+    EXPECT_EQ(3 * 10, value_layers.sum(count));
+}
+
+TEST_F(FiniteVolumeStencilTest, diffuse_conserves_total){
+    ValueLayers<int> value_layers(*graph);
+    size_t temperature = value_layers.addLayer("temperature");
+    size_t scratch = value_layers.addLayer("scratch");
+    FiniteVolumeStencil<int> stencil(value_layers);
+    std::vector<double> &values = value_layers.getLayer(temperature);
+    for (size_t leaf = 0; leaf < values.size(); leaf++) {
+        values[leaf] = leaf % 3;
+    }
+    auto total = [&]() {
+        double sum = 0;
+        for (size_t leaf = 0; leaf < values.size(); leaf++) {
+            sum += values[leaf] * stencil.getAreas()[leaf];
+        }
+        return sum;
+    };
+    double initial_total = total();
+
+    stencil.diffuse(temperature, scratch, 1, 0.05, 500);
+
+    EXPECT_NEAR(initial_total, total(), 1e-9);
+    for (size_t leaf = 0; leaf < values.size(); leaf++) {
+        EXPECT_NEAR(initial_total / 16, values[leaf], 1e-3);
+    }
+}
+
+TEST_F(FiniteVolumeStencilTest, update_after_split){
+    ValueLayers<int> value_layers(*graph);
+    FiniteVolumeStencil<int> stencil(value_layers);
+    graph->getAllSubNodes()[9]->convertToGraphNode(2);
+
+    stencil.update();
+    EXPECT_EQ(13, stencil.getNumLeaves());
+    EXPECT_EQ(13, value_layers.getNumLeaves());
+}
+
+// Compares the number of cell updates per second for a diffusion step with
+// the stencil, and with finding the neighbours of every node on every step
+TEST_F(FiniteVolumeStencilTest, diffuse_benchmark){
+    GraphFactory<double> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<double> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.01);
+    graph_factory.setBalanced(true);
+    std::shared_ptr<GraphNode<double>> large_graph = graph_factory.createGraph();
+    ValueLayers<double> value_layers(*large_graph);
+    size_t temperature = value_layers.addLayer("temperature");
+    size_t scratch = value_layers.addLayer("scratch");
+    const std::vector<std::shared_ptr<RealNode<double>>> &leaves = value_layers.getLeaves();
+    for (size_t leaf = 0; leaf < leaves.size(); leaf++) {
+        leaves[leaf]->containedValue() = leaf % 7;
+        value_layers.getLayer(temperature)[leaf] = leaf % 7;
+    }
+    const unsigned int num_steps = 20;
+    const double time_step = 0.2 * 0.01 * 0.01;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    large_graph->freeze();
+    std::vector<double> new_values(leaves.size());
+    for (unsigned int step = 0; step < num_steps; step++) {
+        for (size_t leaf = 0; leaf < leaves.size(); leaf++) {
+            RealNode<double> &node = *leaves[leaf];
+            double flux = 0;
+            for (auto& neighbour : node.getNeighbours()) {
+                double length = std::min(node.getScale(), neighbour->getScale());
+                double distance = (node.getScale() + neighbour->getScale()) / 2;
+                flux += (neighbour->containedValue() - node.containedValue()) * length / distance;
+            }
+            new_values[leaf] = node.containedValue() + time_step * flux / (node.getScale() * node.getScale());
+        }
+        for (size_t leaf = 0; leaf < leaves.size(); leaf++) {
+            leaves[leaf]->containedValue() = new_values[leaf];
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto neighbours_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    FiniteVolumeStencil<double> stencil(value_layers);
+    end = std::chrono::steady_clock::now();
+    auto build_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    stencil.diffuse(temperature, scratch, 1, time_step, num_steps);
+    end = std::chrono::steady_clock::now();
+    auto stencil_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    double num_cell_updates = static_cast<double>(leaves.size()) * num_steps;
+    std::cout << "Graph with " << leaves.size() << " nodes, " << num_steps << " diffusion steps:" << std::endl
+              << "Cell updates per second with getNeighbours = "
+              << num_cell_updates / (neighbours_time.count() * 1e-6) << std::endl
+              << "Time to build stencil (us) = " << build_time.count() << std::endl
+              << "Cell updates per second with stencil = "
+              << num_cell_updates / (std::max<long>(stencil_time.count(), 1) * 1e-6) << std::endl;
+    for (size_t leaf = 0; leaf < leaves.size(); leaf += 97) {
+        EXPECT_NEAR(leaves[leaf]->containedValue(), value_layers.getValue(temperature, *leaves[leaf]), 1e-9);
+    }
+}
+
+}
@@ -0,0 +1,184 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/FixedResolutionGraph.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class FixedResolutionGraphTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 9x9 graph with a 3x3 top level, where the center node is split
+        // into 2x2, and the top right of those is split again
+        graph = std::make_shared<GraphNode<int>>(3, 9, Coordinates{1, 2});
+        auto center = std::static_pointer_cast<GraphNode<int>>(
+                graph->changeResolutionOfNode(graph->getSubNodes()[1][1], 2));
+        center->changeResolutionOfNode(center->getSubNodes()[1][1], 2);
+        int value = 0;
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = value++;
+        }
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(FixedResolutionGraphTest, constructor_with_scale){
+    FixedResolutionGraph<int, 4> fixed_graph(3, 6, {1, 1});
+
+    EXPECT_EQ(3, fixed_graph.getResolution());
+    EXPECT_EQ(6, fixed_graph.getScale());
+    EXPECT_EQ((Coordinates{1, 1}), fixed_graph.getCoordinates());
+    EXPECT_EQ(9, fixed_graph.getNumNodes());
+    EXPECT_EQ(0, fixed_graph.getAllSubNodes()[4].containedValue());
+}
+
+TEST_F(FixedResolutionGraphTest, constructor_copies_graph){
+    FixedResolutionGraph<int> fixed_graph(*graph);
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllSubNodes();
+    std::vector<FixedResolutionGraph<int>::Leaf> leaves = fixed_graph.getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), leaves.size());
+    ASSERT_EQ(expected_nodes.size(), fixed_graph.getNumNodes());
+    for (size_t i = 0; i < leaves.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), leaves[i].coordinates);
+        EXPECT_EQ(expected_nodes[i]->getScale(), leaves[i].scale);
+        EXPECT_EQ(expected_nodes[i]->containedValue(), leaves[i].containedValue());
+    }
+}
+
+TEST_F(FixedResolutionGraphTest, constructor_rejects_wrong_resolution){
+    graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 3);
+    EXPECT_THROW(FixedResolutionGraph<int> fixed_graph(*graph),
+                 FixedResolutionGraph<int>::WrongResolutionException);
+}
+
+TEST_F(FixedResolutionGraphTest, toGraphNode_round_trip){
+    FixedResolutionGraph<int> fixed_graph(*graph);
+    std::shared_ptr<GraphNode<int>> copy = fixed_graph.toGraphNode();
+
+    EXPECT_EQ(graph->getScale(), copy->getScale());
+    EXPECT_EQ(graph->getCoordinates(), copy->getCoordinates());
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllSubNodes();
+    std::vector<std::shared_ptr<RealNode<int>>> nodes = copy->getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i]->getCoordinates());
+        EXPECT_EQ(expected_nodes[i]->getScale(), nodes[i]->getScale());
+        EXPECT_EQ(expected_nodes[i]->containedValue(), nodes[i]->containedValue());
+    }
+}
+
+TEST_F(FixedResolutionGraphTest, getClosestNodeToCoordinates){
+    FixedResolutionGraph<int> fixed_graph(*graph);
+
+    FixedResolutionGraph<int>::Leaf leaf = fixed_graph.getClosestNodeToCoordinates({6.5, 7.5});
+    EXPECT_EQ((Coordinates{6.25, 7.25}), leaf.coordinates);
+    EXPECT_EQ(0.75, leaf.scale);
+    EXPECT_EQ(3, leaf.depth);
+    EXPECT_EQ(graph->getNodeContainingCoordinates({6.5, 7.5})->containedValue(),
+              leaf.containedValue());
+
+    leaf = fixed_graph.getClosestNodeToCoordinates({2, 3});
+    EXPECT_EQ((Coordinates{1, 2}), leaf.coordinates);
+    EXPECT_EQ(3, leaf.scale);
+    EXPECT_EQ(1, leaf.depth);
+
+    // Outside the graph
+    leaf = fixed_graph.getClosestNodeToCoordinates({100, 100});
+    EXPECT_EQ((Coordinates{7, 8}), leaf.coordinates);
+}
+
+TEST_F(FixedResolutionGraphTest, changeResolutionOfClosestNode){
+    FixedResolutionGraph<int> fixed_graph(*graph);
+    fixed_graph.changeResolutionOfClosestNode({2, 3});
+    graph->changeResolutionOfClosestNode({2, 3}, 2);
+
+    EXPECT_EQ(graph->getAllSubNodes().size(), fixed_graph.getNumNodes());
+    FixedResolutionGraph<int>::Leaf leaf = fixed_graph.getClosestNodeToCoordinates({3, 4});
+    EXPECT_EQ((Coordinates{2.5, 3.5}), leaf.coordinates);
+    EXPECT_EQ(1.5, leaf.scale);
+    EXPECT_EQ(0, leaf.containedValue());
+}
+
+TEST_F(FixedResolutionGraphTest, getAllNodesInArea_matches_graph){
+    FixedResolutionGraph<int> fixed_graph(*graph);
+    Circle<int> circle(1.5, {6, 7});
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllNodesInArea(circle);
+    std::vector<FixedResolutionGraph<int>::Leaf> leaves = fixed_graph.getAllNodesInArea(circle);
+    ASSERT_EQ(expected_nodes.size(), leaves.size());
+    for (size_t i = 0; i < leaves.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), leaves[i].coordinates);
+        EXPECT_EQ(expected_nodes[i]->containedValue(), leaves[i].containedValue());
+    }
+}
+
+// Compares the time taken for point and area queries on a FixedResolutionGraph
+// to the time taken on the same graph made of GraphNodes
+TEST_F(FixedResolutionGraphTest, benchmark_against_graph_node){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(4);
+    Circle<int> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.005);
+    std::shared_ptr<GraphNode<int>> large_graph = graph_factory.createGraph();
+    FixedResolutionGraph<int> fixed_graph(*large_graph);
+
+    std::vector<Coordinates> points;
+    for (int i = 0; i < 200000; i++) {
+        double angle = i * 0.001;
+        points.push_back({4.1 + std::cos(angle), 3.9 + std::sin(angle)});
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    int graph_node_sum = 0;
+    for (auto& point : points) {
+        graph_node_sum += large_graph->getNodeContainingCoordinates(point)->containedValue();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto graph_node_lookup_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    int fixed_graph_sum = 0;
+    for (auto& point : points) {
+        fixed_graph_sum += fixed_graph.getClosestNodeToCoordinates(point).containedValue();
+    }
+    end = std::chrono::steady_clock::now();
+    auto fixed_graph_lookup_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    Circle<int> area(0.5, {3.6, 3.4});
+    begin = std::chrono::steady_clock::now();
+    size_t num_graph_node_nodes = large_graph->getAllNodesInArea(area).size();
+    end = std::chrono::steady_clock::now();
+    auto graph_node_area_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    size_t num_fixed_graph_nodes = fixed_graph.getAllNodesInArea(area).size();
+    end = std::chrono::steady_clock::now();
+    auto fixed_graph_area_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << fixed_graph.getNumNodes() << " nodes:" << std::endl
+              << "Time for " << points.size() << " point lookups with GraphNode (us) = "
+              << graph_node_lookup_time.count() << std::endl
+              << "Time for " << points.size() << " point lookups with FixedResolutionGraph (us) = "
+              << fixed_graph_lookup_time.count() << std::endl
+              << "Time for area query with GraphNode (us) = "
+              << graph_node_area_time.count() << std::endl
+              << "Time for area query with FixedResolutionGraph (us) = "
+              << fixed_graph_area_time.count() << std::endl;
+    EXPECT_EQ(graph_node_sum, fixed_graph_sum);
+    EXPECT_EQ(num_graph_node_nodes, num_fixed_graph_nodes);
+}
+
+}
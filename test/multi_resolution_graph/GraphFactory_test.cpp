@@ -61,6 +61,19 @@ TEST_F(GraphFactoryTest, setGraphScale_and_setGraphResolution) {
     EXPECT_EQ(generated_graph->getResolution(), 10);
 }
 
+// Test that nodes in areas are split into the set sub-node resolution
+TEST_F(GraphFactoryTest, setSubNodeResolution) {
+    GraphFactory<nullptr_t> graph_factory;
+    EXPECT_EQ(2, graph_factory.getSubNodeResolution());
+    graph_factory.setSubNodeResolution(3);
+    EXPECT_EQ(3, graph_factory.getSubNodeResolution());
+    Rectangle<nullptr_t> rectangle(0.1, 0.1, {0.2, 0.2});
+    graph_factory.setMaxScaleInArea(rectangle, 0.5);
+    std::shared_ptr<GraphNode<nullptr_t>> generated_graph = graph_factory.createGraph();
+
+    EXPECT_EQ(9, generated_graph->getAllSubNodes().size());
+}
+
 TEST_F(GraphFactoryTest, setMaxScaleAtPoint_0_0) {
     GraphFactory<nullptr_t> graph_factory;
     graph_factory.setGraphTopLevelResolution(2);
@@ -424,6 +437,189 @@ TEST_F(GraphFactoryTest, ubc_thunderbots_field_generation) {
               << std::endl;
 }
 
+// Test that coarsening a graph after the max scales change gives the same
+// graph as creating one from scratch with the new max scales
+TEST_F(GraphFactoryTest, coarsenGraph_matches_new_graph) {
+    GraphFactory<nullptr_t> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+
+    Circle<nullptr_t> circle(1, (Coordinates) {2, 2});
+    graph_factory.setMaxScaleInArea(circle, 0.2);
+    Rectangle<nullptr_t> rectangle(2, 1, (Coordinates) {5, 5});
+    graph_factory.setMaxScaleInArea(rectangle, 0.4);
+    std::shared_ptr<GraphNode<nullptr_t>> graph = graph_factory.createGraph();
+    size_t num_nodes_before_coarsening = graph->getAllSubNodes().size();
+
+    // Remove the circle, and make the rectangle coarser
+    graph_factory.clearMaxScales();
+    graph_factory.setMaxScaleInArea(rectangle, 1);
+    graph_factory.coarsenGraph(*graph);
+    std::shared_ptr<GraphNode<nullptr_t>> expected_graph = graph_factory.createGraph();
+
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> nodes = graph->getAllSubNodes();
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> expected_nodes =
+            expected_graph->getAllSubNodes();
+    EXPECT_LT(nodes.size(), num_nodes_before_coarsening);
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i]->getCoordinates());
+        EXPECT_EQ(expected_nodes[i]->getScale(), nodes[i]->getScale());
+    }
+}
+
+// Test that coarsening a graph keeps the nodes still required by the max scales
+TEST_F(GraphFactoryTest, coarsenGraph_keeps_required_nodes) {
+    GraphFactory<nullptr_t> graph_factory;
+    graph_factory.setGraphScale(4);
+    graph_factory.setGraphTopLevelResolution(2);
+
+    Rectangle<nullptr_t> rectangle(0.5, 0.5, (Coordinates) {0.25, 0.25});
+    graph_factory.setMaxScaleInArea(rectangle, 0.5);
+    std::shared_ptr<GraphNode<nullptr_t>> graph = graph_factory.createGraph();
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> nodes_before_coarsening =
+            graph->getAllSubNodes();
+
+    // Nothing has changed, so nothing should be merged
+    graph_factory.coarsenGraph(*graph);
+    EXPECT_EQ(nodes_before_coarsening, graph->getAllSubNodes());
+}
+
+// Test that updating a graph for moved areas gives the same graph as creating
+// one from scratch, without touching nodes outside of the moved areas
+TEST_F(GraphFactoryTest, updateGraph_moved_circle) {
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+
+    GraphFactory<int>::AreaScaleList old_areas = {
+            {std::make_shared<Circle<int>>(0.5, (Coordinates) {2, 2}), 0.2},
+            {std::make_shared<Rectangle<int>>(1, 1, (Coordinates) {6, 6}), 0.3},
+    };
+    for (auto const &area_and_scale : old_areas) {
+        graph_factory.setMaxScaleInArea(*area_and_scale.first, area_and_scale.second);
+    }
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+
+    // Remember a node near the rectangle, which shouldn't change
+    std::shared_ptr<RealNode<int>> unchanged_node = *graph->getClosestNodeToCoordinates({6, 6});
+    unchanged_node->containedValue() = 42;
+
+    // Move the circle
+    GraphFactory<int>::AreaScaleList new_areas = {
+            {std::make_shared<Circle<int>>(0.5, (Coordinates) {2.3, 1.9}), 0.2},
+            old_areas[1],
+    };
+    graph_factory.updateGraph(*graph, old_areas, new_areas);
+
+    // The factory keeps clones of the new areas, not the areas themselves
+    EXPECT_EQ(1, new_areas[0].first.use_count());
+
+    EXPECT_EQ(unchanged_node, *graph->getClosestNodeToCoordinates({6, 6}));
+    EXPECT_EQ(42, unchanged_node->containedValue());
+
+    // Build the same graph from scratch to compare against
+    GraphFactory<int> expected_graph_factory;
+    expected_graph_factory.setGraphScale(8);
+    expected_graph_factory.setGraphTopLevelResolution(2);
+    for (auto const &area_and_scale : new_areas) {
+        expected_graph_factory.setMaxScaleInArea(*area_and_scale.first, area_and_scale.second);
+    }
+    std::shared_ptr<GraphNode<int>> expected_graph = expected_graph_factory.createGraph();
+
+    std::vector<std::shared_ptr<RealNode<int>>> nodes = graph->getAllSubNodes();
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = expected_graph->getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i]->getCoordinates());
+        EXPECT_EQ(expected_nodes[i]->getScale(), nodes[i]->getScale());
+    }
+}
+
+// Checks that no RealNode in the graph shares an edge with a RealNode less than half its size
+void expectBalanced(GraphNode<int> &graph) {
+    for (auto &node : graph.getAllSubNodes()) {
+        std::vector<std::shared_ptr<RealNode<int>>> neighbours = node->getNeighbours();
+        EXPECT_LE(neighbours.size(), 8);
+        for (auto &neighbour : neighbours) {
+            EXPECT_GE(2 * neighbour->getScale(), node->getScale());
+        }
+    }
+}
+
+// Test that a balanced graph still has the requested scales, with no large
+// jumps in scale between neighbouring nodes
+TEST_F(GraphFactoryTest, createGraph_balanced) {
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<int> circle(0.01, {3.3, 4.1});
+    graph_factory.setMaxScaleInArea(circle, 0.01);
+    size_t num_unbalanced_nodes = graph_factory.createGraph()->getAllSubNodes().size();
+
+    graph_factory.setBalanced(true);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+
+    EXPECT_GT(graph->getAllSubNodes().size(), num_unbalanced_nodes);
+    EXPECT_LT(graph->getNodeContainingCoordinates({3.3, 4.1})->getScale(), 0.01);
+    expectBalanced(*graph);
+}
+
+// Test that balancing keeps the values of split nodes with a split policy
+TEST_F(GraphFactoryTest, balanceGraph_with_split) {
+    GraphFactory<int> graph_factory;
+    std::shared_ptr<GraphNode<int>> graph = std::make_shared<GraphNode<int>>(2, 8);
+    graph->getAllSubNodes()[1]->containedValue() = 7;
+    auto node = graph->getAllSubNodes()[0];
+    for (int i = 0; i < 4; i++) {
+        node = std::static_pointer_cast<GraphNode<int>>(node->convertToGraphNode(2))->getAllSubNodes()[3];
+    }
+
+    graph_factory.balanceGraph(*graph, [](RealNode<int> &node,
+                                          const std::vector<std::shared_ptr<RealNode<int>>> &new_nodes) {
+        for (auto &new_node : new_nodes) {
+            new_node->containedValue() = node.containedValue();
+        }
+    });
+
+    expectBalanced(*graph);
+    for (auto &node : graph->getAllSubNodes()) {
+        if (node->getCoordinates().x >= 4 && node->getCoordinates().y < 4) {
+            EXPECT_EQ(7, node->containedValue());
+        }
+    }
+}
+
+// Test that updating a balanced graph keeps it balanced, and at least as fine
+// as creating it from scratch
+TEST_F(GraphFactoryTest, updateGraph_balanced) {
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    graph_factory.setBalanced(true);
+    GraphFactory<int>::AreaScaleList old_areas = {
+            {std::make_shared<Circle<int>>(0.05, (Coordinates) {2, 2}), 0.02},
+    };
+    graph_factory.setMaxScaleInArea(*old_areas[0].first, old_areas[0].second);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+
+    GraphFactory<int>::AreaScaleList new_areas = {
+            {std::make_shared<Circle<int>>(0.05, (Coordinates) {5.1, 2.7}), 0.02},
+    };
+    graph_factory.updateGraph(*graph, old_areas, new_areas);
+    expectBalanced(*graph);
+
+    // Nodes split only to balance the old circle may be left behind, since
+    // only nodes within removed areas are merged
+    std::shared_ptr<GraphNode<int>> expected_graph = graph_factory.createGraph();
+    for (auto &node : graph->getAllSubNodes()) {
+        EXPECT_LE(node->getScale(),
+                  expected_graph->getNodeContainingCoordinates(node->getCenterCoordinates())->getScale());
+    }
+    EXPECT_TRUE(graph->getAllNodesInArea(*old_areas[0].first).size() <
+                graph->getAllNodesInArea(*new_areas[0].first).size());
+}
+
 // TODO: Scale back this test a bit so it runs in computationally feasible time
 // Test setting many Rectangles and Circles of very high resolution
 // over a very large graph
@@ -3,6 +3,12 @@
 #include "multi_resolution_graph/RealNode.h"
 #include "multi_resolution_graph/Area.h"
 #include "multi_resolution_graph/Rectangle.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
+#include "multi_resolution_graph/ValuePolicies.h"
+
+#include <thread>
+#include <chrono>
 
 // TODO: Some note about how intertwined GraphNode and RealNode  are (and hence the all the tests of both are)
 
@@ -27,6 +33,17 @@ TEST_F(GraphNodeTest, constructor_with_negative_scale){
     EXPECT_EQ(0.3, graphNode.getScale());
 }
 
+TEST_F(GraphNodeTest, constructor_with_coordinates){
+    auto graph_node = std::make_shared<GraphNode<int>>(2, 4, Coordinates{-3, 5});
+    EXPECT_EQ(2, graph_node->getResolution());
+    EXPECT_EQ(4, graph_node->getScale());
+    EXPECT_EQ((Coordinates{-3, 5}), graph_node->getCoordinates());
+
+    // Sub-nodes should be placed relative to the given coordinates
+    std::shared_ptr<RealNode<int>> node = graph_node->getClosestNodeToCoordinates({0, 8}).value();
+    EXPECT_EQ((Coordinates{-1, 7}), node->getCoordinates());
+}
+
 TEST_F(GraphNodeTest, constructor_with_parent){
     GraphNode<nullptr_t>* parent = new GraphNode<nullptr_t>(2, 1);
     GraphNode<nullptr_t> graphNode(3, parent);
@@ -513,6 +530,588 @@ TEST_F(GraphNodeTest, getAllNodesInArea_small_case){
     EXPECT_EQ(expected_nodes, found_nodes);
 }
 
+TEST_F(GraphNodeTest, getAllNodesAlongLine_horizontal_line){
+    GraphNode<int> graph_node(4,8);
+    std::vector<std::vector<std::shared_ptr<Node<int>>>> top_level_sub_nodes =
+            graph_node.getSubNodes();
+
+    // Expand the bottom left subnode
+    graph_node.changeResolutionOfNode(top_level_sub_nodes[0][0],2);
+    top_level_sub_nodes = graph_node.getSubNodes();
+    auto expanded_node = std::dynamic_pointer_cast<GraphNode<int>>(top_level_sub_nodes[0][0]);
+    ASSERT_NE(nullptr, expanded_node);
+    std::vector<std::vector<std::shared_ptr<Node<int>>>> expanded_node_sub_nodes =
+            expanded_node->getSubNodes();
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected = {
+            std::dynamic_pointer_cast<RealNode<int>>(expanded_node_sub_nodes[0][0]),
+            std::dynamic_pointer_cast<RealNode<int>>(expanded_node_sub_nodes[0][1]),
+            std::dynamic_pointer_cast<RealNode<int>>(top_level_sub_nodes[0][1]),
+            std::dynamic_pointer_cast<RealNode<int>>(top_level_sub_nodes[0][2]),
+            std::dynamic_pointer_cast<RealNode<int>>(top_level_sub_nodes[0][3]),
+    };
+    EXPECT_EQ(expected, graph_node.getAllNodesAlongLine({0.5,0.5}, {7.5,0.5}));
+
+    // Walking the same line backwards should give the same nodes in reverse
+    std::reverse(expected.begin(), expected.end());
+    EXPECT_EQ(expected, graph_node.getAllNodesAlongLine({7.5,0.5}, {0.5,0.5}));
+}
+
+TEST_F(GraphNodeTest, getAllNodesAlongLine_stops_at_stop_condition){
+    GraphNode<int> graph_node(4,8);
+    std::vector<std::vector<std::shared_ptr<Node<int>>>> top_level_sub_nodes =
+            graph_node.getSubNodes();
+
+    // Mark a node in the second row as "blocked"
+    auto blocked_node = std::dynamic_pointer_cast<RealNode<int>>(top_level_sub_nodes[2][1]);
+    blocked_node->containedValue() = 1;
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected = {
+            std::dynamic_pointer_cast<RealNode<int>>(top_level_sub_nodes[0][1]),
+            std::dynamic_pointer_cast<RealNode<int>>(top_level_sub_nodes[1][1]),
+            blocked_node,
+    };
+    std::vector<std::shared_ptr<RealNode<int>>> found_nodes =
+            graph_node.getAllNodesAlongLine({3,1}, {3,7}, [](int& value){
+                return value == 1;
+            });
+    EXPECT_EQ(expected, found_nodes);
+}
+
+TEST_F(GraphNodeTest, getAllNodesAlongLine_diagonal_line_crosses_adjacent_nodes){
+    GraphNode<nullptr_t> graph_node(4,8);
+    graph_node.changeResolutionOfClosestNode({2.5, 3.5}, 3);
+    graph_node.changeResolutionOfClosestNode({5.5, 4.5}, 2);
+
+    Coordinates start = {0.3, 0.1};
+    Coordinates end = {7.9, 6.3};
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> found_nodes =
+            graph_node.getAllNodesAlongLine(start, end);
+    ASSERT_LE(2, found_nodes.size());
+
+    // The first and last nodes should contain the ends of the line
+    EXPECT_EQ(*graph_node.getClosestNodeToCoordinates({0,0}), found_nodes.front());
+    EXPECT_EQ(*graph_node.getClosestNodeToCoordinates({6,6}), found_nodes.back());
+
+    // Every node should only be crossed once, and consecutive nodes should touch
+    for (size_t i = 1; i < found_nodes.size(); i++) {
+        Coordinates c1 = found_nodes[i-1]->getCoordinates();
+        Coordinates c2 = found_nodes[i]->getCoordinates();
+        double s1 = found_nodes[i-1]->getScale();
+        double s2 = found_nodes[i]->getScale();
+        EXPECT_LE(c2.x, c1.x + s1 + 1e-9);
+        EXPECT_LE(c1.x, c2.x + s2 + 1e-9);
+        EXPECT_LE(c2.y, c1.y + s1 + 1e-9);
+        EXPECT_LE(c1.y, c2.y + s2 + 1e-9);
+        for (size_t j = 0; j < i; j++) {
+            EXPECT_NE(found_nodes[j], found_nodes[i]);
+        }
+    }
+}
+
+TEST_F(GraphNodeTest, getAllNodesAlongLine_line_partially_outside_graph){
+    GraphNode<nullptr_t> graph_node(2,2);
+    std::vector<std::vector<std::shared_ptr<Node<nullptr_t>>>> sub_nodes =
+            graph_node.getSubNodes();
+
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> expected = {
+            std::dynamic_pointer_cast<RealNode<nullptr_t>>(sub_nodes[1][0]),
+            std::dynamic_pointer_cast<RealNode<nullptr_t>>(sub_nodes[1][1]),
+    };
+    EXPECT_EQ(expected, graph_node.getAllNodesAlongLine({-5,1.5}, {5,1.5}));
+
+    // A line entirely outside of the graph should not cross any nodes
+    EXPECT_EQ(0, graph_node.getAllNodesAlongLine({-5,3}, {5,3}).size());
+}
+
+TEST_F(GraphNodeTest, mergeSubNode_reduces_values){
+    GraphNode<int> graph_node(2,1);
+
+    // Expand a node twice over, and give all the new nodes a value
+    std::shared_ptr<Node<int>> expanded_node =
+            graph_node.changeResolutionOfNode(graph_node.getSubNodes()[0][1], 2);
+    auto expanded_graph_node = std::dynamic_pointer_cast<GraphNode<int>>(expanded_node);
+    expanded_graph_node->changeResolutionOfNode(expanded_graph_node->getSubNodes()[1][1], 3);
+    std::vector<std::shared_ptr<RealNode<int>>> nodes_to_merge = expanded_node->getAllSubNodes();
+    ASSERT_EQ(12, nodes_to_merge.size());
+    for (auto& node : nodes_to_merge) {
+        node->containedValue() = 2;
+    }
+
+    // Merge the expanded node back into a single node that holds the sum
+    // of all the merged nodes
+    std::shared_ptr<RealNode<int>> merged_node = graph_node.mergeSubNode(expanded_node,
+            [](const std::vector<std::shared_ptr<RealNode<int>>>& nodes) {
+                int sum = 0;
+                for (auto& node : nodes) {
+                    sum += node->containedValue();
+                }
+                return sum;
+            });
+
+    EXPECT_EQ(merged_node, graph_node.getSubNodes()[0][1]);
+    EXPECT_EQ(24, merged_node->containedValue());
+    EXPECT_EQ(0.5, merged_node->getScale());
+    Coordinates expected_coordinates = {0.5, 0};
+    EXPECT_EQ(expected_coordinates, merged_node->getCoordinates());
+    EXPECT_EQ(4, graph_node.getAllSubNodes().size());
+}
+
+TEST_F(GraphNodeTest, mergeSubNode_node_not_found){
+    GraphNode<nullptr_t> graph_node(2,1);
+    GraphNode<nullptr_t> other_graph_node(2,1);
+
+    EXPECT_THROW(graph_node.mergeSubNode(other_graph_node.getSubNodes()[0][0]),
+                 GraphNode<nullptr_t>::NodeNotFoundException);
+}
+
+TEST_F(GraphNodeTest, convertToRealNode){
+    GraphNode<nullptr_t> graph_node(2,1);
+    auto expanded_node = std::dynamic_pointer_cast<GraphNode<nullptr_t>>(
+            graph_node.changeResolutionOfNode(graph_node.getSubNodes()[1][1], 2));
+
+    std::shared_ptr<RealNode<nullptr_t>> real_node = expanded_node->convertToRealNode();
+
+    EXPECT_EQ(real_node, graph_node.getSubNodes()[1][1]);
+    EXPECT_EQ(4, graph_node.getAllSubNodes().size());
+
+    // The top level node has nothing to be merged into
+    EXPECT_THROW(graph_node.convertToRealNode(), GraphNode<nullptr_t>::NoParentException);
+}
+
+TEST_F(GraphNodeTest, freeze_caches_coordinates){
+    GraphNode<nullptr_t> graph_node(2,4);
+    graph_node.changeResolutionOfClosestNode({2,2}, 3);
+    graph_node.freeze();
+
+    // A fresh graph with the same layout that isn't frozen, to compare against
+    GraphNode<nullptr_t> expected_graph_node(2,4);
+    expected_graph_node.changeResolutionOfClosestNode({2,2}, 3);
+
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> nodes = graph_node.getAllSubNodes();
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> expected_nodes =
+            expected_graph_node.getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i]->getCoordinates());
+    }
+}
+
+// Stress test running queries from many threads at once on a frozen graph. This
+// should be run with ThreadSanitizer enabled (`cmake -DENABLE_TSAN=ON`) to check
+// that it is race free
+TEST_F(GraphNodeTest, freeze_allows_concurrent_queries){
+    // Build up the graph without querying it, so that none of the lazily
+    // computed state has been computed yet
+    auto graph = std::make_shared<GraphNode<nullptr_t>>(4, 8);
+    std::vector<std::shared_ptr<GraphNode<nullptr_t>>> graph_nodes = {graph};
+    for (int depth = 0; depth < 4; depth++) {
+        std::vector<std::shared_ptr<GraphNode<nullptr_t>>> new_graph_nodes;
+        for (auto& graph_node : graph_nodes) {
+            auto sub_nodes = graph_node->getSubNodes();
+            for (auto& sub_node : {sub_nodes[0][0], sub_nodes[1][1]}) {
+                new_graph_nodes.emplace_back(std::static_pointer_cast<GraphNode<nullptr_t>>(
+                        graph_node->changeResolutionOfNode(sub_node, 2)));
+            }
+        }
+        graph_nodes = new_graph_nodes;
+    }
+    graph->freeze();
+
+    std::vector<std::shared_ptr<RealNode<nullptr_t>>> all_nodes = graph->getAllSubNodes();
+    Rectangle<nullptr_t> area(2, 3, {2.5, 1.5});
+
+    // Every thread runs the same queries, so they should all get the same results
+    const int num_threads = 8;
+    std::vector<size_t> nodes_in_area(num_threads);
+    std::vector<size_t> num_neighbours(num_threads);
+    std::vector<size_t> nodes_along_line(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([&, i]() {
+            nodes_in_area[i] = graph->getAllNodesInArea(area).size();
+            for (size_t j = i; j < all_nodes.size(); j += num_threads) {
+                num_neighbours[i] += all_nodes[j]->getNeighbours().size();
+                all_nodes[j]->getCoordinates();
+            }
+            nodes_along_line[i] = graph->getAllNodesAlongLine({0.1, 0.2}, {7.9, 5.3}).size();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    size_t expected_num_neighbours = 0;
+    for (auto& node : all_nodes) {
+        expected_num_neighbours += node->getNeighbours().size();
+    }
+    size_t total_num_neighbours = 0;
+    for (int i = 0; i < num_threads; i++) {
+        EXPECT_EQ(graph->getAllNodesInArea(area).size(), nodes_in_area[i]);
+        EXPECT_EQ(graph->getAllNodesAlongLine({0.1, 0.2}, {7.9, 5.3}).size(), nodes_along_line[i]);
+        total_num_neighbours += num_neighbours[i];
+    }
+    EXPECT_EQ(expected_num_neighbours, total_num_neighbours);
+}
+
+TEST_F(GraphNodeTest, clone_copies_layout_and_values){
+    auto graph_node = std::make_shared<GraphNode<int>>(2,4);
+    graph_node->changeResolutionOfClosestNode({2,2}, 3);
+    graph_node->changeResolutionOfClosestNode({0,0}, 2);
+    int value = 0;
+    for (auto& node : graph_node->getAllSubNodes()) {
+        node->containedValue() = value++;
+    }
+
+    std::shared_ptr<GraphNode<int>> copy = graph_node->clone();
+
+    std::vector<std::shared_ptr<RealNode<int>>> nodes = graph_node->getAllSubNodes();
+    std::vector<std::shared_ptr<RealNode<int>>> copied_nodes = copy->getAllSubNodes();
+    ASSERT_EQ(nodes.size(), copied_nodes.size());
+    EXPECT_EQ(graph_node->getScale(), copy->getScale());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_NE(nodes[i], copied_nodes[i]);
+        EXPECT_EQ(nodes[i]->getCoordinates(), copied_nodes[i]->getCoordinates());
+        EXPECT_EQ(nodes[i]->getScale(), copied_nodes[i]->getScale());
+        EXPECT_EQ(nodes[i]->containedValue(), copied_nodes[i]->containedValue());
+    }
+}
+
+TEST_F(GraphNodeTest, clone_is_independent_of_original){
+    auto graph_node = std::make_shared<GraphNode<int>>(2,4);
+    graph_node->changeResolutionOfClosestNode({0,0}, 2);
+    std::shared_ptr<GraphNode<int>> copy = graph_node->clone();
+
+    // Changing the original should not change the copy
+    graph_node->changeResolutionOfClosestNode({3,3}, 2);
+    graph_node->getAllSubNodes()[0]->containedValue() = 5;
+    copy->getAllSubNodes()[0]->containedValue() = 3;
+    EXPECT_EQ(7, copy->getAllSubNodes().size());
+    EXPECT_EQ(5, graph_node->getAllSubNodes()[0]->containedValue());
+
+    // The copy should still work once the original is gone, and all the nodes
+    // in the copy should only refer to other nodes in the copy
+    graph_node.reset();
+    std::vector<std::shared_ptr<RealNode<int>>> copied_nodes = copy->getAllSubNodes();
+    for (auto& node : copied_nodes) {
+        for (auto& neighbour : node->getNeighbours()) {
+            EXPECT_NE(copied_nodes.end(),
+                      std::find(copied_nodes.begin(), copied_nodes.end(), neighbour));
+        }
+    }
+
+    // We should be able to modify the copy as usual
+    copy->changeResolutionOfClosestNode({3,3}, 2);
+    EXPECT_EQ(10, copy->getAllSubNodes().size());
+    EXPECT_EQ(3, copy->getAllSubNodes()[0]->containedValue());
+}
+
+// Compares the time taken to clone a graph to the time taken to build the
+// same graph with a GraphFactory
+TEST_F(GraphNodeTest, clone_benchmark_against_graph_factory){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(9);
+    graph_factory.setGraphTopLevelResolution(2);
+    for (double x = 1; x < 9; x += 1.5) {
+        for (double y = 1; y < 9; y += 2.5) {
+            Circle<int> circle(0.2, {x, y});
+            graph_factory.setMaxScaleInArea(circle, 0.02);
+        }
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto build_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    std::shared_ptr<GraphNode<int>> copy = graph->clone();
+    end = std::chrono::steady_clock::now();
+    auto clone_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    size_t num_nodes = graph->getAllSubNodes().size();
+    std::cout << "Graph with " << num_nodes << " nodes:" << std::endl
+              << "Time to build with GraphFactory (us) = " << build_time.count() << std::endl
+              << "Time to clone (us) = " << clone_time.count() << std::endl;
+    EXPECT_EQ(num_nodes, copy->getAllSubNodes().size());
+}
+
+
+TEST_F(GraphNodeTest, locational_index_matches_descent){
+    auto graph = std::make_shared<GraphNode<int>>(2, 8, Coordinates{1, 2});
+    auto bottom_left = std::static_pointer_cast<GraphNode<int>>(
+            graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2));
+    bottom_left->changeResolutionOfNode(bottom_left->getSubNodes()[1][0], 2);
+    graph->enableLocationalIndex();
+    EXPECT_TRUE(graph->hasLocationalIndex());
+    EXPECT_TRUE(bottom_left->hasLocationalIndex());
+
+    for (double x = 0.5; x < 10; x += 0.75) {
+        for (double y = 1.5; y < 11; y += 0.75) {
+            std::shared_ptr<RealNode<int>> node = graph->getNodeContainingCoordinates({x, y});
+            graph->disableLocationalIndex();
+            EXPECT_EQ(graph->getNodeContainingCoordinates({x, y}), node);
+            graph->enableLocationalIndex();
+        }
+    }
+
+    // The node containing the coordinates should actually contain them
+    std::shared_ptr<RealNode<int>> node = graph->getNodeContainingCoordinates({2.2, 4.9});
+    EXPECT_EQ((Coordinates{2, 4}), node->getCoordinates());
+    EXPECT_EQ(1, node->getScale());
+    node = graph->getNodeContainingCoordinates({7, 3});
+    EXPECT_EQ((Coordinates{5, 2}), node->getCoordinates());
+    EXPECT_EQ(4, node->getScale());
+}
+
+TEST_F(GraphNodeTest, getNodeAtCell){
+    auto graph = std::make_shared<GraphNode<int>>(2, 8);
+    auto top_right = graph->changeResolutionOfNode(graph->getSubNodes()[1][1], 2);
+
+    for (bool indexed : {false, true}) {
+        if (indexed) {
+            graph->enableLocationalIndex();
+        }
+        EXPECT_EQ(graph, graph->getNodeAtCell(0, 0, 0));
+        EXPECT_EQ(top_right, graph->getNodeAtCell(1, 1, 1));
+        EXPECT_EQ(graph->getSubNodes()[0][1], graph->getNodeAtCell(1, 1, 0));
+        EXPECT_EQ(std::static_pointer_cast<GraphNode<int>>(top_right)->getSubNodes()[0][1],
+                  graph->getNodeAtCell(2, 3, 2));
+        // Part of a larger node, and outside the graph
+        EXPECT_EQ(nullptr, graph->getNodeAtCell(2, 0, 0));
+        EXPECT_EQ(nullptr, graph->getNodeAtCell(1, 2, 0));
+    }
+}
+
+TEST_F(GraphNodeTest, locational_index_follows_changes){
+    auto graph = std::make_shared<GraphNode<int>>(2, 8);
+    graph->enableLocationalIndex();
+
+    // Splitting a node should add its sub-nodes to the index
+    auto sub_node = std::static_pointer_cast<GraphNode<int>>(
+            graph->changeResolutionOfNode(graph->getSubNodes()[1][1], 2));
+    EXPECT_EQ(sub_node, graph->getNodeAtCell(1, 1, 1));
+    EXPECT_EQ(sub_node->getSubNodes()[1][0], graph->getNodeAtCell(2, 2, 3));
+    EXPECT_EQ(sub_node->getSubNodes()[1][0], graph->getNodeContainingCoordinates({4.5, 7.5}));
+    sub_node->changeResolutionOfNode(sub_node->getSubNodes()[1][0], 2);
+    EXPECT_EQ((Coordinates{4, 7}), graph->getNodeContainingCoordinates({4.5, 7.5})->getCoordinates());
+
+    // Merging a node should remove everything below it from the index
+    std::shared_ptr<RealNode<int>> merged_node = sub_node->convertToRealNode();
+    EXPECT_EQ(merged_node, graph->getNodeAtCell(1, 1, 1));
+    EXPECT_EQ(nullptr, graph->getNodeAtCell(2, 2, 3));
+    EXPECT_EQ(nullptr, graph->getNodeAtCell(3, 4, 7));
+    EXPECT_EQ(merged_node, graph->getNodeContainingCoordinates({4.5, 7.5}));
+
+    // Only quadtrees can be indexed
+    EXPECT_THROW(graph->changeResolutionOfNode(merged_node, 3),
+                 GraphNode<int>::NotAQuadtreeException);
+    EXPECT_EQ(merged_node, graph->getSubNodes()[1][1]);
+    graph->disableLocationalIndex();
+    graph->changeResolutionOfNode(merged_node, 3);
+    EXPECT_THROW(graph->enableLocationalIndex(), GraphNode<int>::NotAQuadtreeException);
+    EXPECT_FALSE(graph->hasLocationalIndex());
+}
+
+// Compares the time taken to find the nodes containing many points in a deep
+// graph with and without a locational index
+TEST_F(GraphNodeTest, locational_index_benchmark){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<int> circle(0.5, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.002);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+
+    std::vector<Coordinates> points;
+    for (int i = 0; i < 200000; i++) {
+        double angle = i * 0.001;
+        points.push_back({4.1 + 0.5 * std::cos(angle), 3.9 + 0.5 * std::sin(angle)});
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<RealNode<int>>> found_by_descent;
+    for (auto& point : points) {
+        found_by_descent.emplace_back(graph->getNodeContainingCoordinates(point));
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto descent_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    graph->enableLocationalIndex();
+    begin = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<RealNode<int>>> found_by_index;
+    for (auto& point : points) {
+        found_by_index.emplace_back(graph->getNodeContainingCoordinates(point));
+    }
+    end = std::chrono::steady_clock::now();
+    auto index_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << graph->getAllSubNodes().size() << " nodes, "
+              << points.size() << " lookups:" << std::endl
+              << "Time by descent (us) = " << descent_time.count() << std::endl
+              << "Time by locational index (us) = " << index_time.count() << std::endl;
+    EXPECT_EQ(found_by_descent, found_by_index);
+}
+
+TEST_F(GraphNodeTest, getNodeType){
+    auto graph = std::make_shared<GraphNode<int>>(2, 8);
+    auto sub_node = graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2);
+
+    EXPECT_EQ(NodeType::GRAPH_NODE, graph->getNodeType());
+    EXPECT_EQ(NodeType::GRAPH_NODE, sub_node->getNodeType());
+    EXPECT_EQ(NodeType::REAL_NODE, graph->getSubNodes()[1][0]->getNodeType());
+    EXPECT_EQ(NodeType::GRAPH_NODE, graph->clone()->getSubNodes()[0][0]->getNodeType());
+    EXPECT_EQ(sub_node.get(), asGraphNode(sub_node.get()));
+    EXPECT_EQ(nullptr, asGraphNode(graph->getSubNodes()[1][0]));
+}
+
+// Times traversals of a large graph, which switch on the type of each node
+// instead of going through its virtual functions
+TEST_F(GraphNodeTest, traversal_benchmark){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<int> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.005);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+    graph->freeze();
+    Circle<int> area(0.8, {3.6, 3.4});
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    size_t num_nodes = graph->getAllSubNodes().size();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto all_nodes_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    size_t num_nodes_in_area = graph->getAllNodesInArea(area).size();
+    end = std::chrono::steady_clock::now();
+    auto area_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << num_nodes << " nodes:" << std::endl
+              << "Time to get all nodes (us) = " << all_nodes_time.count() << std::endl
+              << "Time to get " << num_nodes_in_area << " nodes in area (us) = "
+              << area_time.count() << std::endl;
+    EXPECT_LT(num_nodes_in_area, num_nodes);
+}
+
+TEST_F(GraphNodeTest, value_aggregates_follow_changes){
+    auto graph = std::make_shared<GraphNode<int>>(2, 4);
+    EXPECT_FALSE(graph->hasValueAggregates());
+    EXPECT_THROW(graph->getValueAggregate(), GraphNode<int>::NoValueAggregatesException);
+
+    std::vector<std::shared_ptr<RealNode<int>>> nodes = graph->getAllSubNodes();
+    for (int i = 0; i < 4; i++) {
+        nodes[i]->containedValue() = i + 1;
+    }
+    graph->enableValueAggregates([](const int &value) { return value; });
+    ASSERT_TRUE(graph->hasValueAggregates());
+    GraphNode<int>::ValueAggregate aggregate = graph->getValueAggregate();
+    EXPECT_EQ(1, aggregate.min);
+    EXPECT_EQ(4, aggregate.max);
+    EXPECT_EQ(10, aggregate.sum);
+    EXPECT_EQ(4, aggregate.count);
+
+    // Splits
+    auto split_node = std::static_pointer_cast<GraphNode<int>>(
+            nodes[3]->convertToGraphNode(2, ValuePolicies<int>::replicate()));
+    aggregate = graph->getValueAggregate();
+    EXPECT_EQ(22, aggregate.sum);
+    EXPECT_EQ(7, aggregate.count);
+    EXPECT_EQ(16, split_node->getValueAggregate().sum);
+
+    // Value writes
+    split_node->getAllSubNodes()[0]->setContainedValue(-5);
+    EXPECT_EQ(-5, split_node->getValueAggregate().min);
+    EXPECT_EQ(-5, graph->getValueAggregate().min);
+    EXPECT_EQ(13, graph->getValueAggregate().sum);
+
+    // Merges
+    split_node->convertToRealNode(ValuePolicies<int>::first());
+    aggregate = graph->getValueAggregate();
+    EXPECT_EQ(-5, aggregate.min);
+    EXPECT_EQ(3, aggregate.max);
+    EXPECT_EQ(1, aggregate.sum);
+    EXPECT_EQ(4, aggregate.count);
+
+    // Writes through `containedValue` need an explicit update
+    graph->getAllSubNodes()[0]->containedValue() = 100;
+    EXPECT_EQ(3, graph->getValueAggregate().max);
+    graph->updateValueAggregates();
+    EXPECT_EQ(100, graph->getValueAggregate().max);
+
+    graph->disableValueAggregates();
+    EXPECT_FALSE(graph->hasValueAggregates());
+}
+
+TEST_F(GraphNodeTest, getAllNodesWithValueBetween){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<int> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.1);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+    for (auto& node : graph->getAllSubNodes()) {
+        Coordinates coordinates = node->getCoordinates();
+        node->containedValue() = static_cast<int>(10 * coordinates.x);
+    }
+    graph->enableValueAggregates([](const int &value) { return value; });
+    Circle<int> area(1, {3, 4});
+
+    auto in_range = [](Node<int> &node) {
+        if (node.getNodeType() != NodeType::REAL_NODE) {
+            return true;
+        }
+        int value = static_cast<RealNode<int> &>(node).containedValue();
+        return value >= 30 && value <= 45;
+    };
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes =
+            graph->getAllNodesThatPassFilter(in_range, false, false);
+    ASSERT_FALSE(expected_nodes.empty());
+    EXPECT_EQ(expected_nodes, graph->getAllNodesWithValueBetween(30, 45));
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes_in_area;
+    for (auto& node : expected_nodes) {
+        if (area.overlapsNode(*node)) {
+            expected_nodes_in_area.push_back(node);
+        }
+    }
+    ASSERT_FALSE(expected_nodes_in_area.empty());
+    EXPECT_EQ(expected_nodes_in_area, graph->getAllNodesInAreaWithValueBetween(area, 30, 45));
+}
+
+TEST_F(GraphNodeTest, value_aggregates_benchmark){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<int> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.005);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+    for (auto& node : graph->getAllSubNodes()) {
+        node->containedValue() = node->getCoordinates().x > 4.5 ? 1 : 0;
+    }
+    graph->freeze();
+    graph->enableValueAggregates([](const int &value) { return value; });
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    size_t num_filtered_nodes = graph->getAllNodesThatPassFilter(
+            [](Node<int> &node) {
+                return node.getNodeType() != NodeType::REAL_NODE ||
+                       static_cast<RealNode<int> &>(node).containedValue() == 1;
+            }, false, false).size();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto filter_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    size_t num_aggregate_nodes = graph->getAllNodesWithValueBetween(1, 1).size();
+    end = std::chrono::steady_clock::now();
+    auto aggregate_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << graph->getValueAggregate().count << " nodes, getting "
+              << num_aggregate_nodes << " nodes by value:" << std::endl
+              << "Time checking every node (us) = " << filter_time.count() << std::endl
+              << "Time with value aggregates (us) = " << aggregate_time.count() << std::endl;
+    EXPECT_EQ(num_filtered_nodes, num_aggregate_nodes);
+}
 
 // TODO: Test conditions that would cause functions to throw exceptions (which GraphNode *DOES*)
 
@@ -0,0 +1,246 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/GraphSerializer.h"
+#include "multi_resolution_graph/GraphFactory.h"
+#include "multi_resolution_graph/Circle.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+// A stream buffer over a string that can't seek, like a pipe or a socket
+class UnseekableBuffer : public std::streambuf {
+public:
+    explicit UnseekableBuffer(std::string &data) {
+        setg(&data[0], &data[0], &data[0] + data.size());
+    }
+};
+
+class GraphSerializerTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph with the bottom left node split into 2x2 nodes, one of
+        // which is split again into 3x3 nodes
+        graph = std::make_shared<GraphNode<int>>(4, 8);
+        auto sub_node = graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2);
+        std::dynamic_pointer_cast<GraphNode<int>>(sub_node)->changeResolutionOfNode(
+                std::dynamic_pointer_cast<GraphNode<int>>(sub_node)->getSubNodes()[1][0], 3);
+        int value = 0;
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = value++;
+        }
+    }
+
+    // Checks that two graphs have the same layout and values
+    void expectSameGraph(GraphNode<int> &expected, GraphNode<int> &actual) {
+        EXPECT_EQ(expected.getScale(), actual.getScale());
+        EXPECT_EQ(expected.getCoordinates(), actual.getCoordinates());
+        std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = expected.getAllSubNodes();
+        std::vector<std::shared_ptr<RealNode<int>>> nodes = actual.getAllSubNodes();
+        ASSERT_EQ(expected_nodes.size(), nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++) {
+            EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i]->getCoordinates());
+            EXPECT_EQ(expected_nodes[i]->getScale(), nodes[i]->getScale());
+            EXPECT_EQ(expected_nodes[i]->containedValue(), nodes[i]->containedValue());
+        }
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(GraphSerializerTest, round_trip_preserves_graph){
+    std::stringstream stream;
+    GraphSerializer<int>::writeGraph(*graph, stream);
+    std::shared_ptr<GraphNode<int>> read_graph = GraphSerializer<int>::readGraph(stream);
+
+    expectSameGraph(*graph, *read_graph);
+}
+
+TEST_F(GraphSerializerTest, round_trip_graph_can_be_modified){
+    std::stringstream stream;
+    GraphSerializer<int>::writeGraph(*graph, stream);
+    std::shared_ptr<GraphNode<int>> read_graph = GraphSerializer<int>::readGraph(stream);
+
+    read_graph->changeResolutionOfClosestNode({7, 7}, 2);
+    graph->changeResolutionOfClosestNode({7, 7}, 2);
+    EXPECT_EQ(graph->getAllSubNodes().size(), read_graph->getAllSubNodes().size());
+    EXPECT_EQ(graph->getClosestNodeToCoordinates({7.5, 7.5}).value()->getCoordinates(),
+              read_graph->getClosestNodeToCoordinates({7.5, 7.5}).value()->getCoordinates());
+}
+
+TEST_F(GraphSerializerTest, written_size_is_compact){
+    std::stringstream stream;
+    GraphSerializer<int>::writeGraph(*graph, stream);
+
+    // 1 + 16 + 4 + 9 codes, and one value for each of the 27 RealNodes
+    size_t expected_size = sizeof(GraphSerializer<int>::Header) +
+                           30 * sizeof(uint32_t) + 27 * sizeof(int);
+    EXPECT_EQ(expected_size, stream.str().size());
+}
+
+TEST_F(GraphSerializerTest, read_rejects_invalid_data){
+    std::stringstream stream;
+    GraphSerializer<int>::writeGraph(*graph, stream);
+    std::string data = stream.str();
+
+    // Not a graph at all
+    std::stringstream garbage("this is not a graph, but it is long enough to be a header");
+    EXPECT_THROW(GraphSerializer<int>::readGraph(garbage),
+                 GraphSerializer<int>::InvalidGraphFormatException);
+
+    // Truncated
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_THROW(GraphSerializer<int>::readGraph(truncated),
+                 GraphSerializer<int>::InvalidGraphFormatException);
+
+    // Different value type
+    std::stringstream wrong_type(data);
+    EXPECT_THROW(GraphSerializer<double>::readGraph(wrong_type),
+                 GraphSerializer<double>::InvalidGraphFormatException);
+
+    // Newer version
+    std::string newer_version = data;
+    newer_version[offsetof(GraphSerializer<int>::Header, version)] = 2;
+    std::stringstream newer_version_stream(newer_version);
+    EXPECT_THROW(GraphSerializer<int>::readGraph(newer_version_stream),
+                 GraphSerializer<int>::InvalidGraphFormatException);
+
+    // Resolution code that does not match the number of nodes
+    std::string bad_layout = data;
+    bad_layout[sizeof(GraphSerializer<int>::Header)] = 5;
+    std::stringstream bad_layout_stream(bad_layout);
+    EXPECT_THROW(GraphSerializer<int>::readGraph(bad_layout_stream),
+                 GraphSerializer<int>::InvalidGraphFormatException);
+}
+
+TEST_F(GraphSerializerTest, read_rejects_corrupted_header){
+    using Serializer = GraphSerializer<int>;
+    std::stringstream stream;
+    Serializer::writeGraph(*graph, stream);
+    std::string data = stream.str();
+
+    // Header only
+    std::stringstream header_only(data.substr(0, sizeof(Serializer::Header)));
+    EXPECT_THROW(Serializer::readGraph(header_only), Serializer::InvalidGraphFormatException);
+
+    // Counts far larger than the data that follows, which must be rejected
+    // before a buffer of that size is allocated
+    for (uint64_t num_nodes : {uint64_t(1) << 40, std::numeric_limits<uint64_t>::max() / 2}) {
+        std::string huge_counts = data;
+        std::memcpy(&huge_counts[offsetof(Serializer::Header, num_nodes)], &num_nodes, sizeof(num_nodes));
+        std::memcpy(&huge_counts[offsetof(Serializer::Header, num_values)], &num_nodes, sizeof(num_nodes));
+        std::stringstream huge_counts_stream(huge_counts);
+        EXPECT_THROW(Serializer::readGraph(huge_counts_stream), Serializer::InvalidGraphFormatException);
+
+        // Even when the size of the stream can't be found up front
+        UnseekableBuffer buffer(huge_counts);
+        std::istream unseekable_stream(&buffer);
+        EXPECT_THROW(Serializer::readGraph(unseekable_stream), Serializer::InvalidGraphFormatException);
+    }
+
+    // A resolution code much larger than the number of nodes, which must be
+    // rejected before the sub nodes are allocated
+    std::string huge_resolution = data;
+    uint32_t code = std::numeric_limits<uint32_t>::max();
+    std::memcpy(&huge_resolution[sizeof(Serializer::Header)], &code, sizeof(code));
+    std::stringstream huge_resolution_stream(huge_resolution);
+    EXPECT_THROW(Serializer::readGraph(huge_resolution_stream), Serializer::InvalidGraphFormatException);
+
+    // A valid graph still reads from a stream that can't seek
+    UnseekableBuffer buffer(data);
+    std::istream unseekable_stream(&buffer);
+    std::shared_ptr<GraphNode<int>> read_graph = Serializer::readGraph(unseekable_stream);
+    expectSameGraph(*graph, *read_graph);
+}
+
+TEST_F(GraphSerializerTest, read_rejects_deeply_nested_nodes){
+    using Serializer = GraphSerializer<int>;
+    std::stringstream stream;
+    Serializer::writeGraph(*graph, stream);
+    std::string valid_header = stream.str().substr(0, sizeof(Serializer::Header));
+
+    // Builds a graph of GraphNodes with a resolution of 1, each nested in the
+    // last, optionally ending in a single RealNode
+    auto nested_graph = [&](uint64_t num_graph_nodes, bool ends_in_real_node) {
+        std::vector<uint32_t> codes(num_graph_nodes, 1);
+        if (ends_in_real_node) {
+            codes.push_back(0);
+        }
+        Serializer::Header header;
+        std::memcpy(&header, valid_header.data(), sizeof(header));
+        header.num_nodes = codes.size();
+        header.num_values = ends_in_real_node ? 1 : 0;
+        std::string data(reinterpret_cast<const char *>(&header), sizeof(header));
+        data.append(reinterpret_cast<const char *>(codes.data()), codes.size() * sizeof(uint32_t));
+        data.resize((data.size() + 7) / 8 * 8, '\0');
+        if (ends_in_real_node) {
+            int value = 7;
+            data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+        return data;
+    };
+
+    // As deep as is allowed
+    std::stringstream deepest(nested_graph(Serializer::MAX_DEPTH + 1, true));
+    std::shared_ptr<GraphNode<int>> read_graph = Serializer::readGraph(deepest);
+    ASSERT_EQ(1, read_graph->getAllSubNodes().size());
+    EXPECT_EQ(7, read_graph->getAllSubNodes()[0]->containedValue());
+
+    // One level too deep
+    std::stringstream too_deep(nested_graph(Serializer::MAX_DEPTH + 2, true));
+    EXPECT_THROW(Serializer::readGraph(too_deep), Serializer::InvalidGraphFormatException);
+
+    // Garbage that keeps nesting GraphNodes, and never ends
+    std::stringstream nested_garbage(nested_graph(1000000, false));
+    EXPECT_THROW(Serializer::readGraph(nested_garbage), Serializer::InvalidGraphFormatException);
+}
+
+// Compares the time taken to load a graph to the time taken to build the
+// same graph with a GraphFactory
+TEST_F(GraphSerializerTest, read_benchmark_against_graph_factory){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(9);
+    graph_factory.setGraphTopLevelResolution(2);
+    for (double x = 1; x < 9; x += 1.5) {
+        for (double y = 1; y < 9; y += 2.5) {
+            Circle<int> circle(0.2, {x, y});
+            graph_factory.setMaxScaleInArea(circle, 0.02);
+        }
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::shared_ptr<GraphNode<int>> built_graph = graph_factory.createGraph();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto build_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::stringstream stream;
+    GraphSerializer<int>::writeGraph(*built_graph, stream);
+
+    begin = std::chrono::steady_clock::now();
+    std::shared_ptr<GraphNode<int>> read_graph = GraphSerializer<int>::readGraph(stream);
+    end = std::chrono::steady_clock::now();
+    auto read_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    size_t num_nodes = built_graph->getAllSubNodes().size();
+    std::cout << "Graph with " << num_nodes << " nodes (" << stream.str().size()
+              << " bytes serialized):" << std::endl
+              << "Time to build with GraphFactory (us) = " << build_time.count() << std::endl
+              << "Time to read (us) = " << read_time.count() << std::endl;
+    EXPECT_EQ(num_nodes, read_graph->getAllSubNodes().size());
+}
+
+}
@@ -0,0 +1,191 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/LinearQuadtree.h"
+#include "multi_resolution_graph/LocationalCode.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/Rectangle.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class LinearQuadtreeTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // An 8x8 quadtree where the bottom left quadrant is split down to 1x1
+        // nodes, and the top right quadrant is split once
+        graph = std::make_shared<GraphNode<int>>(2, 8, Coordinates{1, 2});
+        auto bottom_left = std::static_pointer_cast<GraphNode<int>>(
+                graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2));
+        for (auto& row : bottom_left->getSubNodes()) {
+            for (auto& node : row) {
+                bottom_left->changeResolutionOfNode(node, 2);
+            }
+        }
+        graph->changeResolutionOfNode(graph->getSubNodes()[1][1], 2);
+        int value = 0;
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = value++;
+        }
+    }
+
+    // Checks if a list of leaves contains one at the given coordinates
+    static bool containsLeafAt(const std::vector<LinearQuadtree<int>::Leaf> &leaves,
+                               Coordinates coordinates) {
+        return std::any_of(leaves.begin(), leaves.end(), [&](auto &leaf) {
+            return leaf.coordinates == coordinates;
+        });
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(LinearQuadtreeTest, morton_code_arithmetic){
+    uint64_t code = encodeMorton(5, 9);
+    EXPECT_EQ(5, decodeMortonX(code));
+    EXPECT_EQ(9, decodeMortonY(code));
+    EXPECT_EQ(encodeMorton(8, 9), addMortonX(code, interleaveBits(3)));
+    EXPECT_EQ(encodeMorton(5, 16), addMortonY(code, interleaveBits(7) << 1));
+    EXPECT_EQ(encodeMorton(0, 9), subtractMortonX(code, interleaveBits(5)));
+    EXPECT_EQ(encodeMorton(5, 1), subtractMortonY(code, interleaveBits(8) << 1));
+}
+
+TEST_F(LinearQuadtreeTest, constructor_copies_graph){
+    LinearQuadtree<int> quadtree(*graph);
+
+    EXPECT_EQ(8, quadtree.getScale());
+    EXPECT_EQ((Coordinates{1, 2}), quadtree.getCoordinates());
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllSubNodes();
+    std::vector<LinearQuadtree<int>::Leaf> leaves = quadtree.getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), leaves.size());
+    ASSERT_EQ(expected_nodes.size(), quadtree.getNumNodes());
+    for (auto& expected_node : expected_nodes) {
+        auto leaf = std::find_if(leaves.begin(), leaves.end(), [&](auto &l) {
+            return l.coordinates == expected_node->getCoordinates();
+        });
+        ASSERT_NE(leaves.end(), leaf);
+        EXPECT_EQ(expected_node->getScale(), leaf->scale);
+        EXPECT_EQ(expected_node->containedValue(), leaf->containedValue());
+    }
+}
+
+TEST_F(LinearQuadtreeTest, toGraphNode_round_trip){
+    LinearQuadtree<int> quadtree(*graph);
+    std::shared_ptr<GraphNode<int>> copy = quadtree.toGraphNode();
+
+    EXPECT_EQ(graph->getScale(), copy->getScale());
+    EXPECT_EQ(graph->getCoordinates(), copy->getCoordinates());
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllSubNodes();
+    std::vector<std::shared_ptr<RealNode<int>>> nodes = copy->getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i]->getCoordinates());
+        EXPECT_EQ(expected_nodes[i]->getScale(), nodes[i]->getScale());
+        EXPECT_EQ(expected_nodes[i]->containedValue(), nodes[i]->containedValue());
+    }
+}
+
+TEST_F(LinearQuadtreeTest, constructor_rejects_non_quadtree){
+    GraphNode<int> graph_node(3, 9);
+    EXPECT_THROW(LinearQuadtree<int> quadtree(graph_node),
+                 LinearQuadtree<int>::NotAQuadtreeException);
+
+    graph->changeResolutionOfNode(graph->getSubNodes()[0][1], 3);
+    EXPECT_THROW(LinearQuadtree<int> quadtree(*graph),
+                 LinearQuadtree<int>::NotAQuadtreeException);
+}
+
+TEST_F(LinearQuadtreeTest, getClosestNodeToCoordinates){
+    LinearQuadtree<int> quadtree(*graph);
+
+    LinearQuadtree<int>::Leaf leaf = quadtree.getClosestNodeToCoordinates({3.5, 4.5});
+    EXPECT_EQ((Coordinates{3, 4}), leaf.coordinates);
+    EXPECT_EQ(1, leaf.scale);
+
+    leaf = quadtree.getClosestNodeToCoordinates({8, 3});
+    EXPECT_EQ((Coordinates{5, 2}), leaf.coordinates);
+    EXPECT_EQ(4, leaf.scale);
+
+    leaf = quadtree.getClosestNodeToCoordinates({7.5, 8.5});
+    EXPECT_EQ((Coordinates{7, 8}), leaf.coordinates);
+    EXPECT_EQ(2, leaf.scale);
+
+    // Outside the graph
+    leaf = quadtree.getClosestNodeToCoordinates({100, 100});
+    EXPECT_EQ((Coordinates{7, 8}), leaf.coordinates);
+    leaf = quadtree.getClosestNodeToCoordinates({-100, -100});
+    EXPECT_EQ((Coordinates{1, 2}), leaf.coordinates);
+}
+
+TEST_F(LinearQuadtreeTest, getAllNodesInArea_matches_graph){
+    LinearQuadtree<int> quadtree(*graph);
+    Circle<int> circle(1.5, {5, 6});
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllNodesInArea(circle);
+    std::vector<LinearQuadtree<int>::Leaf> leaves = quadtree.getAllNodesInArea(circle);
+    EXPECT_EQ(expected_nodes.size(), leaves.size());
+    for (auto& expected_node : expected_nodes) {
+        EXPECT_TRUE(containsLeafAt(leaves, expected_node->getCoordinates()));
+    }
+}
+
+TEST_F(LinearQuadtreeTest, getAllNodesInRectangle_matches_graph){
+    LinearQuadtree<int> quadtree(*graph);
+    Rectangle<int> rectangle(4.5, 1.5, {0.5, 3.5});
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes =
+            graph->getAllNodesInArea(rectangle);
+    std::vector<LinearQuadtree<int>::Leaf> leaves =
+            quadtree.getAllNodesInRectangle({0.5, 3.5}, {5, 5});
+    EXPECT_EQ(expected_nodes.size(), leaves.size());
+    for (auto& expected_node : expected_nodes) {
+        EXPECT_TRUE(containsLeafAt(leaves, expected_node->getCoordinates()));
+    }
+
+    // The results should be in Z-order
+    EXPECT_TRUE(std::is_sorted(leaves.begin(), leaves.end(),
+                               [](auto &a, auto &b) { return a.index < b.index; }));
+}
+
+TEST_F(LinearQuadtreeTest, getNeighbours_across_depths){
+    LinearQuadtree<int> quadtree(*graph);
+
+    // The 4x4 node at {5,2} borders the 4 1x1 nodes along the right of the
+    // bottom left quadrant, and the 2 2x2 nodes along the bottom of the top
+    // right quadrant
+    std::vector<LinearQuadtree<int>::Leaf> neighbours =
+            quadtree.getNeighbours(quadtree.getClosestNodeToCoordinates({6, 3}));
+    EXPECT_EQ(6, neighbours.size());
+    for (Coordinates expected : std::vector<Coordinates>{
+            {4, 2}, {4, 3}, {4, 4}, {4, 5}, {5, 6}, {7, 6}}) {
+        EXPECT_TRUE(containsLeafAt(neighbours, expected));
+    }
+
+    // The 1x1 node at {4,5} borders 2 1x1 nodes, the 4x4 node to the right
+    // and the 4x4 node above
+    neighbours = quadtree.getNeighbours(quadtree.getClosestNodeToCoordinates({4.5, 5.5}));
+    EXPECT_EQ(4, neighbours.size());
+    for (Coordinates expected : std::vector<Coordinates>{
+            {3, 5}, {4, 4}, {5, 2}, {1, 6}}) {
+        EXPECT_TRUE(containsLeafAt(neighbours, expected));
+    }
+
+    // The 1x1 node in the bottom left corner only has 2 neighbours
+    neighbours = quadtree.getNeighbours(quadtree.getClosestNodeToCoordinates({1, 2}));
+    EXPECT_EQ(2, neighbours.size());
+}
+
+TEST_F(LinearQuadtreeTest, values_can_be_changed){
+    LinearQuadtree<int> quadtree(*graph);
+    quadtree.getClosestNodeToCoordinates({8, 3}).containedValue() = 1000;
+    EXPECT_EQ(1000, quadtree.getClosestNodeToCoordinates({6, 5}).containedValue());
+}
+
+}
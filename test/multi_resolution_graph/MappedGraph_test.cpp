@@ -0,0 +1,203 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/MappedGraph.h"
+#include "multi_resolution_graph/Rectangle.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class MappedGraphTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph with the bottom left node split into 2x2 nodes, one of
+        // which is split again into 3x3 nodes
+        graph = std::make_shared<GraphNode<int>>(4, 8);
+        auto sub_node = std::dynamic_pointer_cast<GraphNode<int>>(
+                graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2));
+        sub_node->changeResolutionOfNode(sub_node->getSubNodes()[1][0], 3);
+        int value = 0;
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = value++;
+        }
+
+        file_path = testing::TempDir() + "MappedGraphTest.graph";
+        std::ofstream file(file_path, std::ios::binary);
+        MappedGraph<int>::writeGraph(*graph, file);
+    }
+
+    virtual void TearDown() {
+        std::remove(file_path.c_str());
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+    std::string file_path;
+};
+
+TEST_F(MappedGraphTest, mapped_graph_matches_original){
+    MappedGraph<int> mapped_graph(file_path);
+
+    EXPECT_EQ(graph->getScale(), mapped_graph.getScale());
+    EXPECT_EQ(graph->getCoordinates(), mapped_graph.getCoordinates());
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllSubNodes();
+    std::vector<MappedGraph<int>::Leaf> nodes = mapped_graph.getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i].coordinates);
+        EXPECT_EQ(expected_nodes[i]->getScale(), nodes[i].scale);
+        EXPECT_EQ(expected_nodes[i]->containedValue(), nodes[i].containedValue());
+    }
+}
+
+TEST_F(MappedGraphTest, getClosestNodeToCoordinates){
+    MappedGraph<int> mapped_graph(file_path);
+
+    // Inside the 3x3 nodes
+    MappedGraph<int>::Leaf node = mapped_graph.getClosestNodeToCoordinates({0.4, 1.4});
+    EXPECT_DOUBLE_EQ(1.0/3, node.coordinates.x);
+    EXPECT_DOUBLE_EQ(4.0/3, node.coordinates.y);
+    EXPECT_DOUBLE_EQ(1.0/3, node.scale);
+    EXPECT_EQ(graph->getClosestNodeToCoordinates({0.4, 1.4}).value()->containedValue(),
+              node.containedValue());
+
+    // Inside one of the top level nodes
+    node = mapped_graph.getClosestNodeToCoordinates({7.5, 3.5});
+    EXPECT_EQ((Coordinates{6, 2}), node.coordinates);
+    EXPECT_EQ(2, node.scale);
+
+    // Outside the graph
+    node = mapped_graph.getClosestNodeToCoordinates({-5, 100});
+    EXPECT_EQ((Coordinates{0, 6}), node.coordinates);
+}
+
+TEST_F(MappedGraphTest, getClosestNodeToCoordinatesThatPassesFilter){
+    MappedGraph<int> mapped_graph(file_path);
+
+    std::optional<MappedGraph<int>::Leaf> node =
+            mapped_graph.getClosestNodeToCoordinatesThatPassesFilter(
+                    {0, 0}, [](const MappedGraph<int>::Leaf &leaf) {
+                        return leaf.scale == 2;
+                    });
+    ASSERT_TRUE(node.has_value());
+    EXPECT_EQ((Coordinates{2, 0}), node->coordinates);
+
+    node = mapped_graph.getClosestNodeToCoordinatesThatPassesFilter(
+            {0, 0}, [](const MappedGraph<int>::Leaf &) { return false; });
+    EXPECT_FALSE(node.has_value());
+
+    // Matches checking every node in turn, from anywhere in or around the graph
+    auto has_odd_value = [](const MappedGraph<int>::Leaf &leaf) { return leaf.containedValue() % 2 == 1; };
+    std::vector<MappedGraph<int>::Leaf> all_nodes = mapped_graph.getAllSubNodes();
+    for (double x = -1; x <= 9; x += 0.7) {
+        for (double y = -1; y <= 9; y += 0.7) {
+            const MappedGraph<int>::Leaf *expected = nullptr;
+            for (auto& leaf : all_nodes) {
+                if (has_odd_value(leaf) && (!expected || distance(leaf.coordinates, {x, y}) <
+                                                         distance(expected->coordinates, {x, y}))) {
+                    expected = &leaf;
+                }
+            }
+            node = mapped_graph.getClosestNodeToCoordinatesThatPassesFilter({x, y}, has_odd_value);
+            ASSERT_TRUE(node.has_value());
+            EXPECT_EQ(expected->node_index, node->node_index);
+        }
+    }
+}
+
+TEST_F(MappedGraphTest, getAllNodesInArea){
+    MappedGraph<int> mapped_graph(file_path);
+    Rectangle<int> rectangle(2, 1, {0.5, 0.5});
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes =
+            graph->getAllNodesInArea(rectangle);
+    std::vector<MappedGraph<int>::Leaf> nodes = mapped_graph.getAllNodesInArea(rectangle);
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i].coordinates);
+    }
+}
+
+TEST_F(MappedGraphTest, getNeighbours){
+    MappedGraph<int> mapped_graph(file_path);
+
+    // The 1x1 node at {1,1} touches the 3 nodes of the 3x3 split along its
+    // left edge, the 1x1 node below it, and the 2x2 nodes above and to the right
+    // of it (but not the 2x2 node that only touches its top right corner)
+    MappedGraph<int>::Leaf node = mapped_graph.getClosestNodeToCoordinates({1.5, 1.5});
+    std::vector<MappedGraph<int>::Leaf> neighbours = mapped_graph.getNeighbours(node);
+    std::vector<Coordinates> neighbour_coordinates;
+    for (auto& neighbour : neighbours) {
+        neighbour_coordinates.emplace_back(neighbour.coordinates);
+    }
+    EXPECT_EQ(6, neighbours.size());
+    for (Coordinates expected : std::vector<Coordinates>{
+            {2.0/3, 1}, {2.0/3, 4.0/3}, {2.0/3, 5.0/3}, {1, 0}, {2, 0}, {0, 2}}) {
+        EXPECT_NE(neighbour_coordinates.end(),
+                  std::find_if(neighbour_coordinates.begin(), neighbour_coordinates.end(),
+                               [&](Coordinates c) {
+                                   return std::abs(c.x - expected.x) < 1e-9 &&
+                                          std::abs(c.y - expected.y) < 1e-9;
+                               }));
+    }
+}
+
+TEST_F(MappedGraphTest, view_over_memory){
+    std::stringstream stream;
+    MappedGraph<int>::writeGraph(*graph, stream);
+    std::string data = stream.str();
+
+    // Copy into 8 byte aligned memory
+    std::vector<uint64_t> buffer((data.size() + 7) / 8);
+    std::copy(data.begin(), data.end(), reinterpret_cast<char *>(buffer.data()));
+    MappedGraph<int> mapped_graph(buffer.data(), data.size());
+
+    EXPECT_EQ(graph->getAllSubNodes().size(), mapped_graph.getAllSubNodes().size());
+    EXPECT_EQ(graph->getClosestNodeToCoordinates({5, 5}).value()->containedValue(),
+              mapped_graph.getClosestNodeToCoordinates({5, 5}).containedValue());
+}
+
+TEST_F(MappedGraphTest, invalid_graphs_are_rejected){
+    std::stringstream stream;
+    MappedGraph<int>::writeGraph(*graph, stream);
+    std::string data = stream.str();
+    std::vector<uint64_t> buffer((data.size() + 7) / 8);
+    std::copy(data.begin(), data.end(), reinterpret_cast<char *>(buffer.data()));
+
+    // Truncated
+    EXPECT_THROW(MappedGraph<int>(buffer.data(), data.size() - 1),
+                 MappedGraph<int>::InvalidGraphFormatException);
+
+    // Different value type
+    EXPECT_THROW(MappedGraph<double>(buffer.data(), data.size()),
+                 MappedGraph<double>::InvalidGraphFormatException);
+
+    // Top level node claims to have more sub-nodes than there are
+    auto nodes = reinterpret_cast<MappedGraph<int>::FlatNode *>(
+            reinterpret_cast<char *>(buffer.data()) + sizeof(MappedGraph<int>::Header));
+    nodes[0].resolution = 100;
+    EXPECT_THROW(MappedGraph<int>(buffer.data(), data.size()),
+                 MappedGraph<int>::InvalidGraphFormatException);
+
+    // Sub-nodes before their parent
+    nodes[0].resolution = 4;
+    nodes[0].index = 0;
+    EXPECT_THROW(MappedGraph<int>(buffer.data(), data.size()),
+                 MappedGraph<int>::InvalidGraphFormatException);
+
+    // Missing file
+    EXPECT_THROW(MappedGraph<int>(file_path + ".missing"),
+                 MappedGraph<int>::MappingFailedException);
+}
+
+}
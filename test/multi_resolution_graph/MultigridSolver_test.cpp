@@ -0,0 +1,168 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/MultigridSolver.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class MultigridSolverTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // An 8x8 graph split evenly into 1x1 nodes, with the bottom left
+        // quadrant split again into 0.5x0.5 nodes
+        graph = std::make_shared<GraphNode<int>>(2, 8);
+        for (unsigned int i = 0; i < 2; i++) {
+            std::vector<std::shared_ptr<RealNode<int>>> nodes = graph->getAllSubNodes();
+            for (auto& node : nodes) {
+                node->convertToGraphNode(2);
+            }
+        }
+        for (auto& node : graph->getAllSubNodes()) {
+            Coordinates coordinates = node->getCoordinates();
+            if (coordinates.x < 4 && coordinates.y < 4) {
+                node->convertToGraphNode(2);
+            }
+        }
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(MultigridSolverTest, levels_follow_hierarchy){
+    ValueLayers<int> value_layers(*graph);
+    FiniteVolumeStencil<int> stencil(value_layers);
+    MultigridSolver<int> solver(stencil);
+
+    ASSERT_EQ(5, solver.getNumLevels());
+    EXPECT_EQ(48 + 64, solver.getNumCells(0));
+    EXPECT_EQ(64, solver.getNumCells(1));
+    EXPECT_EQ(16, solver.getNumCells(2));
+    EXPECT_EQ(4, solver.getNumCells(3));
+    EXPECT_EQ(1, solver.getNumCells(4));
+}
+
+TEST_F(MultigridSolverTest, solve_matches_jacobi){
+    ValueLayers<int> value_layers(*graph);
+    size_t source = value_layers.addLayer("source", 1);
+    size_t multigrid_solution = value_layers.addLayer("multigrid_solution");
+    size_t jacobi_solution = value_layers.addLayer("jacobi_solution");
+    FiniteVolumeStencil<int> stencil(value_layers);
+    MultigridSolver<int> solver(stencil);
+
+    unsigned int num_cycles = solver.solve(multigrid_solution, source, 1e-10, 100);
+    EXPECT_LT(num_cycles, 30);
+    EXPECT_LE(solver.getRelativeResidual(multigrid_solution, source), 1e-10);
+    unsigned int num_iterations = solver.solveWithJacobi(jacobi_solution, source, 1e-10, 100000);
+    EXPECT_LE(solver.getRelativeResidual(jacobi_solution, source), 1e-10);
+    EXPECT_GT(num_iterations, 10 * num_cycles);
+
+    for (auto& node : value_layers.getLeaves()) {
+        double value = value_layers.getValue(multigrid_solution, *node);
+        EXPECT_NEAR(value_layers.getValue(jacobi_solution, *node), value, 1e-6);
+        EXPECT_GT(value, 0);
+    }
+}
+
+TEST_F(MultigridSolverTest, solve_is_symmetric){
+    // On an even graph, a uniform source gives a solution that is symmetric
+    // about the middle of the graph
+    graph = std::make_shared<GraphNode<int>>(2, 8);
+    for (unsigned int i = 0; i < 3; i++) {
+        std::vector<std::shared_ptr<RealNode<int>>> nodes = graph->getAllSubNodes();
+        for (auto& node : nodes) {
+            node->convertToGraphNode(2);
+        }
+    }
+    ValueLayers<int> value_layers(*graph);
+    size_t source = value_layers.addLayer("source", 1);
+    size_t solution = value_layers.addLayer("solution");
+    FiniteVolumeStencil<int> stencil(value_layers);
+    MultigridSolver<int> solver(stencil);
+
+    solver.solve(solution, source, 1e-10, 100);
+    for (auto& node : value_layers.getLeaves()) {
+        Coordinates center = node->getCenterCoordinates();
+        std::shared_ptr<RealNode<int>> mirror = graph->getNodeContainingCoordinates({8 - center.x, center.y});
+        EXPECT_NEAR(value_layers.getValue(solution, *mirror), value_layers.getValue(solution, *node), 1e-8);
+        mirror = graph->getNodeContainingCoordinates({center.y, center.x});
+        EXPECT_NEAR(value_layers.getValue(solution, *mirror), value_layers.getValue(solution, *node), 1e-8);
+    }
+}
+
+TEST_F(MultigridSolverTest, update_after_split){
+    ValueLayers<int> value_layers(*graph);
+    size_t source = value_layers.addLayer("source", 1);
+    size_t solution = value_layers.addLayer("solution");
+    FiniteVolumeStencil<int> stencil(value_layers);
+    MultigridSolver<int> solver(stencil);
+    graph->getAllSubNodes().back()->convertToGraphNode(2);
+
+    stencil.update();
+    solver.update();
+    EXPECT_EQ(48 + 64 + 3, solver.getNumCells(0));
+    solver.solve(solution, source, 1e-8, 100);
+    EXPECT_LE(solver.getRelativeResidual(solution, source), 1e-8);
+}
+
+// Compares the time to reduce the residual of a Poisson problem with
+// multigrid, and with Jacobi on the finest level alone
+TEST_F(MultigridSolverTest, solve_benchmark){
+    GraphFactory<double> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<double> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.02);
+    graph_factory.setBalanced(true);
+    std::shared_ptr<GraphNode<double>> large_graph = graph_factory.createGraph();
+    ValueLayers<double> value_layers(*large_graph);
+    size_t source = value_layers.addLayer("source");
+    size_t multigrid_solution = value_layers.addLayer("multigrid_solution");
+    size_t jacobi_solution = value_layers.addLayer("jacobi_solution");
+    const std::vector<std::shared_ptr<RealNode<double>>> &leaves = value_layers.getLeaves();
+    for (size_t leaf = 0; leaf < leaves.size(); leaf++) {
+        Coordinates center = leaves[leaf]->getCenterCoordinates();
+        if (std::hypot(center.x - 4.1, center.y - 3.9) < 1) {
+            value_layers.getLayer(source)[leaf] = 1;
+        }
+    }
+    const double tolerance = 1e-6;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    FiniteVolumeStencil<double> stencil(value_layers);
+    MultigridSolver<double> solver(stencil);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto build_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    unsigned int num_cycles = solver.solve(multigrid_solution, source, tolerance, 100);
+    end = std::chrono::steady_clock::now();
+    auto multigrid_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    unsigned int num_iterations = solver.solveWithJacobi(jacobi_solution, source, tolerance, 5000);
+    end = std::chrono::steady_clock::now();
+    auto jacobi_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << leaves.size() << " nodes, " << solver.getNumLevels() << " levels:" << std::endl
+              << "Time to build stencil and levels (us) = " << build_time.count() << std::endl
+              << "Multigrid: " << num_cycles << " V-cycles, relative residual "
+              << solver.getRelativeResidual(multigrid_solution, source)
+              << ", time (us) = " << multigrid_time.count() << std::endl
+              << "Jacobi: " << num_iterations << " iterations, relative residual "
+              << solver.getRelativeResidual(jacobi_solution, source)
+              << ", time (us) = " << jacobi_time.count() << std::endl;
+    EXPECT_LE(solver.getRelativeResidual(multigrid_solution, source), tolerance);
+}
+
+}
@@ -0,0 +1,86 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/PathSmoother.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class PathSmootherTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        graph = std::make_shared<GraphNode<int>>(4, 4);
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = 0;
+        }
+    }
+
+    // Gets the RealNode at the given column and row of the top level of the graph
+    std::shared_ptr<RealNode<int>> node(int col, int row) {
+        return std::dynamic_pointer_cast<RealNode<int>>(graph->getSubNodes()[row][col]);
+    }
+
+    // A 4x4 graph with 1x1 nodes
+    std::shared_ptr<GraphNode<int>> graph;
+
+    // Nodes with a value of 1 are blocked
+    std::function<bool(int&)> is_blocked = [](int& value) { return value == 1; };
+};
+
+TEST_F(PathSmootherTest, smoothPath_no_obstacles){
+    PathSmoother<int> path_smoother(graph, is_blocked);
+
+    std::vector<std::shared_ptr<RealNode<int>>> path = {
+            node(0,0), node(1,0), node(2,0), node(3,0), node(3,1), node(3,2), node(3,3)
+    };
+
+    // With nothing in the way, we can go straight from the start to the end
+    std::vector<std::shared_ptr<RealNode<int>>> expected = {node(0,0), node(3,3)};
+    EXPECT_EQ(expected, path_smoother.smoothPath(path));
+}
+
+TEST_F(PathSmootherTest, smoothPath_around_obstacle){
+    // Block off the center of the graph
+    node(1,1)->containedValue() = 1;
+    node(2,1)->containedValue() = 1;
+    node(1,2)->containedValue() = 1;
+    node(2,2)->containedValue() = 1;
+    PathSmoother<int> path_smoother(graph, is_blocked);
+
+    std::vector<std::shared_ptr<RealNode<int>>> path = {
+            node(0,0), node(1,0), node(2,0), node(3,0), node(3,1), node(3,2), node(3,3)
+    };
+
+    // We should only have to keep the corner we turn around
+    std::vector<std::shared_ptr<RealNode<int>>> expected = {
+            node(0,0), node(3,0), node(3,3)
+    };
+    EXPECT_EQ(expected, path_smoother.smoothPath(path));
+}
+
+TEST_F(PathSmootherTest, smoothPath_short_paths_unchanged){
+    PathSmoother<int> path_smoother(graph, is_blocked);
+
+    std::vector<std::shared_ptr<RealNode<int>>> path = {node(0,0), node(1,0)};
+    EXPECT_EQ(path, path_smoother.smoothPath(path));
+
+    path = {};
+    EXPECT_EQ(path, path_smoother.smoothPath(path));
+}
+
+TEST_F(PathSmootherTest, hasLineOfSight){
+    node(2,0)->containedValue() = 1;
+    PathSmoother<int> path_smoother(graph, is_blocked);
+
+    EXPECT_TRUE(path_smoother.hasLineOfSight({0.5,0.5}, {1.5,0.5}));
+    EXPECT_FALSE(path_smoother.hasLineOfSight({0.5,0.5}, {3.5,0.5}));
+    EXPECT_TRUE(path_smoother.hasLineOfSight({0.5,1.5}, {3.5,1.5}));
+}
+
+}
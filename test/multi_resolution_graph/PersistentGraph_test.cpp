@@ -0,0 +1,152 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/PersistentGraph.h"
+#include "multi_resolution_graph/Area.h"
+#include "multi_resolution_graph/Rectangle.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+// An area that only overrides `overlapsNode`, as Areas written before
+// `overlapsSquare` existed do: every node with its bottom left corner left of x
+template <typename T>
+class LeftOf : public Area<T> {
+public:
+    explicit LeftOf(double x) : x(x) {}
+
+    bool overlapsNode(Node<T> &node) override {
+        return node.getCoordinates().x < x;
+    }
+
+    std::shared_ptr<Area<T>> clone() const override {
+        return std::make_shared<LeftOf<T>>(*this);
+    }
+
+private:
+    double x;
+};
+
+class PersistentGraphTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph with the bottom left node split into 2x2 nodes
+        graph = std::make_shared<GraphNode<int>>(4, 8);
+        graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2);
+        int value = 0;
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = value++;
+        }
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(PersistentGraphTest, constructor_copies_graph){
+    PersistentGraph<int> persistent_graph(*graph);
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllSubNodes();
+    std::vector<PersistentGraph<int>::Leaf> nodes = persistent_graph.getAllSubNodes();
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i].coordinates);
+        EXPECT_EQ(expected_nodes[i]->getScale(), nodes[i].scale);
+        EXPECT_EQ(expected_nodes[i]->containedValue(), nodes[i].containedValue());
+    }
+}
+
+TEST_F(PersistentGraphTest, getNodeAtCoordinates){
+    PersistentGraph<int> persistent_graph(*graph);
+
+    PersistentGraph<int>::Leaf leaf = persistent_graph.getNodeAtCoordinates({1.5, 0.5});
+    Coordinates expected_coordinates = {1, 0};
+    EXPECT_EQ(expected_coordinates, leaf.coordinates);
+    EXPECT_EQ(1, leaf.scale);
+
+    leaf = persistent_graph.getNodeAtCoordinates({7.5, 3});
+    expected_coordinates = {6, 2};
+    EXPECT_EQ(expected_coordinates, leaf.coordinates);
+    EXPECT_EQ(2, leaf.scale);
+
+    // Coordinates outside the graph should give the closest node
+    leaf = persistent_graph.getNodeAtCoordinates({100, -100});
+    expected_coordinates = {6, 0};
+    EXPECT_EQ(expected_coordinates, leaf.coordinates);
+}
+
+TEST_F(PersistentGraphTest, getAllNodesInArea_matches_graph){
+    PersistentGraph<int> persistent_graph(*graph);
+    Rectangle<int> area(3, 2, {0.5, 0.5});
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllNodesInArea(area);
+    std::vector<PersistentGraph<int>::Leaf> nodes = persistent_graph.getAllNodesInArea(area);
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i].coordinates);
+    }
+}
+
+TEST_F(PersistentGraphTest, getAllNodesInArea_with_area_only_overriding_overlapsNode){
+    PersistentGraph<int> persistent_graph(*graph);
+    LeftOf<int> area(1.5);
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes = graph->getAllNodesInArea(area);
+    std::vector<PersistentGraph<int>::Leaf> nodes = persistent_graph.getAllNodesInArea(area);
+    ASSERT_EQ(7, nodes.size());
+    ASSERT_EQ(expected_nodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(expected_nodes[i]->getCoordinates(), nodes[i].coordinates);
+    }
+}
+
+TEST_F(PersistentGraphTest, setValueAtCoordinates_shares_untouched_nodes){
+    PersistentGraph<int> old_version(*graph);
+    PersistentGraph<int> new_version = old_version.setValueAtCoordinates({0.5, 1.5}, 100);
+
+    // Only the new version should see the new value
+    EXPECT_EQ(100, new_version.getNodeAtCoordinates({0.5, 1.5}).containedValue());
+    EXPECT_EQ(2, old_version.getNodeAtCoordinates({0.5, 1.5}).containedValue());
+
+    // Every node not on the path to the changed node should be shared
+    EXPECT_NE(old_version.getRootNode(), new_version.getRootNode());
+    EXPECT_NE(old_version.getRootNode()->sub_nodes[0], new_version.getRootNode()->sub_nodes[0]);
+    for (size_t i = 1; i < old_version.getRootNode()->sub_nodes.size(); i++) {
+        EXPECT_EQ(old_version.getRootNode()->sub_nodes[i], new_version.getRootNode()->sub_nodes[i]);
+    }
+}
+
+TEST_F(PersistentGraphTest, changeResolutionOfNodeAtCoordinates){
+    PersistentGraph<int> old_version(*graph);
+    PersistentGraph<int> new_version =
+            old_version.changeResolutionOfNodeAtCoordinates({5, 5}, 3);
+
+    EXPECT_EQ(19, old_version.getAllSubNodes().size());
+    EXPECT_EQ(27, new_version.getAllSubNodes().size());
+
+    PersistentGraph<int>::Leaf leaf = new_version.getNodeAtCoordinates({5, 5});
+    EXPECT_DOUBLE_EQ(2.0 / 3, leaf.scale);
+    EXPECT_EQ(2, old_version.getNodeAtCoordinates({5, 5}).scale);
+}
+
+TEST_F(PersistentGraphTest, old_versions_freed_when_dropped){
+    auto old_version = std::make_shared<PersistentGraph<int>>(*graph);
+    PersistentGraph<int> new_version = old_version->setValueAtCoordinates({5, 5}, 100);
+
+    std::weak_ptr<const PersistentGraph<int>::PersistentNode> old_root = old_version->getRootNode();
+    std::weak_ptr<const PersistentGraph<int>::PersistentNode> old_leaf =
+            old_version->getNodeAtCoordinates({5, 5}).node;
+    old_version.reset();
+
+    // The nodes only in the old version should be gone, but shared ones kept
+    EXPECT_TRUE(old_root.expired());
+    EXPECT_TRUE(old_leaf.expired());
+    EXPECT_EQ(0, new_version.getNodeAtCoordinates({0, 0}).containedValue());
+}
+
+}
@@ -2,10 +2,17 @@
 #include <gtest/gtest.h>
 
 // C++ STD Includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <set>
+#include <vector>
 
 // Thunderbots Includes
 #include "multi_resolution_graph/RealNode.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
 
 using namespace multi_resolution_graph;
 
@@ -20,6 +27,31 @@ class RealNodeTest : public testing::Test {
 protected:
     virtual void SetUp() {
     }
+
+    // Checks the neighbours of every node in a graph against every node that
+    // shares (part of) an edge with it
+    static void expectNeighboursMatchEdges(GraphNode<int> &graph) {
+        std::vector<std::shared_ptr<RealNode<int>>> all_nodes = graph.getAllSubNodes();
+        for (auto& node : all_nodes) {
+            Coordinates coordinates = node->getCoordinates();
+            double scale = node->getScale();
+            std::set<std::shared_ptr<RealNode<int>>> expected;
+            for (auto& other : all_nodes) {
+                Coordinates other_coordinates = other->getCoordinates();
+                double x_overlap = std::min(coordinates.x + scale, other_coordinates.x + other->getScale()) -
+                                   std::max(coordinates.x, other_coordinates.x);
+                double y_overlap = std::min(coordinates.y + scale, other_coordinates.y + other->getScale()) -
+                                   std::max(coordinates.y, other_coordinates.y);
+                if (other != node && x_overlap > -1e-9 && y_overlap > -1e-9 &&
+                    (x_overlap > 1e-9 || y_overlap > 1e-9)) {
+                    expected.insert(other);
+                }
+            }
+            std::vector<std::shared_ptr<RealNode<int>>> neighbours = node->getNeighbours();
+            EXPECT_EQ(expected.size(), neighbours.size());
+            EXPECT_EQ(expected, std::set<std::shared_ptr<RealNode<int>>>(neighbours.begin(), neighbours.end()));
+        }
+    }
 };
 
 // TODO: Larger test case
@@ -109,6 +141,128 @@ TEST_F(RealNodeTest, getNeighbours_small_case){
 
 }
 
+TEST_F(RealNodeTest, getNeighbours_includes_all_smaller_nodes){
+    // A 4x4 quadtree where the bottom left quadrant is split, and its top right
+    // quadrant is split again
+    auto graph = std::make_shared<GraphNode<int>>(2, 4);
+    auto bottom_left = std::static_pointer_cast<GraphNode<int>>(
+            graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2));
+    auto split = std::static_pointer_cast<GraphNode<int>>(
+            bottom_left->changeResolutionOfNode(bottom_left->getSubNodes()[1][1], 2));
+
+    for (bool indexed : {false, true}) {
+        if (indexed) {
+            graph->enableLocationalIndex();
+        }
+
+        // The top left quadrant borders 3 nodes along its bottom edge, and the
+        // top right quadrant
+        auto top_left = std::static_pointer_cast<RealNode<int>>(graph->getSubNodes()[1][0]);
+        std::vector<std::shared_ptr<RealNode<int>>> expected = {
+                std::static_pointer_cast<RealNode<int>>(bottom_left->getSubNodes()[1][0]),
+                std::static_pointer_cast<RealNode<int>>(split->getSubNodes()[1][0]),
+                std::static_pointer_cast<RealNode<int>>(split->getSubNodes()[1][1]),
+                std::static_pointer_cast<RealNode<int>>(graph->getSubNodes()[1][1]),
+        };
+        EXPECT_EQ(expected, top_left->getNeighbours());
+
+        // The smallest node in the top right corner of the bottom left quadrant
+        // borders 2 smallest nodes, and the 2 large quadrants next to it
+        auto smallest = std::static_pointer_cast<RealNode<int>>(split->getSubNodes()[1][1]);
+        expected = {
+                std::static_pointer_cast<RealNode<int>>(split->getSubNodes()[0][1]),
+                std::static_pointer_cast<RealNode<int>>(graph->getSubNodes()[1][0]),
+                std::static_pointer_cast<RealNode<int>>(split->getSubNodes()[1][0]),
+                std::static_pointer_cast<RealNode<int>>(graph->getSubNodes()[0][1]),
+        };
+        EXPECT_EQ(expected, smallest->getNeighbours());
+    }
+}
+
+TEST_F(RealNodeTest, getNeighbours_not_a_quadtree){
+    // A 3x3 graph with the center split into 2x2, and the node to the right of
+    // that split into 3x3
+    auto graph = std::make_shared<GraphNode<int>>(3, 3);
+    auto center = std::static_pointer_cast<GraphNode<int>>(
+            graph->changeResolutionOfNode(graph->getSubNodes()[1][1], 2));
+    auto right = std::static_pointer_cast<GraphNode<int>>(
+            graph->changeResolutionOfNode(graph->getSubNodes()[1][2], 3));
+
+    // The bottom right node in the center borders 2 nodes of its own parent,
+    // the node below the center, and 2 nodes in the split node to the right
+    auto node = std::static_pointer_cast<RealNode<int>>(center->getSubNodes()[0][1]);
+    std::vector<std::shared_ptr<RealNode<int>>> expected = {
+            std::static_pointer_cast<RealNode<int>>(graph->getSubNodes()[0][1]),
+            std::static_pointer_cast<RealNode<int>>(center->getSubNodes()[1][1]),
+            std::static_pointer_cast<RealNode<int>>(center->getSubNodes()[0][0]),
+            std::static_pointer_cast<RealNode<int>>(right->getSubNodes()[0][0]),
+            std::static_pointer_cast<RealNode<int>>(right->getSubNodes()[1][0]),
+    };
+    EXPECT_EQ(expected, node->getNeighbours());
+}
+
+TEST_F(RealNodeTest, getNeighbours_quadtree_below_top_level_of_1){
+    // The default top level resolution of a GraphFactory is 1, with quadtrees
+    // below it
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(4);
+    Circle<int> circle(0.5, {1.3, 2.2});
+    graph_factory.setMaxScaleInArea(circle, 0.1);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+    ASSERT_EQ(1, graph->getResolution());
+
+    expectNeighboursMatchEdges(*graph);
+}
+
+TEST_F(RealNodeTest, getNeighbours_quadtrees_below_top_level_of_3){
+    // A 3x3 graph with quadtrees of different depths below it
+    auto graph = std::make_shared<GraphNode<int>>(3, 6);
+    for (unsigned int i = 0; i < 3; i++) {
+        for (auto& node : graph->getAllSubNodes()) {
+            Coordinates center = node->getCenterCoordinates();
+            if (std::hypot(center.x - 2.6, center.y - 3.4) < 2.0 / (i + 1)) {
+                node->convertToGraphNode(2);
+            }
+        }
+    }
+
+    expectNeighboursMatchEdges(*graph);
+}
+
+// Times finding the neighbours of every node in a quadtree, with and
+// without a locational index
+TEST_F(RealNodeTest, getNeighbours_benchmark){
+    GraphFactory<int> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<int> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.01);
+    std::shared_ptr<GraphNode<int>> graph = graph_factory.createGraph();
+    std::vector<std::shared_ptr<RealNode<int>>> all_nodes = graph->getAllSubNodes();
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    size_t num_neighbours = 0;
+    for (auto& node : all_nodes) {
+        num_neighbours += node->getNeighbours().size();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto walk_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    graph->enableLocationalIndex();
+    begin = std::chrono::steady_clock::now();
+    size_t num_indexed_neighbours = 0;
+    for (auto& node : all_nodes) {
+        num_indexed_neighbours += node->getNeighbours().size();
+    }
+    end = std::chrono::steady_clock::now();
+    auto index_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << all_nodes.size() << " nodes:" << std::endl
+              << "Time to find all neighbours by walking down (us) = " << walk_time.count() << std::endl
+              << "Time to find all neighbours with locational index (us) = " << index_time.count() << std::endl;
+    EXPECT_EQ(num_neighbours, num_indexed_neighbours);
+}
+
 TEST_F(RealNodeTest, get_and_set_containedValue) {
     // We must give a RealNode a GraphNode when we create it
     GraphNode<int> graph_node;
@@ -119,5 +273,12 @@ TEST_F(RealNodeTest, get_and_set_containedValue) {
     EXPECT_EQ(39, real_node.containedValue());
 }
 
+TEST_F(RealNodeTest, getCenterCoordinates) {
+    GraphNode<nullptr_t> graph_node(2,2);
+    std::shared_ptr<Node<nullptr_t>> node = graph_node.getSubNodes()[1][0];
+
+    Coordinates expected = {0.5, 1.5};
+    EXPECT_EQ(expected, node->getCenterCoordinates());
 }
 
+}
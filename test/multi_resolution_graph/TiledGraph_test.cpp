@@ -0,0 +1,190 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/TiledGraph.h"
+#include "multi_resolution_graph/Rectangle.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class TiledGraphTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph of 2x2 tiles, placed at {10,20}. The bottom left tile is
+        // split into 2x2 nodes, and the tile to the right of it into 4x4 nodes
+        graph = std::make_shared<GraphNode<int>>(4, 8, Coordinates{10, 20});
+        graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2);
+        graph->changeResolutionOfNode(graph->getSubNodes()[0][1], 4);
+        int value = 0;
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = value++;
+        }
+
+        directory = testing::TempDir() + "TiledGraphTest";
+        TiledGraph<int>::writeTiles(*graph, directory);
+    }
+
+    virtual void TearDown() {
+        std::filesystem::remove_all(directory);
+    }
+
+    // Checks if a list of nodes contains a node at the given coordinates
+    static bool containsNodeAt(const std::vector<std::shared_ptr<RealNode<int>>> &nodes,
+                               Coordinates coordinates) {
+        return std::any_of(nodes.begin(), nodes.end(), [&](auto &node) {
+            return std::abs(node->getCoordinates().x - coordinates.x) < 1e-9 &&
+                   std::abs(node->getCoordinates().y - coordinates.y) < 1e-9;
+        });
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+    std::string directory;
+};
+
+TEST_F(TiledGraphTest, open_does_not_load_tiles){
+    TiledGraph<int> tiled_graph(directory, 1000000);
+
+    EXPECT_EQ(4, tiled_graph.getResolution());
+    EXPECT_EQ(8, tiled_graph.getScale());
+    EXPECT_EQ((Coordinates{10, 20}), tiled_graph.getCoordinates());
+    EXPECT_EQ(0, tiled_graph.getMemoryUsage());
+    EXPECT_FALSE(tiled_graph.isTileLoaded(0, 0));
+}
+
+TEST_F(TiledGraphTest, getClosestNodeToCoordinates){
+    TiledGraph<int> tiled_graph(directory, 1000000);
+
+    // The expected coordinates and scale of the node containing each point
+    std::vector<std::tuple<Coordinates, Coordinates, double>> expected_nodes = {
+            {{10.5, 20.5}, {10, 20}, 1},
+            {{11.5, 21.5}, {11, 21}, 1},
+            {{12.25, 20.75}, {12, 20.5}, 0.5},
+            {{13.9, 21.9}, {13.5, 21.5}, 0.5},
+            {{17, 27}, {16, 26}, 2}};
+    std::vector<std::shared_ptr<RealNode<int>>> original_nodes = graph->getAllSubNodes();
+    for (auto& [coordinates, expected_coordinates, expected_scale] : expected_nodes) {
+        std::shared_ptr<RealNode<int>> node =
+                tiled_graph.getClosestNodeToCoordinates(coordinates);
+        EXPECT_EQ(expected_coordinates, node->getCoordinates());
+        EXPECT_EQ(expected_scale, node->getScale());
+
+        auto original_node = std::find_if(original_nodes.begin(), original_nodes.end(),
+                                          [&](auto &n) {
+                                              return n->getCoordinates() == expected_coordinates;
+                                          });
+        ASSERT_NE(original_nodes.end(), original_node);
+        EXPECT_EQ((*original_node)->containedValue(), node->containedValue());
+    }
+
+    // Only the tiles we looked in should have been loaded
+    EXPECT_TRUE(tiled_graph.isTileLoaded(0, 0));
+    EXPECT_TRUE(tiled_graph.isTileLoaded(0, 1));
+    EXPECT_TRUE(tiled_graph.isTileLoaded(3, 3));
+    EXPECT_FALSE(tiled_graph.isTileLoaded(2, 2));
+}
+
+TEST_F(TiledGraphTest, getAllNodesInArea_across_tiles){
+    TiledGraph<int> tiled_graph(directory, 1000000);
+    Rectangle<int> rectangle(3, 1, {11.5, 20.5});
+
+    std::vector<std::shared_ptr<RealNode<int>>> expected_nodes =
+            graph->getAllNodesInArea(rectangle);
+    std::vector<std::shared_ptr<RealNode<int>>> nodes = tiled_graph.getAllNodesInArea(rectangle);
+    EXPECT_EQ(expected_nodes.size(), nodes.size());
+    for (auto& expected_node : expected_nodes) {
+        EXPECT_TRUE(containsNodeAt(nodes, expected_node->getCoordinates()));
+    }
+}
+
+TEST_F(TiledGraphTest, getNeighbours_across_tiles){
+    TiledGraph<int> tiled_graph(directory, 1000000);
+
+    // The node at {11,20} in the bottom left tile borders the 2 small nodes
+    // along the left edge of the next tile, the node above and to the left of it
+    // in its own tile, and nothing below (it is on the edge of the graph)
+    std::shared_ptr<RealNode<int>> node = tiled_graph.getClosestNodeToCoordinates({11.5, 20.5});
+    std::vector<std::shared_ptr<RealNode<int>>> neighbours = tiled_graph.getNeighbours(node);
+    EXPECT_EQ(4, neighbours.size());
+    EXPECT_TRUE(containsNodeAt(neighbours, {12, 20}));
+    EXPECT_TRUE(containsNodeAt(neighbours, {12, 20.5}));
+    EXPECT_TRUE(containsNodeAt(neighbours, {10, 20}));
+    EXPECT_TRUE(containsNodeAt(neighbours, {11, 21}));
+}
+
+TEST_F(TiledGraphTest, getNeighbours_with_tight_memory_budget){
+    // Only the most recently used tile is kept, so finding the neighbours
+    // drops and reloads the tile the node is in
+    TiledGraph<int> unlimited_graph(directory, 1000000);
+    std::vector<std::shared_ptr<RealNode<int>>> expected_neighbours =
+            unlimited_graph.getNeighbours(unlimited_graph.getClosestNodeToCoordinates({12.25, 20.25}));
+    TiledGraph<int> tiled_graph(directory, 1);
+    std::shared_ptr<RealNode<int>> node = tiled_graph.getClosestNodeToCoordinates({12.25, 20.25});
+    std::vector<std::shared_ptr<RealNode<int>>> neighbours = tiled_graph.getNeighbours(node);
+
+    EXPECT_EQ(3, expected_neighbours.size());
+    EXPECT_EQ(expected_neighbours.size(), neighbours.size());
+    EXPECT_FALSE(containsNodeAt(neighbours, {12, 20}));
+    for (auto& expected_neighbour : expected_neighbours) {
+        EXPECT_TRUE(containsNodeAt(neighbours, expected_neighbour->getCoordinates()));
+    }
+}
+
+TEST_F(TiledGraphTest, tiles_dropped_over_memory_budget){
+    // Find out how much memory a single unsplit tile uses
+    TiledGraph<int> unlimited_graph(directory, 1000000);
+    unlimited_graph.getTile(3, 3);
+    size_t tile_memory_usage = unlimited_graph.getMemoryUsage();
+
+    TiledGraph<int> tiled_graph(directory, 2 * tile_memory_usage);
+    std::shared_ptr<RealNode<int>> node = tiled_graph.getClosestNodeToCoordinates({17, 27});
+    tiled_graph.getTile(3, 2);
+    EXPECT_TRUE(tiled_graph.isTileLoaded(3, 3));
+    EXPECT_TRUE(tiled_graph.isTileLoaded(3, 2));
+
+    // Using the first tile again should make the second one the least recently used
+    tiled_graph.getTile(3, 3);
+    tiled_graph.getTile(2, 3);
+    EXPECT_TRUE(tiled_graph.isTileLoaded(3, 3));
+    EXPECT_FALSE(tiled_graph.isTileLoaded(3, 2));
+    EXPECT_TRUE(tiled_graph.isTileLoaded(2, 3));
+    EXPECT_EQ(2 * tile_memory_usage, tiled_graph.getMemoryUsage());
+
+    // Nodes we're holding on to should stay usable even once their tile is dropped
+    tiled_graph.getTile(2, 2);
+    tiled_graph.getTile(2, 1);
+    EXPECT_FALSE(tiled_graph.isTileLoaded(3, 3));
+    EXPECT_EQ((Coordinates{16, 26}), node->getCoordinates());
+    EXPECT_EQ(graph->getAllSubNodes().back()->containedValue(), node->containedValue());
+}
+
+TEST_F(TiledGraphTest, prefetchAround_keeps_closest_tiles){
+    TiledGraph<int> unlimited_graph(directory, 1000000);
+    unlimited_graph.getTile(3, 3);
+    size_t tile_memory_usage = unlimited_graph.getMemoryUsage();
+
+    // There are 4 tiles within range, but only room for 3
+    TiledGraph<int> tiled_graph(directory, 3 * tile_memory_usage);
+    tiled_graph.prefetchAround({15.5, 25.5}, 1);
+    EXPECT_TRUE(tiled_graph.isTileLoaded(2, 2));
+    EXPECT_TRUE(tiled_graph.isTileLoaded(2, 3));
+    EXPECT_TRUE(tiled_graph.isTileLoaded(3, 2));
+    EXPECT_FALSE(tiled_graph.isTileLoaded(3, 3));
+    EXPECT_FALSE(tiled_graph.isTileLoaded(1, 1));
+}
+
+TEST_F(TiledGraphTest, missing_directory_throws){
+    EXPECT_THROW(TiledGraph<int>(directory + "_missing", 1000000),
+                 TiledGraph<int>::TileFileException);
+}
+
+}
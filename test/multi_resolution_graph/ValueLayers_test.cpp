@@ -0,0 +1,155 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/ValueLayers.h"
+#include "multi_resolution_graph/Circle.h"
+#include "multi_resolution_graph/GraphFactory.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class ValueLayersTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph with the bottom left quadrant split, for 7 RealNodes
+        graph = std::make_shared<GraphNode<int>>(2, 4);
+        graph->changeResolutionOfNode(graph->getSubNodes()[0][0], 2);
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(ValueLayersTest, constructor_gives_leaf_ids){
+    EXPECT_EQ(RealNode<int>::NO_LEAF_ID, graph->getAllSubNodes()[0]->getLeafId());
+
+    ValueLayers<int> value_layers(*graph);
+    ASSERT_EQ(7, value_layers.getNumLeaves());
+    std::vector<std::shared_ptr<RealNode<int>>> leaves = graph->getAllSubNodes();
+    for (size_t i = 0; i < leaves.size(); i++) {
+        EXPECT_EQ(i, leaves[i]->getLeafId());
+        EXPECT_EQ(leaves[i], value_layers.getLeaves()[i]);
+    }
+}
+
+TEST_F(ValueLayersTest, layers_by_name){
+    ValueLayers<int> value_layers(*graph);
+    size_t static_cost = value_layers.addLayer("static_cost", 1.5);
+    size_t dynamic_cost = value_layers.addLayer("dynamic_cost");
+
+    EXPECT_NE(static_cost, dynamic_cost);
+    EXPECT_EQ(static_cost, value_layers.addLayer("static_cost", 100));
+    EXPECT_TRUE(value_layers.hasLayer("dynamic_cost"));
+    EXPECT_FALSE(value_layers.hasLayer("velocity"));
+    EXPECT_EQ(dynamic_cost, value_layers.getLayerIndex("dynamic_cost"));
+    EXPECT_THROW(value_layers.getLayerIndex("velocity"),
+                 ValueLayers<int>::LayerNotFoundException);
+
+    std::shared_ptr<RealNode<int>> node = graph->getAllSubNodes()[3];
+    EXPECT_EQ(1.5, value_layers.getValue(static_cost, *node));
+    EXPECT_EQ(0, value_layers.getValue("dynamic_cost", *node));
+    value_layers.getValue("dynamic_cost", *node) = 4;
+    EXPECT_EQ(4, value_layers.getLayer(dynamic_cost)[node->getLeafId()]);
+
+    // Layers are separate from the values contained by the nodes
+    node->containedValue() = 7;
+    EXPECT_EQ(4, value_layers.getValue(dynamic_cost, *node));
+}
+
+TEST_F(ValueLayersTest, bulk_operations){
+    ValueLayers<int> value_layers(*graph);
+    size_t a = value_layers.addLayer("a", 2);
+    size_t b = value_layers.addLayer("b");
+    std::vector<double> &b_values = value_layers.getLayer(b);
+    for (size_t i = 0; i < b_values.size(); i++) {
+        b_values[i] = i;
+    }
+
+    EXPECT_EQ(14, value_layers.sum(a));
+    EXPECT_EQ(21, value_layers.sum(b));
+    EXPECT_EQ(0, value_layers.min(b));
+    EXPECT_EQ(6, value_layers.max(b));
+
+    value_layers.scale(a, 3);
+    EXPECT_EQ(42, value_layers.sum(a));
+    value_layers.addScaled(a, b, 2);
+    EXPECT_EQ(6 + 2 * 5, value_layers.getLayer(a)[5]);
+    value_layers.copy(b, a);
+    EXPECT_EQ(value_layers.getLayer(a), value_layers.getLayer(b));
+    value_layers.transform(b, [](double value) { return -value; });
+    EXPECT_EQ(-16, value_layers.getLayer(b)[5]);
+    value_layers.fill(b, 1);
+    EXPECT_EQ(7, value_layers.sum(b));
+}
+
+TEST_F(ValueLayersTest, update_keeps_values_of_existing_nodes){
+    ValueLayers<int> value_layers(*graph);
+    size_t cost = value_layers.addLayer("cost", -1);
+    std::vector<std::shared_ptr<RealNode<int>>> leaves = graph->getAllSubNodes();
+    for (auto& leaf : leaves) {
+        value_layers.getValue(cost, *leaf) = leaf->getCoordinates().x + 10 * leaf->getCoordinates().y;
+    }
+
+    // Split a node near the start, so every node after it is renumbered
+    leaves[0]->convertToGraphNode(2);
+    value_layers.update();
+
+    ASSERT_EQ(graph->getAllSubNodes().size(), value_layers.getNumLeaves());
+    for (auto& leaf : graph->getAllSubNodes()) {
+        ASSERT_NE(RealNode<int>::NO_LEAF_ID, leaf->getLeafId());
+        EXPECT_EQ(leaf, value_layers.getLeaves()[leaf->getLeafId()]);
+        bool is_new = std::find(leaves.begin(), leaves.end(), leaf) == leaves.end();
+        double expected = is_new ? -1 : leaf->getCoordinates().x + 10 * leaf->getCoordinates().y;
+        EXPECT_EQ(expected, value_layers.getValue(cost, *leaf));
+    }
+}
+
+// Compares the time taken to add up a value for every node, when the values
+// are contained by the nodes, and when they are stored in a layer
+TEST_F(ValueLayersTest, benchmark_against_contained_values){
+    GraphFactory<double> graph_factory;
+    graph_factory.setGraphScale(8);
+    graph_factory.setGraphTopLevelResolution(2);
+    Circle<double> circle(1, {4.1, 3.9});
+    graph_factory.setMaxScaleInArea(circle, 0.005);
+    std::shared_ptr<GraphNode<double>> large_graph = graph_factory.createGraph();
+    std::vector<std::shared_ptr<RealNode<double>>> leaves = large_graph->getAllSubNodes();
+    ValueLayers<double> value_layers(*large_graph);
+    size_t cost = value_layers.addLayer("cost");
+    for (auto& leaf : leaves) {
+        leaf->containedValue() = 0.5;
+        value_layers.getValue(cost, *leaf) = 0.5;
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    double contained_sum = 0;
+    for (int i = 0; i < 10; i++) {
+        for (auto& leaf : leaves) {
+            contained_sum += leaf->containedValue();
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    auto contained_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    begin = std::chrono::steady_clock::now();
+    double layer_sum = 0;
+    for (int i = 0; i < 10; i++) {
+        layer_sum += value_layers.sum(cost);
+    }
+    end = std::chrono::steady_clock::now();
+    auto layer_time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+
+    std::cout << "Graph with " << leaves.size() << " nodes, summing all values 10 times:" << std::endl
+              << "Time with contained values (us) = " << contained_time.count() << std::endl
+              << "Time with a value layer (us) = " << layer_time.count() << std::endl;
+    EXPECT_EQ(contained_sum, layer_sum);
+}
+
+}
@@ -0,0 +1,170 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <memory>
+#include <string>
+#include <vector>
+
+// Project Includes
+#include "multi_resolution_graph/ValuePolicies.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+// A value that counts how many times it has been copied
+struct CountedValue {
+    CountedValue() = default;
+    explicit CountedValue(std::string data) : data(std::move(data)) {}
+    CountedValue(const CountedValue &other) : data(other.data) { copies++; }
+    CountedValue(CountedValue &&other) noexcept = default;
+    CountedValue &operator=(const CountedValue &other) {
+        data = other.data;
+        copies++;
+        return *this;
+    }
+    CountedValue &operator=(CountedValue &&other) noexcept = default;
+
+    std::string data;
+    static int copies;
+};
+
+int CountedValue::copies = 0;
+
+class ValuePoliciesTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // A 4x4 graph with a value of `2x + 3y` at the center of every node
+        graph = std::make_shared<GraphNode<double>>(4, 4);
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = linearField(node);
+        }
+        CountedValue::copies = 0;
+    }
+
+    static double linearField(const std::shared_ptr<RealNode<double>> &node) {
+        Coordinates coordinates = node->getCoordinates();
+        double half_scale = node->getScale() / 2;
+        return 2 * (coordinates.x + half_scale) + 3 * (coordinates.y + half_scale);
+    }
+
+    std::shared_ptr<GraphNode<double>> graph;
+};
+
+TEST_F(ValuePoliciesTest, no_split_policy_value_initializes){
+    std::shared_ptr<Node<double>> split_node = graph->changeResolutionOfNode(graph->getSubNodes()[1][1], 2);
+    for (auto& node : split_node->getAllSubNodes()) {
+        EXPECT_EQ(0, node->containedValue());
+    }
+}
+
+TEST_F(ValuePoliciesTest, replicate_copies_all_but_one){
+    auto counted_graph = std::make_shared<GraphNode<CountedValue>>(2, 2);
+    std::shared_ptr<RealNode<CountedValue>> node = counted_graph->getAllSubNodes()[0];
+    node->containedValue() = CountedValue("payload");
+    CountedValue::copies = 0;
+
+    node->convertToGraphNode(2, ValuePolicies<CountedValue>::replicate());
+
+    EXPECT_EQ(3, CountedValue::copies);
+    std::vector<std::shared_ptr<RealNode<CountedValue>>> nodes = counted_graph->getAllSubNodes();
+    ASSERT_EQ(7, nodes.size());
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ("payload", nodes[i]->containedValue().data);
+    }
+}
+
+TEST_F(ValuePoliciesTest, merge_policies_move_values){
+    auto counted_graph = std::make_shared<GraphNode<CountedValue>>(2, 2);
+    std::vector<std::shared_ptr<RealNode<CountedValue>>> nodes = counted_graph->getAllSubNodes();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i]->containedValue() = CountedValue(std::to_string(i));
+    }
+    auto split_node = std::static_pointer_cast<GraphNode<CountedValue>>(
+            counted_graph->changeResolutionOfNode(nodes[3], 2, ValuePolicies<CountedValue>::replicate()));
+    CountedValue::copies = 0;
+
+    std::shared_ptr<RealNode<CountedValue>> merged = split_node->convertToRealNode(
+            ValuePolicies<CountedValue>::fold([](CountedValue &&a, CountedValue &&b) {
+                a.data += b.data;
+                return std::move(a);
+            }));
+    EXPECT_EQ("3333", merged->containedValue().data);
+
+    split_node = std::static_pointer_cast<GraphNode<CountedValue>>(
+            counted_graph->changeResolutionOfNode(merged, 2));
+    split_node->getAllSubNodes()[0]->containedValue() = CountedValue("first");
+    merged = split_node->convertToRealNode(ValuePolicies<CountedValue>::first());
+    EXPECT_EQ("first", merged->containedValue().data);
+    EXPECT_EQ(0, CountedValue::copies);
+}
+
+TEST_F(ValuePoliciesTest, interpolate_keeps_linear_field){
+    std::shared_ptr<Node<double>> split_node = graph->changeResolutionOfNode(
+            graph->getSubNodes()[1][2], 2, ValuePolicies<double>::interpolate());
+
+    std::vector<std::shared_ptr<RealNode<double>>> new_nodes = split_node->getAllSubNodes();
+    ASSERT_EQ(4, new_nodes.size());
+    for (auto& node : new_nodes) {
+        EXPECT_DOUBLE_EQ(linearField(node), node->containedValue());
+    }
+
+    // Splitting a node next to smaller nodes, and on the edge of the graph
+    graph->changeResolutionOfNode(graph->getSubNodes()[1][3], 3, ValuePolicies<double>::interpolate());
+    for (auto& node : graph->getAllSubNodes()) {
+        EXPECT_DOUBLE_EQ(linearField(node), node->containedValue());
+    }
+
+    // Splitting a node next to a larger node, whose center is offset from the
+    // center of the split node along both axes
+    auto coarse_graph = std::make_shared<GraphNode<double>>(2, 4);
+    auto bottom_left = std::static_pointer_cast<GraphNode<double>>(
+            coarse_graph->changeResolutionOfNode(coarse_graph->getSubNodes()[0][0], 2));
+    for (auto& node : coarse_graph->getAllSubNodes()) {
+        node->containedValue() = linearField(node);
+    }
+    split_node = bottom_left->changeResolutionOfNode(bottom_left->getSubNodes()[0][1], 2,
+                                                     ValuePolicies<double>::interpolate());
+    ASSERT_EQ((Coordinates{1, 0}), split_node->getCoordinates());
+    for (auto& node : coarse_graph->getAllSubNodes()) {
+        EXPECT_NEAR(linearField(node), node->containedValue(), 1e-12);
+    }
+}
+
+TEST_F(ValuePoliciesTest, mean_reverses_interpolate){
+    std::shared_ptr<Node<double>> original_node = graph->getSubNodes()[2][1];
+    double original_value = std::static_pointer_cast<RealNode<double>>(original_node)->containedValue();
+    auto split_node = std::static_pointer_cast<GraphNode<double>>(
+            graph->changeResolutionOfNode(original_node, 2, ValuePolicies<double>::interpolate()));
+    split_node->changeResolutionOfNode(split_node->getSubNodes()[0][0], 2, ValuePolicies<double>::interpolate());
+
+    std::shared_ptr<RealNode<double>> merged = split_node->convertToRealNode(ValuePolicies<double>::mean());
+    EXPECT_DOUBLE_EQ(original_value, merged->containedValue());
+}
+
+TEST_F(ValuePoliciesTest, fromFunction){
+    graph->changeResolutionOfClosestNode({0.5, 0.5}, 2,
+            ValuePolicies<double>::fromFunction([](const double &value, unsigned int row, unsigned int col) {
+                return value + 10 * row + col;
+            }));
+
+    std::vector<std::shared_ptr<RealNode<double>>> nodes = graph->getAllSubNodes();
+    EXPECT_EQ(2.5, nodes[0]->containedValue());
+    EXPECT_EQ(3.5, nodes[1]->containedValue());
+    EXPECT_EQ(12.5, nodes[2]->containedValue());
+    EXPECT_EQ(13.5, nodes[3]->containedValue());
+}
+
+TEST_F(ValuePoliciesTest, failed_split_keeps_value){
+    auto quadtree = std::make_shared<GraphNode<double>>(2, 4);
+    quadtree->enableLocationalIndex();
+    std::shared_ptr<RealNode<double>> node = quadtree->getAllSubNodes()[1];
+    node->containedValue() = 5;
+
+    EXPECT_THROW(node->convertToGraphNode(3, ValuePolicies<double>::replicate()),
+                 GraphNode<double>::NotAQuadtreeException);
+    EXPECT_EQ(5, node->containedValue());
+}
+
+}
@@ -0,0 +1,89 @@
+// Testing Includes
+#include <gtest/gtest.h>
+
+// C++ STD Includes
+#include <memory>
+#include <thread>
+#include <atomic>
+
+// Project Includes
+#include "multi_resolution_graph/VersionedGraph.h"
+
+using namespace multi_resolution_graph;
+
+namespace {
+
+class VersionedGraphTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        graph = std::make_shared<GraphNode<int>>(4, 4);
+        for (auto& node : graph->getAllSubNodes()) {
+            node->containedValue() = 0;
+        }
+    }
+
+    std::shared_ptr<GraphNode<int>> graph;
+};
+
+TEST_F(VersionedGraphTest, snapshot_unchanged_by_writes){
+    VersionedGraph<int> versioned_graph(*graph);
+
+    std::shared_ptr<const PersistentGraph<int>> snapshot = versioned_graph.getSnapshot();
+    versioned_graph.setValueAtCoordinates({1.5, 1.5}, 7);
+    versioned_graph.changeResolutionOfNodeAtCoordinates({3.5, 3.5}, 2);
+
+    EXPECT_EQ(0, snapshot->getNodeAtCoordinates({1.5, 1.5}).containedValue());
+    EXPECT_EQ(16, snapshot->getAllSubNodes().size());
+
+    std::shared_ptr<const PersistentGraph<int>> new_snapshot = versioned_graph.getSnapshot();
+    EXPECT_EQ(7, new_snapshot->getNodeAtCoordinates({1.5, 1.5}).containedValue());
+    EXPECT_EQ(19, new_snapshot->getAllSubNodes().size());
+}
+
+// Stress test with one writer and many readers. This should be run with
+// ThreadSanitizer enabled (`cmake -DENABLE_TSAN=ON`) to check that it is race free
+TEST_F(VersionedGraphTest, concurrent_readers_and_writer){
+    VersionedGraph<int> versioned_graph(*graph);
+    const int num_writes = 200;
+    std::atomic<bool> done_writing(false);
+
+    // The writer sets every node in the top row to an increasing value, one
+    // at a time, so in any consistent snapshot the values must never increase
+    // from left to right
+    std::thread writer([&]() {
+        for (int i = 1; i <= num_writes; i++) {
+            for (double x = 0.5; x < 4; x++) {
+                versioned_graph.setValueAtCoordinates({x, 3.5}, i);
+            }
+        }
+        done_writing = true;
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<int> num_inconsistent_snapshots(0);
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&]() {
+            while (!done_writing) {
+                std::shared_ptr<const PersistentGraph<int>> snapshot = versioned_graph.getSnapshot();
+                int last_value = snapshot->getNodeAtCoordinates({0.5, 3.5}).containedValue();
+                for (double x = 1.5; x < 4; x++) {
+                    int value = snapshot->getNodeAtCoordinates({x, 3.5}).containedValue();
+                    if (value > last_value) {
+                        num_inconsistent_snapshots++;
+                    }
+                    last_value = value;
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, num_inconsistent_snapshots);
+    EXPECT_EQ(num_writes, versioned_graph.getSnapshot()->getNodeAtCoordinates({3.5, 3.5}).containedValue());
+}
+
+}